@@ -0,0 +1,76 @@
+/*********************************************************************************************************
+ * AdcSampler - continuous-mode (DMA) ADC sampling for the ESP32-S3
+ *
+ * Description:
+ *   Wraps the ESP-IDF continuous ADC driver. Once started, the ADC converts in the background at a fixed
+ *   sample rate and the DMA engine writes the results into a ring buffer owned by the driver, so the CPU
+ *   is free to do other work. Callers collect the results in whole blocks of 12-bit samples.
+ *
+ *   Up to ADC_MAX_CHANNELS channels can be scanned. The ADC sweeps the channels in order, one conversion
+ *   each, and readBlock() hands back complete sweeps ("frames") interleaved channel by channel:
+ *     samples[0] = ch0, samples[1] = ch1, ... samples[n-1] = ch(n-1), samples[n] = ch0 of the next frame ...
+ *
+ * Notes:
+ *   - The sample rate is conversions per second across all channels (per-channel rate = rate / channels).
+ *   - The ESP32-S3 supports sample rates from ~611 Hz up to ~83.3 kHz in continuous mode.
+ *   - If the ring buffer is not drained quickly enough the driver drops the oldest conversions. A frame
+ *     that lost a conversion repeats that channel's previous value.
+ *   - Only ADC1 channels can be scanned (ADC2 is not usable in continuous mode).
+ *   - analogRead() must not be used on the same ADC unit while the sampler is running.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/adc.h>
+
+// Default sample rate in Hz
+#define ADC_SAMPLE_RATE_HZ 20000
+
+// Number of samples handed over per block (one DMA interrupt worth of conversions)
+#define ADC_BLOCK_SAMPLES 128
+
+// Number of blocks the driver's ring buffer can hold
+#define ADC_RING_BLOCKS 16
+
+// Most channels in one scan, and the number of ADC1 channels on the S3
+#define ADC_MAX_CHANNELS 8
+#define ADC1_CHANNEL_COUNT 10
+
+class AdcSampler {
+public:
+  // Configure the ADC for the given ADC1 channel and start converting in the background
+  bool begin(adc1_channel_t channel, uint32_t sampleRateHz = ADC_SAMPLE_RATE_HZ);
+
+  // Same, but scanning 'count' channels in the order given
+  bool begin(const adc1_channel_t *channels, uint8_t count, uint32_t sampleRateHz = ADC_SAMPLE_RATE_HZ);
+
+  // Stop converting and release the driver
+  void end();
+
+  // Copy up to one block of samples into 'samples' as whole interleaved frames. Waits at most 'timeoutMs'
+  // for a block to be ready. Returns the number of samples written (a multiple of channelCount(), 0 on timeout).
+  size_t readBlock(uint16_t *samples, size_t maxSamples, uint32_t timeoutMs);
+
+  bool running() const { return isRunning; }
+  uint32_t sampleRate() const { return rateHz; }
+  uint8_t channelCount() const { return numChannels; }
+
+  // Number of times the ring buffer overflowed because it was not drained in time
+  uint32_t overrunCount() const { return overruns; }
+
+private:
+  adc1_channel_t channelList[ADC_MAX_CHANNELS] = {};
+  int8_t channelIndex[ADC1_CHANNEL_COUNT] = {}; // position of each ADC1 channel in the scan (-1 if not scanned)
+  uint8_t numChannels = 0;
+  uint32_t rateHz = 0;
+  bool isRunning = false;
+  uint32_t overruns = 0;
+
+  // The sweep being assembled (carried over between reads, as a block can end part way through a sweep)
+  uint16_t frame[ADC_MAX_CHANNELS] = {};
+  int8_t lastIndex = -1;
+
+  // Raw conversion results as delivered by the DMA (one 32-bit word per sample on the S3)
+  adc_digi_output_data_t raw[ADC_BLOCK_SAMPLES];
+};
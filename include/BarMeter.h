@@ -0,0 +1,60 @@
+/*********************************************************************************************************
+ * BarMeter - compact horizontal bar display for several sensor channels
+ *
+ * Description:
+ *   One row per channel: a label, a bar coloured with the same zones as the analog meter (setZones(), where
+ *   the zones overlap the one the meter draws last wins: green, then yellow, orange, red), and the value.
+ *   Up to ADC_MAX_CHANNELS rows fit in the space a single analog meter takes. Only the part of a bar that
+ *   changed length is redrawn (the whole bar if it moved into a different colour zone), and the value text
+ *   only when it changes.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "AdcSampler.h"
+
+class BarMeter {
+public:
+  explicit BarMeter(TFT_eSPI *tft);
+
+  // Same as NeedleMeter::setZones(): start and end of each zone, 0-100 along the bar (an empty zone is left out).
+  // Takes effect from the next begin().
+  void setZones(uint16_t rs, uint16_t re, uint16_t os, uint16_t oe, uint16_t ys, uint16_t ye, uint16_t gs, uint16_t ge);
+
+  // Lay out 'channels' rows in the given area, 'fullScale' is the value of a full-length bar
+  void begin(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t channels, const char *const *labels, int32_t fullScale);
+
+  // Bar length in pixels for a value
+  int16_t barLength(int32_t value) const;
+
+  // How far (in pixels) the bar of 'channel' would move for 'value'
+  int16_t pixelDelta(uint8_t channel, int32_t value) const;
+
+  // Show 'value' on 'channel', drawing only what changed
+  void update(uint8_t channel, int32_t value);
+
+private:
+  uint16_t zoneColor(int16_t length) const;
+
+  TFT_eSPI *display;
+  int32_t areaX = 0;
+  int32_t areaY = 0;
+  int32_t barX = 0;
+  int16_t barWidth = 0;
+  int16_t rowHeight = 0;
+  int16_t barHeight = 0;
+  int32_t valueX = 0;
+  int32_t scale = 4095;
+  uint8_t numChannels = 0;
+
+  // Zones in percent of the bar, in the order they are checked
+  struct Zone {
+    uint16_t start, end, color;
+  };
+  Zone zones[4] = {{40, 60, TFT_GREEN}, {0, 0, TFT_YELLOW}, {25, 75, TFT_ORANGE}, {0, 100, TFT_RED}};
+
+  int16_t shownLength[ADC_MAX_CHANNELS] = {};
+  uint16_t shownColor[ADC_MAX_CHANNELS] = {};
+  int32_t shownValue[ADC_MAX_CHANNELS] = {};
+};
@@ -0,0 +1,60 @@
+/*********************************************************************************************************
+ * BlockKernels - sum, sum of squares, min/max and table lookup over blocks of 16-bit samples
+ *
+ * Description:
+ *   Small building blocks for code that works on whole blocks of samples at a time (the statistics, the
+ *   benchmarks). On the ESP32-S3 the kernels use the PIE vector instructions, 8 samples per instruction:
+ *     - 128-bit aligned loads of 8 samples
+ *     - EE.VMIN.S16 / EE.VMAX.S16 for a running min and max in each lane
+ *     - EE.VMULAS.S16.ACCX, multiply-accumulate of all 8 lanes into the 40-bit ACCX accumulator, for the
+ *       sum of squares (samples x samples) and the sum (samples x a vector of ones)
+ *     - EE.ANDQ to mask 8 counts at once for the table lookup (scale-by-LUT, e.g. counts to calibrated
+ *       millivolts), whose 8 table loads are then interleaved two at a time: PIE has no gather load
+ *   blockStats() does the first three in a single pass, loading each vector once: the squares go into
+ *   ACCX, the sum into the eight 40-bit lanes of QACC (EE.VMULAS.S16.QACC) and the extremes into two
+ *   registers. Every kernel also has a plain scalar version (the ...Scalar() functions). That one is used
+ *   on other chips (the lookup unrolled four ways), and the vector results are checked against it by test/test_kernels (on the board with
+ *   pio test -e board-test) and by the benchmark environment (src/bench/BenchKernels.cpp).
+ *
+ * Notes:
+ *   - Blocks may start at any address: the samples before the first 16-byte boundary and after the last
+ *     whole vector are done one at a time (for the lookup, the boundary of the counts read).
+ *   - The sums are exact as long as they fit in 40 bits (e.g. up to 32768 squared 12-bit samples).
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+#define BLOCK_KERNELS_PIE 1 // vector versions available
+#else
+#define BLOCK_KERNELS_PIE 0
+#endif
+
+struct BlockStats {
+  int32_t sum;
+  int64_t sumSquares;
+  int16_t min; // INT16_MAX and INT16_MIN for an empty block
+  int16_t max;
+};
+
+// Sum of the samples
+int32_t blockSum(const int16_t *samples, size_t count);
+int32_t blockSumScalar(const int16_t *samples, size_t count);
+
+// Sum of the squares of the samples
+int64_t blockSumSquares(const int16_t *samples, size_t count);
+int64_t blockSumSquaresScalar(const int16_t *samples, size_t count);
+
+// Lowest and highest sample
+void blockMinMax(const int16_t *samples, size_t count, int16_t &low, int16_t &high);
+void blockMinMaxScalar(const int16_t *samples, size_t count, int16_t &low, int16_t &high);
+
+// Sum, sum of squares and min/max in one pass over the block
+void blockStats(const int16_t *samples, size_t count, BlockStats &stats);
+void blockStatsScalar(const int16_t *samples, size_t count, BlockStats &stats);
+
+// out[i] = table[in[i] & mask], e.g. raw counts to calibrated millivolts (mask = table size - 1)
+void blockLookup(const uint16_t *in, int16_t *out, size_t count, const int16_t *table, uint16_t mask);
+void blockLookupScalar(const uint16_t *in, int16_t *out, size_t count, const int16_t *table, uint16_t mask);
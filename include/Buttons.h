@@ -0,0 +1,92 @@
+/*********************************************************************************************************
+ * Buttons - push buttons debounced in a hardware timer interrupt, delivered as click/hold events
+ *
+ * Description:
+ *   A hardware timer interrupts every BUTTON_SAMPLE_MS and reads each button. A button only counts as
+ *   pressed or released once it has read the same for BUTTON_DEBOUNCE_SAMPLES samples in a row, so contact
+ *   bounce never gets through, and nothing has to poll the pins between frames. From the debounced state
+ *   the interrupt works out what the user did and queues it as an event:
+ *     - BUTTON_CLICK    pressed and released within BUTTON_HOLD_MS
+ *     - BUTTON_HOLD     held down for BUTTON_HOLD_MS
+ *     - BUTTON_REPEAT   every BUTTON_REPEAT_MS while it is still held after that
+ *     - BUTTON_RELEASE  let go after a hold
+ *   The events wait in a lock-free queue for one consumer task, and each one also gives a semaphore, so
+ *   that task can sleep until its next frame with wait() and still answer a press straight away.
+ *
+ * Notes:
+ *   - The buttons are active low (the T-Display-S3's BOOT and KEY buttons, with pull-ups).
+ *   - The semaphore is separate from the consumer's task notifications, which stay free for other uses.
+ *   - The interrupt and what it calls (the queue, the semaphore) are in flash, not IRAM, so the timer
+ *     interrupt is held off while the flash is written or erased (the log, the settings, the face cache)
+ *     and a press during that time is only seen once it is over; the debounce just starts later.
+ *   - pause() stops the timer (e.g. in low-power mode, where a press wakes the chip instead); after
+ *     resume() a button already held down is ignored until it has been released.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/semphr.h>
+#include "SpscQueue.h"
+
+#define BUTTON_MAX 2              // buttons handled
+#define BUTTON_SAMPLE_MS 5        // timer period
+#define BUTTON_DEBOUNCE_SAMPLES 4 // equal samples in a row before a change counts (20ms)
+#define BUTTON_HOLD_MS 600        // pressed for this long is a hold rather than a click
+#define BUTTON_REPEAT_MS 150      // between repeats while held
+
+enum ButtonAction : uint8_t {
+  BUTTON_CLICK,
+  BUTTON_HOLD,
+  BUTTON_REPEAT,
+  BUTTON_RELEASE,
+};
+
+struct ButtonEvent {
+  uint8_t button; // index in the pins given to begin()
+  ButtonAction action;
+  uint16_t repeats; // BUTTON_REPEAT events so far in this hold (1 for the first)
+};
+
+class Buttons {
+public:
+  // Set up 'count' buttons (active low) and start sampling them on hardware timer 'timerNumber'
+  bool begin(const uint8_t *pins, uint8_t count, uint8_t timerNumber);
+
+  // Consumer side: the next event, false if there is none
+  bool next(ButtonEvent &event) { return events.pop(event); }
+
+  // Consumer side: wait up to 'ticks' for an event, true if one arrived
+  bool wait(TickType_t ticks) { return xSemaphoreTake(ready, ticks) == pdTRUE; }
+
+  // Debounced state of a button
+  bool down(uint8_t button) const { return state[button].down; }
+
+  void pause();
+  void resume();
+
+  // Events dropped because the consumer didn't take them in time
+  uint32_t eventsDropped() const { return dropped; }
+
+private:
+  struct ButtonState {
+    uint8_t pin;
+    uint8_t history;   // the last samples, newest in bit 0 (1 = pressed)
+    bool down;
+    bool ignore;       // held when sampling resumed, wait for the release
+    uint16_t heldSamples;
+    uint16_t repeats;
+  };
+
+  static void onTimer();
+  void sample(BaseType_t &woken);
+  void emit(uint8_t button, ButtonAction action, uint16_t repeats, BaseType_t &woken);
+
+  static Buttons *instance;
+  hw_timer_t *timer = nullptr;
+  SemaphoreHandle_t ready = nullptr;
+  SpscQueue<ButtonEvent, 16> events;
+  ButtonState state[BUTTON_MAX] = {};
+  uint8_t numButtons = 0;
+  volatile uint32_t dropped = 0;
+};
@@ -0,0 +1,94 @@
+/*********************************************************************************************************
+ * Calibration - ADC counts to calibrated millivolts and magnetic field, by table lookup
+ *
+ * Description:
+ *   The ESP32-S3 ADC is not linear, particularly near the ends of its range, and every chip is a little
+ *   different. Each chip has calibration data burned into its eFuses at the factory, which the ESP-IDF
+ *   esp_adc_cal component turns into a counts -> millivolts curve. Evaluating that curve is too slow to do
+ *   for every reading, so at boot it is evaluated once for all 4096 possible counts:
+ *     - AdcCalibration:   counts -> calibrated millivolts (shared by every channel)
+ *     - FieldCalibration: counts -> field strength in tenths of a gauss for one KY035, combining the
+ *                         calibrated millivolts with that module's zero-field output and sensitivity
+ *   After that a conversion is a single indexed load. Oversampled readings, which have extra bits below
+ *   the 12-bit count, are interpolated linearly between neighbouring entries.
+ *
+ * Notes:
+ *   - The KY035 output sits at about half the supply with no field and moves 1.4 to 2.0 mV per gauss
+ *     (positive for one pole, negative for the other). setZeroField() changes the zero-field output, e.g.
+ *     to one measured with no magnet nearby.
+ *   - A FieldCalibration has two tables: a new one is built in the spare (a few milliseconds) and then
+ *     swapped in with an atomic pointer store, so a lookup on another task always sees one whole table.
+ *     A lookup must not hold on to the table, and changes must be far enough apart (as they are, made by
+ *     hand) that nobody is still reading the spare when it is rebuilt.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <esp_adc_cal.h>
+
+#define CAL_TABLE_SIZE 4096 // one entry per 12-bit ADC value
+
+// KY035 defaults, used until a zero-field output is captured
+#define KY035_ZERO_FIELD_MV 1650.0f // with no field the output sits at about half the 3.3V supply
+#define KY035_MV_PER_GAUSS 1.8f     // sensitivity (1.4 to 2.0 mV/G according to the datasheet)
+
+// Look up a reading with 'extraBits' fraction bits in a table indexed by 12-bit counts, interpolating
+// linearly between the two nearest entries
+template <typename T>
+inline int32_t interpolateTable(const T *table, uint32_t counts, uint8_t extraBits) {
+  uint32_t index = counts >> extraBits;
+  if (index >= CAL_TABLE_SIZE - 1) {
+    return table[CAL_TABLE_SIZE - 1];
+  }
+  int32_t fraction = counts & ((1u << extraBits) - 1);
+  return table[index] + (((table[index + 1] - table[index]) * fraction) >> extraBits);
+}
+
+class AdcCalibration {
+public:
+  // Read the eFuse calibration for ADC1 at 11dB attenuation and build the counts -> millivolts table
+  void begin();
+
+  // Calibrated millivolts for a raw 12-bit reading
+  uint16_t millivolts(uint16_t counts) const { return table[counts & (CAL_TABLE_SIZE - 1)]; }
+
+  // Calibrated millivolts for an oversampled reading with 'extraBits' bits below the 12-bit count
+  uint16_t millivolts(uint32_t counts, uint8_t extraBits) const { return interpolateTable(table, counts, extraBits); }
+
+  // Where the calibration came from (eFuse two point / eFuse Vref / default Vref)
+  const char *source() const;
+
+private:
+  uint16_t table[CAL_TABLE_SIZE] = {};
+  esp_adc_cal_value_t calSource = ESP_ADC_CAL_VAL_DEFAULT_VREF;
+};
+
+class FieldCalibration {
+public:
+  // Build the counts -> field table for a sensor with the given zero-field output and sensitivity
+  void begin(const AdcCalibration &adc, float zeroFieldMv = KY035_ZERO_FIELD_MV, float mvPerGauss = KY035_MV_PER_GAUSS);
+
+  // Use a new zero-field output (e.g. measured with no magnet nearby) and swap in a table built for it
+  void setZeroField(float zeroFieldMv);
+
+  // Field strength in tenths of a gauss for a raw 12-bit reading (signed, 0 = no field)
+  int16_t deciGauss(uint16_t counts) const { return table()[counts & (CAL_TABLE_SIZE - 1)]; }
+
+  // Field strength in tenths of a gauss for an oversampled reading with 'extraBits' bits below the 12-bit count
+  int16_t deciGauss(uint32_t counts, uint8_t extraBits) const { return interpolateTable(table(), counts, extraBits); }
+
+  float zeroFieldMv() const { return zeroMv; }
+  float mvPerGauss() const { return sensitivity; }
+
+private:
+  const int16_t *table() const { return active.load(std::memory_order_acquire); }
+  void build();
+
+  const AdcCalibration *adcCal = nullptr;
+  float zeroMv = KY035_ZERO_FIELD_MV;
+  float sensitivity = KY035_MV_PER_GAUSS;
+  int16_t tables[2][CAL_TABLE_SIZE] = {};
+  std::atomic<int16_t *> active{tables[0]};
+};
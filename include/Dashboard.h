@@ -0,0 +1,82 @@
+/*********************************************************************************************************
+ * Dashboard - web page with a live WebSocket stream of the readings
+ *
+ * Description:
+ *   Serves a small dashboard page (web/dashboard.html, gzipped into flash by tools/embed_page.py, so a
+ *   request is answered straight out of flash with no work on the device) and a WebSocket at /ws that
+ *   pushes the readings to every open page.
+ *
+ *   The acquisition task hands every DASHBOARD_DECIMATION-th reading to the dashboard through a lock-free
+ *   queue. A push task of its own wakes once per DASHBOARD_FRAME_MS and coalesces all the readings queued
+ *   since the last frame into one binary message (count, channels, then per reading the time, the field
+ *   in tenths of a gauss and the raw value of each channel). The message is put in one buffer shared by
+ *   all the clients and handed to the library's binaryAll(). A client whose send queue is still full
+ *   from earlier frames (a slow link) simply misses this frame; the page draws whatever it receives
+ *   against the time stamps, so the other clients, the push task and the sampler never wait for it.
+ *   When a page connects it is first sent a short JSON text message with the device id, the full scale
+ *   and the channel labels.
+ *
+ * Notes:
+ *   - add() belongs to one producer task; the web server runs in the AsyncTCP task.
+ *   - The push task never walks the client list itself: connecting, counting and closing the oldest
+ *     clients happen in the socket's events (AsyncTCP task), sending in makeBuffer()/binaryAll().
+ *   - framesSent() counts messages handed to the library, framesSkipped() the ones not sent at all (no
+ *     memory for the buffer) and framesMissed() the sent ones that at least one slow client missed.
+ *   - Wi-Fi is started by the caller (it is shared with the telemetry).
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "SpscQueue.h"
+
+#define DASHBOARD_QUEUE 64       // readings buffered between two frames (power of two)
+#define DASHBOARD_FRAME_MS 50    // one message per client every 50ms (20 frames per second)
+#define DASHBOARD_MAX_CHANNELS 8 // raw channel values per reading
+#define DASHBOARD_MAX_CLIENTS 4  // pages open at once (the oldest is closed beyond this)
+
+class AsyncWebServer;
+class AsyncWebSocket;
+
+class Dashboard {
+public:
+  // Start the web server on 'port' and the task that pushes the frames. 'labels' names each channel,
+  // 'fullScaleGauss' is the range the page charts (+/-).
+  bool begin(uint16_t port, uint8_t channels, const char *const *labels, uint16_t fullScaleGauss,
+             uint8_t decimation, BaseType_t core, UBaseType_t priority);
+
+  // Producer side: offer one reading (only every decimation-th is kept)
+  void add(uint32_t nowMs, int16_t fieldDeciGauss, const uint16_t *channelValues);
+
+  bool enabled() const { return taskHandle != nullptr; }
+  uint32_t clients() const { return connectedClients; }
+  uint32_t framesSent() const { return sent; }
+  uint32_t framesSkipped() const { return skipped; }
+  uint32_t framesMissed() const { return missed; }
+  uint32_t readingsDropped() const { return dropped; }
+
+private:
+  struct Sample {
+    uint32_t ms;
+    int16_t field;
+    uint16_t channels[DASHBOARD_MAX_CHANNELS];
+  };
+
+  static void pushTask(void *parameter);
+  size_t encode(uint8_t *out);
+
+  AsyncWebServer *server = nullptr;
+  AsyncWebSocket *socket = nullptr;
+  TaskHandle_t taskHandle = nullptr;
+  SpscQueue<Sample, DASHBOARD_QUEUE> samples;
+  uint8_t numChannels = 1;
+  uint8_t keepEvery = 1;
+  uint8_t offered = 0;
+  char hello[160]; // JSON sent to each page when it connects
+
+  volatile uint32_t connectedClients = 0;
+  volatile uint32_t sent = 0;
+  volatile uint32_t skipped = 0;
+  volatile uint32_t missed = 0;
+  volatile uint32_t dropped = 0;
+};
@@ -0,0 +1,114 @@
+// Generated by tools/embed_page.py from dashboard.html (3806 bytes, 1685 gzipped), do not edit
+
+#pragma once
+
+#include <Arduino.h>
+
+const uint8_t DASHBOARD_PAGE[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x85, 0x57, 0x7b, 0x6f, 0xdb, 0x36,
+    0x10, 0xff, 0xdf, 0x9f, 0xe2, 0xaa, 0x60, 0x98, 0xbc, 0xd8, 0x92, 0xec, 0xa4, 0x45, 0xe0, 0x17,
+    0xd0, 0xf5, 0x95, 0x6e, 0xeb, 0x5a, 0x34, 0xd9, 0x8a, 0x22, 0x08, 0x0a, 0x5a, 0xa2, 0x2c, 0xad,
+    0x92, 0xa8, 0x89, 0x94, 0x1d, 0xb7, 0xf5, 0x77, 0xdf, 0x1d, 0x49, 0xc9, 0xb2, 0xb3, 0xb4, 0x09,
+    0x62, 0x59, 0xbc, 0xdf, 0x1d, 0xef, 0x7d, 0x97, 0xd9, 0xa3, 0xe7, 0x6f, 0x9f, 0x5d, 0x7f, 0x7c,
+    0xf7, 0x02, 0x12, 0x95, 0x67, 0x8b, 0xde, 0xec, 0xd1, 0x70, 0xd8, 0x03, 0xf8, 0xfd, 0x63, 0x70,
+    0xf6, 0x18, 0x22, 0x26, 0x93, 0xa5, 0x60, 0x55, 0x34, 0x00, 0xc9, 0xab, 0x35, 0x8f, 0x60, 0xf5,
+    0x25, 0x2d, 0x4b, 0x7c, 0xc6, 0x95, 0xc8, 0x21, 0xce, 0x90, 0x0e, 0xcb, 0x2d, 0xa8, 0x84, 0xc3,
+    0xf3, 0x06, 0x0b, 0x21, 0x1e, 0x4b, 0x70, 0xd3, 0x22, 0xcc, 0xea, 0x88, 0xfb, 0x2d, 0xc1, 0x4b,
+    0xfa, 0x1e, 0x8a, 0x7e, 0x1a, 0x2b, 0x5e, 0x01, 0x8f, 0x52, 0x95, 0x16, 0x2b, 0xa8, 0xea, 0x62,
+    0x02, 0xe5, 0x56, 0x25, 0xa2, 0x38, 0x03, 0x25, 0x44, 0x26, 0x7d, 0x9e, 0x2f, 0x79, 0xf4, 0xa9,
+    0x64, 0x2b, 0xee, 0x95, 0x5b, 0xd8, 0xf0, 0xa5, 0x1f, 0xed, 0x45, 0xa0, 0x92, 0x70, 0x4f, 0xf2,
+    0x3b, 0xc2, 0x26, 0xbd, 0xe1, 0x10, 0xf5, 0xb7, 0x66, 0x24, 0x9c, 0x45, 0xf8, 0xc8, 0xb9, 0x62,
+    0x10, 0x26, 0xac, 0x92, 0x5c, 0xcd, 0x9d, 0x5a, 0xc5, 0xc3, 0x0b, 0xa7, 0x39, 0x2e, 0x58, 0xce,
+    0xe7, 0xce, 0x3a, 0xe5, 0x9b, 0x52, 0x54, 0xca, 0x81, 0x50, 0x14, 0x8a, 0x17, 0x08, 0xdb, 0xa4,
+    0x91, 0x4a, 0xe6, 0x11, 0x5f, 0xa7, 0x21, 0x1f, 0xea, 0x97, 0x01, 0xde, 0x89, 0xfa, 0xb2, 0x6c,
+    0x28, 0x43, 0x96, 0xf1, 0xf9, 0x88, 0x84, 0xa8, 0x54, 0x65, 0x7c, 0x61, 0x3c, 0x75, 0xc9, 0xb2,
+    0x0c, 0xae, 0x78, 0x21, 0x45, 0x35, 0xf3, 0x0d, 0xa1, 0x37, 0x93, 0x6a, 0x4b, 0x4f, 0x80, 0xa5,
+    0x88, 0xb6, 0xf0, 0x15, 0x72, 0x56, 0xad, 0x52, 0x34, 0x37, 0x98, 0x42, 0xc9, 0xa2, 0x08, 0xcd,
+    0x9f, 0xc0, 0x68, 0x5c, 0xde, 0x4d, 0x61, 0xc9, 0xc2, 0xcf, 0xab, 0x4a, 0xd4, 0x45, 0x34, 0x81,
+    0x93, 0x20, 0x40, 0x40, 0x28, 0x32, 0x51, 0xe1, 0x4b, 0x1c, 0xc7, 0x53, 0x88, 0x51, 0xb3, 0x61,
+    0xcc, 0xf2, 0x34, 0xdb, 0x4e, 0x40, 0xb2, 0x42, 0x0e, 0x31, 0x1c, 0x29, 0x12, 0x76, 0x28, 0x3c,
+    0x19, 0x75, 0x45, 0xe3, 0xef, 0x05, 0x49, 0xd4, 0x2c, 0x32, 0xfd, 0xc2, 0xf1, 0x8a, 0xfd, 0xc1,
+    0x86, 0xa7, 0xab, 0x44, 0x4d, 0xa0, 0x10, 0x55, 0xce, 0x32, 0xc3, 0x7f, 0x12, 0xa7, 0x3c, 0x8b,
+    0x50, 0x46, 0x87, 0xe5, 0x7c, 0xcf, 0xb2, 0x66, 0x55, 0xca, 0xf0, 0x59, 0xd4, 0x39, 0xde, 0x19,
+    0x4e, 0x40, 0xb1, 0x65, 0x9d, 0xb1, 0x8a, 0x0e, 0xe4, 0x81, 0x04, 0x99, 0x93, 0x13, 0x0e, 0xe4,
+    0x8c, 0x03, 0x92, 0xd3, 0xd8, 0x72, 0x71, 0x71, 0x61, 0x19, 0xa4, 0x62, 0xaa, 0x96, 0x03, 0x38,
+    0xc1, 0xd0, 0x14, 0x05, 0xcf, 0x24, 0xb2, 0x1d, 0xa0, 0xba, 0xea, 0x9f, 0x91, 0x8c, 0xc6, 0xc0,
+    0xf3, 0xf2, 0x8e, 0xfc, 0x47, 0x52, 0x42, 0x56, 0xac, 0x19, 0x71, 0xea, 0x10, 0x21, 0x30, 0x08,
+    0x7e, 0x9a, 0x42, 0x62, 0x4d, 0x1c, 0x9f, 0x07, 0xf7, 0x3c, 0x3b, 0x1a, 0x8d, 0xa6, 0x10, 0xa5,
+    0xb2, 0xcc, 0x18, 0x3a, 0x72, 0x99, 0x89, 0xf0, 0x73, 0x23, 0x79, 0xa8, 0x44, 0x39, 0x31, 0xae,
+    0xdb, 0xf5, 0x66, 0xbe, 0x0d, 0xdd, 0xcc, 0xb7, 0x79, 0x44, 0x11, 0xa4, 0xac, 0x1a, 0x41, 0x1a,
+    0xcd, 0x1d, 0x1d, 0x60, 0xe7, 0xff, 0x42, 0x9f, 0x8c, 0x10, 0x15, 0xa5, 0x6b, 0x0d, 0xd3, 0x6e,
+    0x71, 0x16, 0xc3, 0xe1, 0x10, 0x66, 0xda, 0x39, 0x8b, 0x57, 0x28, 0x59, 0x7f, 0x99, 0xf9, 0x08,
+    0xea, 0x40, 0x1b, 0x3f, 0x38, 0x2d, 0xc5, 0x5a, 0x67, 0x89, 0x98, 0x9f, 0x48, 0x31, 0x67, 0x1d,
+    0x36, 0xe3, 0x47, 0x67, 0x81, 0xa9, 0x5b, 0xf0, 0x90, 0x0a, 0xca, 0xf3, 0xbc, 0x46, 0x82, 0x0c,
+    0xab, 0xb4, 0x54, 0x8b, 0x9e, 0xef, 0xc3, 0x0b, 0x16, 0x62, 0xa1, 0xa6, 0x05, 0xab, 0xb6, 0x90,
+    0x73, 0x29, 0xb1, 0x5e, 0x20, 0x11, 0x59, 0x24, 0x81, 0xaf, 0x39, 0x9e, 0x45, 0x3c, 0x4c, 0x73,
+    0xa6, 0xb0, 0xb0, 0x2b, 0xb4, 0x97, 0xea, 0x52, 0x62, 0x91, 0x71, 0x5d, 0xd8, 0x58, 0xcd, 0x0a,
+    0x44, 0xc1, 0x27, 0x24, 0x08, 0xa0, 0x4e, 0x0b, 0x75, 0x81, 0xc1, 0xaa, 0x0b, 0x35, 0x68, 0x5e,
+    0xac, 0xf2, 0x03, 0xc2, 0x17, 0x86, 0x06, 0x77, 0xe0, 0x12, 0xf5, 0x6c, 0x0c, 0xb9, 0xa4, 0xf2,
+    0x51, 0xa3, 0x27, 0x60, 0xf2, 0x24, 0x2d, 0x20, 0xf0, 0x46, 0xaf, 0x06, 0x2d, 0x1f, 0x62, 0x6b,
+    0x03, 0xa8, 0xd8, 0xc6, 0xb0, 0xcb, 0x7e, 0x0f, 0x6d, 0xc2, 0x8b, 0x2f, 0x5f, 0x5f, 0x5d, 0xbf,
+    0x7d, 0xff, 0xf1, 0xd3, 0x9b, 0x2b, 0x98, 0x53, 0x84, 0xb1, 0x36, 0x2c, 0x45, 0x7b, 0x05, 0x0f,
+    0x23, 0x11, 0x62, 0x6a, 0x16, 0xca, 0x5b, 0x71, 0xf5, 0x22, 0xe3, 0xf4, 0xf5, 0xd7, 0xed, 0xeb,
+    0xc8, 0xb5, 0x6e, 0xeb, 0xb7, 0x78, 0x2a, 0xef, 0x3b, 0xe2, 0xd0, 0x04, 0x82, 0x3f, 0x33, 0x47,
+    0xae, 0x33, 0x8e, 0x08, 0x97, 0x71, 0x85, 0xca, 0xc5, 0x02, 0x21, 0x98, 0xc5, 0x75, 0x96, 0x5d,
+    0x51, 0xb1, 0x4f, 0xe0, 0x71, 0x10, 0x0c, 0xd0, 0x0d, 0x4b, 0x54, 0x75, 0x02, 0x37, 0xb7, 0xb0,
+    0x33, 0xd0, 0x52, 0xa0, 0xd2, 0x12, 0xc1, 0x37, 0xb7, 0x53, 0x40, 0xdf, 0xdc, 0x90, 0xa1, 0x2b,
+    0x56, 0x4b, 0x79, 0xab, 0xe9, 0xd6, 0xd1, 0x84, 0x40, 0xa5, 0x7b, 0x71, 0x5d, 0x60, 0x84, 0x04,
+    0xf9, 0x47, 0x07, 0xcb, 0xed, 0xc3, 0x57, 0xca, 0x62, 0xad, 0xdc, 0x86, 0x50, 0x05, 0xdf, 0xc0,
+    0x07, 0xbe, 0xbc, 0xc2, 0xb4, 0xe4, 0xa8, 0xd4, 0x46, 0x4e, 0x7c, 0xdf, 0x81, 0x53, 0xc0, 0x3c,
+    0x65, 0xc4, 0xe9, 0x25, 0x02, 0xa1, 0xa7, 0xe0, 0xf8, 0x1b, 0x49, 0xfa, 0x02, 0xb2, 0x79, 0x26,
+    0xaa, 0xd7, 0xdb, 0x92, 0xa3, 0x04, 0x87, 0x55, 0x15, 0xdb, 0x2e, 0xeb, 0x38, 0xe6, 0x95, 0x63,
+    0x01, 0xa2, 0x10, 0x25, 0x46, 0x65, 0x0e, 0x78, 0xe1, 0x7c, 0x01, 0x26, 0x65, 0x5c, 0x27, 0x4b,
+    0xd7, 0xbc, 0x15, 0x22, 0xb0, 0xa3, 0x0a, 0xc9, 0x5b, 0xd0, 0xd7, 0x16, 0x86, 0xd5, 0x62, 0xf5,
+    0xe5, 0x38, 0x05, 0x2a, 0xae, 0xaa, 0xad, 0xc9, 0x32, 0xe4, 0xc5, 0xa1, 0xa0, 0xae, 0xd3, 0x9c,
+    0x8b, 0x5a, 0xb9, 0x16, 0x34, 0xc0, 0x92, 0x0f, 0x02, 0x24, 0xed, 0x5a, 0xc9, 0x4d, 0xbe, 0xa1,
+    0x6c, 0x4c, 0xb6, 0x42, 0x99, 0x0b, 0x90, 0x0a, 0x90, 0xc6, 0xe0, 0x2a, 0xd4, 0x5c, 0xc4, 0xa0,
+    0x49, 0x5e, 0xc4, 0xb0, 0x2f, 0xcf, 0xe7, 0x68, 0x88, 0x54, 0x15, 0xde, 0xe3, 0xf4, 0x2d, 0x12,
+    0x9a, 0xc0, 0xfc, 0x76, 0xf5, 0xf6, 0x4f, 0xaf, 0xa4, 0x7e, 0xee, 0xee, 0x59, 0xb4, 0x19, 0xf4,
+    0xf3, 0x60, 0x2e, 0x98, 0x8a, 0xed, 0x7b, 0x14, 0xee, 0x67, 0xa6, 0xcf, 0x93, 0xbb, 0xee, 0x55,
+    0x30, 0x90, 0xbf, 0xe9, 0x2a, 0xcf, 0xb4, 0xff, 0x46, 0x30, 0x1a, 0x5e, 0x57, 0x85, 0x79, 0xdb,
+    0xe9, 0x4f, 0x13, 0x37, 0x9a, 0x1e, 0x36, 0x72, 0xcf, 0x51, 0x91, 0xbf, 0xf1, 0xf5, 0xbe, 0x5e,
+    0x4d, 0xfe, 0xd5, 0xfa, 0x52, 0x62, 0x21, 0xfd, 0xfe, 0xa2, 0xda, 0x71, 0x83, 0x43, 0x4c, 0x53,
+    0x11, 0xc7, 0xb0, 0x91, 0x85, 0x51, 0x5e, 0x89, 0x38, 0x46, 0xc7, 0x23, 0x64, 0xbc, 0x3f, 0x5b,
+    0xb3, 0xac, 0xe6, 0x36, 0x17, 0xf5, 0x61, 0x8c, 0xb6, 0xb8, 0x3a, 0xa1, 0x75, 0xfa, 0xe1, 0x63,
+    0x66, 0x34, 0xc0, 0xaf, 0xa7, 0xa7, 0x7b, 0xb7, 0x9a, 0x7b, 0xf3, 0xe3, 0x1b, 0xcf, 0xc6, 0xae,
+    0xb9, 0x06, 0x6b, 0xba, 0xaa, 0x79, 0xeb, 0x60, 0x03, 0xd7, 0x49, 0xde, 0xe1, 0x78, 0x4d, 0xc5,
+    0x6b, 0x19, 0xd0, 0x7f, 0xe7, 0x96, 0x09, 0x7c, 0xac, 0xd8, 0x86, 0xf3, 0x9e, 0x86, 0x1d, 0x1d,
+    0x43, 0xa3, 0x63, 0x48, 0x3a, 0x5a, 0x0f, 0xe0, 0x5b, 0x57, 0xcd, 0x86, 0xdf, 0x2b, 0x6b, 0x99,
+    0xb8, 0x5d, 0x4d, 0xbb, 0x17, 0x3f, 0xc1, 0xbf, 0x31, 0xfc, 0x02, 0xa1, 0x55, 0xa0, 0x55, 0x7b,
+    0x67, 0x9f, 0x0d, 0x72, 0xbe, 0x87, 0x36, 0xf7, 0x59, 0x84, 0x29, 0x6a, 0x73, 0x4d, 0xa7, 0xa0,
+    0xfb, 0xdd, 0xd0, 0x53, 0xda, 0x9a, 0x68, 0x2e, 0x20, 0xd8, 0xeb, 0x28, 0x13, 0xb1, 0x71, 0x0d,
+    0xff, 0x8d, 0x15, 0x93, 0xf1, 0x62, 0xa5, 0x12, 0x18, 0xc2, 0xe8, 0xf6, 0x66, 0x74, 0x3b, 0xb0,
+    0x46, 0x1c, 0x08, 0x6b, 0xba, 0xc4, 0xe9, 0x29, 0x9d, 0x62, 0xd9, 0xec, 0x3a, 0xad, 0xc2, 0x56,
+    0x21, 0x65, 0xad, 0xb9, 0xe7, 0xc1, 0x04, 0xb7, 0x93, 0xe0, 0x38, 0xc3, 0xe9, 0xed, 0x48, 0x24,
+    0x69, 0xa9, 0x8d, 0x6a, 0xd5, 0xf9, 0xbe, 0x64, 0x33, 0xc5, 0xfa, 0x5e, 0x8a, 0x7e, 0xaa, 0x2e,
+    0xaf, 0xdf, 0xfc, 0x81, 0x62, 0x35, 0xbf, 0xa7, 0xc4, 0xcb, 0xf4, 0x8e, 0x47, 0x98, 0x9c, 0xd4,
+    0x94, 0xee, 0xcd, 0x38, 0xdd, 0x80, 0xc8, 0x57, 0x36, 0x74, 0xd6, 0x19, 0x0b, 0x18, 0x35, 0x3e,
+    0xfb, 0x5e, 0xeb, 0x36, 0xe3, 0xf0, 0xc8, 0x9e, 0x83, 0x5c, 0xf2, 0x72, 0x56, 0xba, 0xee, 0x1a,
+    0xe7, 0x88, 0x6e, 0x29, 0xae, 0x2e, 0x5b, 0xd3, 0xa6, 0x6f, 0xc2, 0x5b, 0xf8, 0xf6, 0x8d, 0x08,
+    0xa4, 0x18, 0xd5, 0xf4, 0xba, 0xef, 0xfd, 0x83, 0x31, 0x71, 0x1d, 0x64, 0x37, 0x6d, 0x6f, 0x47,
+    0x6e, 0xc1, 0xb6, 0xfd, 0x9e, 0x47, 0x34, 0x76, 0x98, 0xd2, 0xd3, 0x6e, 0x59, 0x89, 0x0d, 0x2e,
+    0x57, 0x3f, 0x4b, 0x5c, 0x71, 0x71, 0x3f, 0xc4, 0x89, 0xa4, 0xf8, 0x00, 0x36, 0x09, 0x3e, 0x70,
+    0x52, 0xea, 0x57, 0x8d, 0x6b, 0x9b, 0x7b, 0x28, 0x10, 0x85, 0x23, 0x8d, 0xa9, 0xbd, 0x8f, 0x49,
+    0xe0, 0x61, 0x7b, 0xa7, 0x0d, 0xa5, 0x9d, 0x3c, 0x87, 0x6f, 0x61, 0x96, 0xa2, 0x6d, 0x1f, 0xe8,
+    0x6c, 0xda, 0x32, 0x98, 0x2d, 0xa6, 0xc5, 0x1c, 0xbd, 0x1a, 0x96, 0x4b, 0x7d, 0xd8, 0x38, 0xf9,
+    0x30, 0xe3, 0x3a, 0x89, 0x69, 0x04, 0x62, 0x87, 0xe2, 0x92, 0x24, 0x3c, 0x9c, 0xa0, 0x81, 0x2d,
+    0xcc, 0x76, 0xae, 0x59, 0x4c, 0x9c, 0x66, 0xb8, 0xb1, 0xbb, 0x6e, 0xa9, 0xdd, 0x6c, 0x05, 0x0d,
+    0xa1, 0x44, 0x06, 0x98, 0xcd, 0x3b, 0x13, 0x1a, 0xdd, 0xda, 0xdc, 0x48, 0x51, 0xf3, 0xb0, 0x87,
+    0x8b, 0xcf, 0xfc, 0x8a, 0x56, 0x29, 0x6a, 0xb6, 0x27, 0xe7, 0xe7, 0xe7, 0xce, 0xf4, 0x00, 0xb1,
+    0xe4, 0xb8, 0x7a, 0xbd, 0x63, 0x2a, 0x71, 0xfb, 0x87, 0x84, 0x5c, 0xac, 0xf9, 0xb5, 0x70, 0x71,
+    0xee, 0x5a, 0xd3, 0x7d, 0x18, 0x1f, 0x41, 0xb2, 0xb4, 0x20, 0x88, 0xdd, 0xcf, 0x1f, 0x84, 0x19,
+    0x25, 0xdc, 0x1f, 0xe9, 0x16, 0xc7, 0xc1, 0x8f, 0x74, 0x6b, 0xdc, 0x21, 0x2a, 0x5a, 0xa7, 0xd0,
+    0x1f, 0xb8, 0xd6, 0x74, 0x86, 0x59, 0xe3, 0xe9, 0x3b, 0x94, 0x67, 0x22, 0x3c, 0x04, 0xf7, 0xc0,
+    0x5b, 0x7d, 0xec, 0x37, 0x86, 0xe2, 0x77, 0xbc, 0x76, 0xd8, 0x5a, 0xb7, 0xc8, 0xbd, 0xb7, 0x45,
+    0x33, 0x8e, 0x6e, 0x91, 0xcf, 0xed, 0x18, 0x88, 0x1f, 0x3a, 0xd7, 0xdb, 0x15, 0xa5, 0x11, 0x41,
+    0x79, 0x90, 0xea, 0xf9, 0x89, 0xd1, 0x3f, 0x72, 0xe5, 0xdd, 0x00, 0xb6, 0x38, 0x97, 0xb1, 0x38,
+    0xf8, 0xb1, 0x0b, 0x0d, 0xc9, 0xf4, 0xa4, 0x07, 0xbd, 0x67, 0xfa, 0x55, 0xc5, 0xff, 0xc5, 0xca,
+    0x53, 0x4f, 0x0b, 0x5a, 0x17, 0x31, 0xd5, 0x5f, 0x52, 0x91, 0xb8, 0x94, 0xef, 0x7d, 0xdd, 0x66,
+    0xa4, 0x1e, 0x06, 0xf8, 0xbf, 0x22, 0xcb, 0xdc, 0x66, 0x95, 0x20, 0xad, 0x9a, 0x72, 0xe9, 0x1f,
+    0xec, 0x1f, 0x03, 0x5d, 0x9a, 0x6d, 0x29, 0x51, 0xad, 0xe6, 0x72, 0xe5, 0xd3, 0x72, 0x73, 0xb8,
+    0x3d, 0xc1, 0x6e, 0xa0, 0x97, 0x3f, 0xb3, 0xcc, 0x99, 0xed, 0x69, 0xda, 0x33, 0x65, 0x36, 0xa5,
+    0x75, 0xdd, 0xae, 0xba, 0x33, 0xdf, 0x2e, 0xea, 0xbe, 0xf9, 0x37, 0xf0, 0x3f, 0xa3, 0x97, 0x31,
+    0xc9, 0xde, 0x0e, 0x00, 0x00,
+};
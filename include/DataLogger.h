@@ -0,0 +1,163 @@
+/*********************************************************************************************************
+ * DataLogger - readings and events kept in a log-structured ring in flash (or on an SD card)
+ *
+ * Description:
+ *   For unattended runs the acquisition task logs a reading every so often, plus events (boot, trigger
+ *   captures, low-power mode, settings changes), as small binary records. The records are packed in place
+ *   into 512-byte pages claimed from a small pool, so adding one is a memcpy into RAM: while one page is
+ *   being filled the previous ones wait for a separate low priority task, which writes each one whole, at
+ *   a page-aligned offset, the next along a ring. If the writer has fallen behind and the pool is full the
+ *   records are dropped (and counted) rather than waited for, so logging never holds up sampling.
+ *
+ *   The ring is a region of the SPIFFS partition after the face cache, or a file of fixed size on an SD
+ *   card if one answers at boot. Nothing is ever rewritten in place: the newest page always goes after
+ *   the last one, and when the end of the region is reached the log wraps round over the oldest pages, so
+ *   every flash sector is erased equally often (once per lap) and the number of times it has been erased
+ *   is kept in its pages.
+ *
+ * Layout:
+ *   region  [block 0: pages 0-7] [block 1: pages 8-15] ...   a block is one 4kB flash erase sector
+ *   page    uint32 magic 'KLG1'
+ *           uint32 sequence   pages written since the log was new, the page sits at sequence % pages
+ *           uint32 wear       times the page's block has been erased (written, on an SD card)
+ *           uint32 crc        CRC-32 of the rest of the page (the 12 bytes above, then the records)
+ *           records, then 0xFF to the end of the page
+ *   record  uint8 type, uint8 size (bytes, including these 6), uint32 timeMs, then by type:
+ *           LOG_READING  int16 field (tenths of a gauss), uint16 raw value of each channel
+ *           LOG_EVENT    uint16 event (LogEventCode), int32 value
+ *   All little-endian. See tools/log_export.py for a decoder.
+ *
+ * Power loss:
+ *   The CRC covers a whole page, so a page cut short by a power loss (or a sector erased and not yet
+ *   written) simply fails the check. At boot the writer finds the newest page from the first page of each
+ *   block and then the pages of the newest block, and carries on after it. At most the page being filled
+ *   is lost, which is written at least every flushMs.
+ *
+ * Export:
+ *   requestExport() has the writer task send every page in use, oldest first, over the port as it is
+ *   stored (4kB at a time, nothing is decoded on the device), framed by a text line before and after:
+ *     "Log export: <pages> pages of 512 bytes\n" <pages x 512 bytes> "Log export done\n"
+ *   Pages that fail the check (erased ones, or one cut short) are sent too and skipped by the host.
+ *
+ * Notes:
+ *   - logReading() and logEvent() belong to one producer task (and setup() before that task starts).
+ *   - Erasing a flash sector stalls both cores for ~45ms, once per 8 pages. The ADC keeps converting
+ *     into its DMA ring (~100ms at the default rate), so no samples are lost; the SD card has no stall.
+ *   - The SD card is on the SPI bus (the panel has its own parallel bus), formatted FAT.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <esp_partition.h>
+#include "SpscQueue.h"
+
+#define LOG_PAGE_BYTES 512       // one write, one SD sector
+#define LOG_BLOCK_BYTES 4096     // one flash erase sector
+#define LOG_POOL_PAGES 4         // the page being filled and up to 2 waiting to be written (power of two)
+#define LOG_MAX_CHANNELS 8       // raw values in a reading record
+#define LOG_FILE "/ky035.log"    // the ring on an SD card
+
+enum LogMedium : uint8_t {
+  LOG_NONE,
+  LOG_FLASH,
+  LOG_SD,
+};
+
+enum LogRecordType : uint8_t {
+  LOG_READING = 1,
+  LOG_EVENT = 2,
+};
+
+enum LogEventCode : uint16_t {
+  LOG_EVENT_BOOT = 1,      // value: reset reason (esp_reset_reason_t)
+  LOG_EVENT_TRIGGER = 2,   // value: capture number
+  LOG_EVENT_LOW_POWER = 3, // value: 1 entering low-power mode, 0 back to full rate
+  LOG_EVENT_SETTINGS = 4,  // value: settings generation
+};
+
+struct LogConfig {
+  bool useSd;          // try the SD card first, then fall back to flash
+  int8_t sdSck;
+  int8_t sdMiso;
+  int8_t sdMosi;
+  int8_t sdCs;
+  uint32_t sdBytes;    // size of the ring on the card (a multiple of LOG_BLOCK_BYTES)
+  uint32_t flashStart; // start of the ring in the SPIFFS partition (a multiple of LOG_BLOCK_BYTES)
+  uint32_t flushMs;    // a page that has been open this long goes out with the next record, full or not
+};
+
+class DataLogger {
+public:
+  // Open the SD card or the flash region and start the writer task (which finds the end of the log first)
+  bool begin(const LogConfig &config, BaseType_t core, UBaseType_t priority);
+
+  // Producer side: add a reading of the field and 'count' raw channel values taken at 'nowMs'
+  void logReading(uint32_t nowMs, int16_t field, const uint16_t *channels, uint8_t count);
+
+  // Producer side: add an event
+  void logEvent(uint32_t nowMs, LogEventCode event, int32_t value);
+
+  // Any task: have the writer task send the whole log over 'port' (see Export above)
+  void requestExport(Print &port);
+
+  bool enabled() const { return taskHandle != nullptr; }
+  bool exporting() const { return exportPort != nullptr; }
+  LogMedium medium() const { return storage; }
+  const char *mediumName() const { return storage == LOG_SD ? "SD card" : "flash"; }
+  uint32_t capacityPages() const { return pageCount; }
+  uint32_t pagesUsed() const { return nextSequence < pageCount ? nextSequence : pageCount; }
+  uint32_t pagesWritten() const { return written; }
+  uint32_t recordsDropped() const { return dropped; }
+  uint32_t writeErrors() const { return errors; }
+  uint32_t maxWear() const { return highestWear; }
+
+private:
+  struct PageHeader {
+    uint32_t magic;
+    uint32_t sequence;
+    uint32_t wear;
+    uint32_t crc;
+  };
+
+  struct LogPage {
+    uint8_t bytes[LOG_PAGE_BYTES];
+  };
+
+  static void writerTask(void *parameter);
+  void addRecord(uint32_t nowMs, LogRecordType type, const void *payload, uint8_t length);
+  void closePage();
+  void recover();
+  bool pageValid(uint32_t index, PageHeader &header);
+  void writePage(LogPage &page);
+  void exportPages(Print &port);
+  bool readRegion(uint32_t offset, void *data, size_t length);
+  bool writeRegion(uint32_t offset, const void *data, size_t length);
+  bool eraseBlock(uint32_t offset);
+  static uint32_t pageCrc(const uint8_t *page);
+
+  LogConfig settings = {};
+  LogMedium storage = LOG_NONE;
+  const esp_partition_t *partition = nullptr;
+  File file;
+  uint32_t pageCount = 0;
+  TaskHandle_t taskHandle = nullptr;
+
+  // Producer side: the page being filled (nullptr if the pool was full)
+  SpscQueue<LogPage, LOG_POOL_PAGES> pool;
+  LogPage *filling = nullptr;
+  uint16_t used = 0;
+  uint32_t pageOpenedMs = 0;
+
+  // Writer side (written pages, wear of the block being written, and a page or block read back from storage)
+  uint32_t blockWear = 0;
+  uint8_t transfer[LOG_BLOCK_BYTES];
+
+  volatile uint32_t nextSequence = 0;
+  volatile uint32_t highestWear = 0;
+  volatile uint32_t written = 0;
+  volatile uint32_t dropped = 0;
+  volatile uint32_t errors = 0;
+  Print *volatile exportPort = nullptr;
+};
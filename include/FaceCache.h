@@ -0,0 +1,70 @@
+/*********************************************************************************************************
+ * FaceCache - the prerendered meter face kept in flash as a run-length encoded image
+ *
+ * Description:
+ *   Drawing the meter face (zones, ticks, scale labels) is the slowest part of boot. The face only
+ *   depends on the scale and units, so once it has been drawn it is saved to a data partition in flash
+ *   and later boots copy it straight into the frame buffer instead of drawing it again. A face is mostly
+ *   long runs of one colour, so it is stored as (run length, colour) pairs: a few kB instead of 60kB.
+ *
+ *   Each image is stored with a key (a hash of everything the face was drawn from, see hash()), and an
+ *   image with a different key is ignored, so changing the scale or units simply draws (and saves) the
+ *   face again on the next boot.
+ *
+ * Layout in the partition:
+ *   [header: magic, key, width, height, runs] [runs x (uint16_t length, uint16_t colour)]
+ *   The header is written last, so an image that was interrupted while being saved is never loaded.
+ *
+ * Notes:
+ *   - Uses the first FACE_CACHE_SIZE bytes of the SPIFFS partition from the default partition table
+ *     (this project keeps no files there, the rest holds the data log, see DataLogger.h). No file system
+ *     or formatting is needed.
+ *   - load() reads through the flash cache (memory mapped), so it is about as fast as copying from RAM.
+ *   - store() erases and writes flash. It counts the runs first and erases only the 4kB sectors the
+ *     image takes (one or two for a typical face). Both cores stall while each sector is erased, typically
+ *     about 45ms per sector and up to a few hundred ms on a slow chip, far longer than the ADC's DMA ring
+ *     lasts. So it is only done at boot, before sampling starts, when holds() finds the face missing (the
+ *     first boot, or after the scale or zones changed); a face changed at run time is drawn in RAM only.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+#define FACE_CACHE_SIZE (64 * 1024) // bytes of the partition used for the image (a multiple of the 4kB sector)
+
+class FaceCache {
+public:
+  // Find the partition, returns false if there is none (load() and store() then always fail)
+  bool begin();
+
+  // Decode the image saved with 'key' into 'pixels' (width x height, in the frame buffer's byte order).
+  // Returns false, leaving 'pixels' alone, if there is no such image.
+  bool load(uint32_t key, uint16_t *pixels, uint16_t width, uint16_t height);
+
+  // Whether an image of this size is saved under 'key' (reads only the header)
+  bool holds(uint32_t key, uint16_t width, uint16_t height);
+
+  // Save an image under 'key', replacing whatever was there. Returns false if it doesn't fit.
+  bool store(uint32_t key, const uint16_t *pixels, uint16_t width, uint16_t height);
+
+  // Key for a face drawn from 'description' (FNV-1a hash)
+  static uint32_t hash(const char *description);
+
+private:
+  struct Header {
+    uint32_t magic;
+    uint32_t key;
+    uint16_t width;
+    uint16_t height;
+    uint32_t runs;
+  };
+
+  struct Run {
+    uint16_t length;
+    uint16_t colour;
+  };
+
+  const esp_partition_t *partition = nullptr;
+};
@@ -0,0 +1,286 @@
+/*********************************************************************************************************
+ * Filters - per-sample smoothing stages for the ADC readings
+ *
+ * Description:
+ *   Each stage takes one raw ADC sample at a time and updates its state in constant time, so the filtered
+ *   value is always available without re-summing a batch of readings:
+ *     - BoxcarFilter: moving average over the last N samples (running sum over a circular buffer). N is the
+ *                     capacity, the length in use can be anything up to it.
+ *     - IirFilter:    exponential moving average, y += (x - y) / 2^shift, kept in fixed point.
+ *     - MedianFilter: median of the last N samples, rejects single-sample spikes (N is small, e.g. 3-7).
+ *     - Decimator:    oversample and decimate, sums 4^n samples into one result with n extra bits.
+ *     - Deadband:     forces readings at or below a threshold to 0 (stops the needle bouncing at rest).
+ *   FilterPipeline chains an optional spike rejector, an optional decimator, one smoothing algorithm and the
+ *   deadband.
+ *
+ * Notes:
+ *   - Oversampling only adds resolution if the input carries at least about 1 LSB of noise, which the
+ *     ESP32-S3 ADC always does. Everything after the decimator runs at the decimated rate (1 / 4^n of the
+ *     sample rate) and works in the wider units, so lengths, shifts and thresholds must be set to match.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Moving average over the last N samples (or fewer, see setLength())
+template <size_t N>
+class BoxcarFilter {
+  static_assert(N > 0, "BoxcarFilter needs at least one sample");
+
+public:
+  // Average over the last 'samples' samples (1 to N), starts again empty if it changes
+  void setLength(size_t samples) {
+    samples = samples < 1 ? 1 : (samples > N ? N : samples);
+    if (samples != size) {
+      size = samples;
+      reset();
+    }
+  }
+  size_t length() const { return size; }
+
+  int32_t update(int32_t sample) {
+    sum += sample - window[index]; // add the newest sample and drop the oldest
+    window[index] = sample;
+    if (++index == size) {
+      index = 0;
+    }
+    if (filled < size) {
+      filled++;
+    }
+    return value();
+  }
+
+  int32_t value() const { return filled ? sum / (int32_t)filled : 0; }
+
+  void reset() {
+    for (size_t i = 0; i < N; i++) {
+      window[i] = 0;
+    }
+    sum = 0;
+    index = 0;
+    filled = 0;
+  }
+
+private:
+  int32_t window[N] = {};
+  int32_t sum = 0;
+  size_t size = N;
+  size_t index = 0;
+  size_t filled = 0; // until the window is full, average over what we have
+};
+
+// Exponential moving average, the weight of the newest sample is 1 / 2^shift
+class IirFilter {
+public:
+  explicit IirFilter(uint8_t shift = 6) : alphaShift(shift) {}
+
+  int32_t update(int32_t sample) {
+    if (!primed) {
+      state = sample << FRACTION_BITS; // start from the first sample instead of ramping up from 0
+      primed = true;
+    }
+    state += ((sample << FRACTION_BITS) - state) >> alphaShift;
+    return value();
+  }
+
+  int32_t value() const { return (state + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS; } // rounded
+
+  void setShift(uint8_t shift) { alphaShift = shift; }
+
+  void reset() {
+    state = 0;
+    primed = false;
+  }
+
+private:
+  static const int FRACTION_BITS = 12; // extra precision so small steps aren't lost to truncation
+
+  int32_t state = 0;
+  uint8_t alphaShift;
+  bool primed = false;
+};
+
+// Median of the last N samples (N odd)
+template <size_t N>
+class MedianFilter {
+  static_assert(N % 2 == 1, "MedianFilter needs an odd window");
+
+public:
+  int32_t update(int32_t sample) {
+    // Remove the oldest sample from the sorted copy (once the window is full)
+    if (filled == N) {
+      int32_t oldest = window[index];
+      size_t pos = 0;
+      while (sorted[pos] != oldest) {
+        pos++;
+      }
+      for (; pos + 1 < filled; pos++) {
+        sorted[pos] = sorted[pos + 1];
+      }
+      filled--;
+    }
+
+    // Insert the new sample into the sorted copy
+    size_t pos = filled;
+    while (pos > 0 && sorted[pos - 1] > sample) {
+      sorted[pos] = sorted[pos - 1];
+      pos--;
+    }
+    sorted[pos] = sample;
+    filled++;
+
+    window[index] = sample;
+    index = (index + 1) % N;
+    return value();
+  }
+
+  int32_t value() const { return filled ? sorted[filled / 2] : 0; }
+
+  void reset() {
+    index = 0;
+    filled = 0;
+  }
+
+private:
+  int32_t window[N] = {}; // samples in arrival order
+  int32_t sorted[N] = {}; // the same samples kept in ascending order
+  size_t index = 0;
+  size_t filled = 0;
+};
+
+// Oversample and decimate: the sum of 4^bits samples scaled down by 2^bits, a result with 'bits' more bits
+// of resolution than the input (plain averaging of the same samples would throw the extra bits away)
+class Decimator {
+public:
+  explicit Decimator(uint8_t bits = 0) : extraBits(bits) {}
+
+  // Add one sample, returns true when it completed a new result
+  bool update(int32_t sample) {
+    sum += sample;
+    if (++count < (1u << (2 * extraBits))) {
+      return false;
+    }
+    output = sum >> extraBits;
+    sum = 0;
+    count = 0;
+    return true;
+  }
+
+  // Most recent result, in units of 1/2^bits of an input step
+  int32_t value() const { return output; }
+
+  void setBits(uint8_t bits) {
+    extraBits = bits;
+    reset();
+  }
+  uint8_t bits() const { return extraBits; }
+
+  void reset() {
+    sum = 0;
+    count = 0;
+    output = 0;
+  }
+
+private:
+  uint8_t extraBits;
+  uint32_t count = 0;
+  int32_t sum = 0;
+  int32_t output = 0;
+};
+
+// Readings at or below the threshold are treated as 0
+class Deadband {
+public:
+  explicit Deadband(int32_t threshold = 0) : limit(threshold) {}
+
+  int32_t apply(int32_t value) const { return value <= limit ? 0 : value; }
+
+  void setThreshold(int32_t threshold) { limit = threshold; }
+  int32_t threshold() const { return limit; }
+
+private:
+  int32_t limit;
+};
+
+// Smoothing algorithms available in the pipeline
+enum FilterType : uint8_t {
+  FILTER_NONE,
+  FILTER_BOXCAR,
+  FILTER_IIR,
+};
+
+// Spike rejector -> decimator -> smoothing filter -> deadband
+template <size_t BoxcarLength, size_t MedianLength = 5>
+class FilterPipeline {
+public:
+  void setType(FilterType filterType) {
+    if (filterType != type) {
+      type = filterType;
+      reset();
+    }
+  }
+
+  void setSpikeRejection(bool enabled) { rejectSpikes = enabled; }
+  void setBoxcarLength(size_t length) { boxcar.setLength(length); }
+  void setIirShift(uint8_t shift) { iir.setShift(shift); }
+  void setDeadband(int32_t threshold) { deadband.setThreshold(threshold); }
+
+  // Oversample by 4^bits and keep 'bits' extra bits of resolution (0 = every sample goes straight through)
+  void setOversampling(uint8_t bits) {
+    if (bits != decimator.bits()) {
+      decimator.setBits(bits);
+      reset();
+    }
+  }
+
+  // Feed one raw sample through every stage, returns the filtered value
+  int32_t update(int32_t sample) {
+    if (rejectSpikes) {
+      sample = median.update(sample);
+    }
+
+    if (decimator.bits() > 0) {
+      if (!decimator.update(sample)) {
+        return output; // the rest of the pipeline only sees whole decimated results
+      }
+      sample = decimator.value();
+    }
+
+    switch (type) {
+      case FILTER_BOXCAR:
+        sample = boxcar.update(sample);
+        break;
+      case FILTER_IIR:
+        sample = iir.update(sample);
+        break;
+      default:
+        break;
+    }
+
+    output = deadband.apply(sample);
+    return output;
+  }
+
+  // Most recent filtered value (with the oversampling bits below the raw ADC resolution)
+  int32_t value() const { return output; }
+
+  void reset() {
+    median.reset();
+    decimator.reset();
+    boxcar.reset();
+    iir.reset();
+    output = 0;
+  }
+
+private:
+  FilterType type = FILTER_BOXCAR;
+  bool rejectSpikes = false;
+  MedianFilter<MedianLength> median;
+  Decimator decimator;
+  BoxcarFilter<BoxcarLength> boxcar;
+  IirFilter iir;
+  Deadband deadband;
+  int32_t output = 0;
+};
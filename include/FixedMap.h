@@ -0,0 +1,42 @@
+/*********************************************************************************************************
+ * FixedMap - compile-time integer version of mapValue()
+ *
+ * Description:
+ *   mapValue() is the original floating point mapping, kept as the reference version.
+ *   FixedMapper<InMin, InMax, OutMin, OutMax> maps an integer from one range to another like mapValue(),
+ *   but the scale factor (OutMax - OutMin) / (InMax - InMin) is worked out by the compiler as a fixed
+ *   point constant. Each conversion is then a subtract, a multiply, a shift and an add, with no float
+ *   maths or division.
+ *
+ * Example:
+ *   typedef FixedMapper<0, 4095, 0, 3300> AdcToMillivolts;
+ *   int32_t mv = AdcToMillivolts::map(2048); // 1650
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+// Float for the mapped value (the reference version of FixedMapper)
+inline float mapValue(float ip, float ipmin, float ipmax, float tomin, float tomax) {
+  return tomin + (((tomax - tomin) * (ip - ipmin)) / (ipmax - ipmin));
+}
+
+template <int32_t InMin, int32_t InMax, int32_t OutMin, int32_t OutMax, unsigned Shift = 16>
+struct FixedMapper {
+  static_assert(InMax > InMin, "FixedMapper input range must be increasing");
+  static_assert(Shift > 0 && Shift < 31, "FixedMapper shift out of range");
+
+  // Scale factor in fixed point (rounded to nearest), e.g. 3300 / 4095 * 2^16 = 52813
+  static constexpr int64_t SCALE =
+      (((int64_t)(OutMax - OutMin) << Shift) + (InMax - InMin) / 2) / (InMax - InMin);
+
+  // The whole input range must fit the 32-bit multiply used on the hot path
+  static_assert((int64_t)(InMax - InMin) * (SCALE < 0 ? -SCALE : SCALE) < ((int64_t)1 << 31) - ((int64_t)1 << Shift),
+                "FixedMapper range too large for a 32-bit multiply, use a smaller Shift");
+
+  // Map 'ip' from InMin..InMax to OutMin..OutMax (not clamped, like mapValue())
+  static constexpr int32_t map(int32_t ip) {
+    return OutMin + (((ip - InMin) * (int32_t)SCALE + (1 << (Shift - 1))) >> Shift);
+  }
+};
@@ -0,0 +1,74 @@
+/*********************************************************************************************************
+ * FrameScheduler - decides when the display should redraw
+ *
+ * Description:
+ *   The display runs on its own frame period, separate from the ADC sample rate and from how often the
+ *   filter publishes readings. In adaptive mode the period changes with the needle movement:
+ *     - needle steady:      the frame is skipped and the period backs off towards maxPeriodMs
+ *     - needle moving:      the period halves on every frame that moves the needle
+ *     - needle moving fast: the period drops straight to minPeriodMs
+ *   With adaptive mode off the period stays fixed and a frame is only skipped when nothing changed.
+ *   A view with a rate of its own (the trend, the spectrum) sets it with setViewPeriod(), which takes
+ *   over from the needle's period until it is cleared again.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+class FrameScheduler {
+public:
+  void begin(uint32_t minPeriodMs, uint32_t maxPeriodMs, bool adaptiveMode, int fastSteps = 3) {
+    minPeriod = minPeriodMs;
+    maxPeriod = maxPeriodMs;
+    adaptive = adaptiveMode;
+    fastDelta = fastSteps;
+    period = adaptive ? maxPeriod : minPeriod;
+  }
+
+  // Called once per frame with how far the needle would move (in needle steps) and whether the readout text
+  // changed. Returns true if the frame should be drawn, and updates periodMs() for the next frame.
+  bool shouldDraw(int needleDelta, bool readoutChanged) {
+    if (needleDelta < 0) {
+      needleDelta = -needleDelta;
+    }
+
+    if (adaptive) {
+      if (needleDelta >= fastDelta) {
+        period = minPeriod; // big jump, react as quickly as possible
+      } else if (needleDelta > 0) {
+        period = period / 2 > minPeriod ? period / 2 : minPeriod;
+      } else {
+        period += period / 4 + 1; // steady, ease off
+        if (period > maxPeriod) period = maxPeriod;
+      }
+    }
+
+    if (needleDelta == 0 && !readoutChanged) {
+      skipped++;
+      return false;
+    }
+
+    drawn++;
+    return true;
+  }
+
+  // Fixed frame period for the view on screen, 0 to go back to the period above
+  void setViewPeriod(uint32_t ms) { viewPeriod = ms; }
+
+  // Time until the next frame
+  uint32_t periodMs() const { return viewPeriod > 0 ? viewPeriod : period; }
+
+  uint32_t framesDrawn() const { return drawn; }
+  uint32_t framesSkipped() const { return skipped; }
+
+private:
+  uint32_t minPeriod = 16;
+  uint32_t maxPeriod = 100;
+  uint32_t period = 16;
+  uint32_t viewPeriod = 0;
+  int fastDelta = 3;
+  bool adaptive = true;
+  uint32_t drawn = 0;
+  uint32_t skipped = 0;
+};
@@ -0,0 +1,126 @@
+/*********************************************************************************************************
+ * Instrumentation - always-on counters for the hot path
+ *
+ * Description:
+ *   Cheap enough to leave running on every unit in the field:
+ *     - per-stage CPU time (cycle counter), as calls, mean and worst case per reporting window
+ *     - acquisition periods that overran LOOP_PERIOD (missed deadlines)
+ *     - the ADC sample rate actually achieved
+ *     - readings dropped because the display queue was full
+ *     - the duty cycle: the share of the time spent awake and sampling (below 100% only in low-power mode)
+ *     - how long after boot the first settled reading and the first meter frame arrived (once)
+ *   Each counter is only written by one task (the stage being timed, or the one calling the other
+ *   record functions) and poll() only reads them, turning the running totals into per-window figures.
+ *   The totals are 32-bit atomics, so a read on the other core never tears, and the differences taken
+ *   per window stay right when they wrap. The worst case of a stage is kept per window by the writer:
+ *   poll() moves the window on, and the writer starts a fresh maximum in the other of two slots when it
+ *   sees that, so the slot poll() reads is never written by both.
+ *
+ * Example:
+ *   { StageTimer timer(instruments, STAGE_NEEDLE); updateMeter(voltage); } // times the block
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <esp_timer.h>
+
+enum Stage : uint8_t {
+  STAGE_ACQUIRE, // readAndMapSensor()
+  STAGE_NEEDLE,  // updateMeter()
+  STAGE_READOUT, // displayaveValue()
+  STAGE_FRAME,   // a whole display frame (needle + readout, or one sprite frame)
+  STAGE_COUNT
+};
+
+// Figures for one reporting window
+struct InstrumentReport {
+  uint32_t windowMs;
+  uint32_t calls[STAGE_COUNT];
+  float meanUs[STAGE_COUNT];
+  float maxUs[STAGE_COUNT];
+  float sampleRate;      // ADC samples per second actually processed
+  float framesPerSecond; // display frames drawn per second
+  uint32_t missedDeadlines; // since boot
+  uint32_t queueOverruns;   // since boot
+  float dutyCycle;          // fraction of the window not spent sleeping between low-power bursts (0 to 1)
+};
+
+class Instrumentation {
+public:
+  void record(Stage stage, uint32_t cycles) {
+    StageCounter &c = stages[stage];
+    uint32_t now = window.load(std::memory_order_acquire);
+    if (c.window != now) {
+      c.window = now; // a new window, its maximum starts again (the other slot holds the one poll() reports)
+      c.maxCycles[now & 1].store(0, std::memory_order_relaxed);
+    }
+    bump(c.calls, 1);
+    bump(c.cycles, cycles);
+    if (cycles > c.maxCycles[now & 1].load(std::memory_order_relaxed)) {
+      c.maxCycles[now & 1].store(cycles, std::memory_order_relaxed);
+    }
+  }
+
+  void addSamples(uint32_t count) { bump(samples, count); }
+  void missedDeadline() { bump(missed, 1); }
+  void queueOverrun() { bump(overruns, 1); }
+  void slept(uint32_t us) { bump(sleepUs, us); }
+
+  // Boot milestones, only the first call of each counts
+  void markFirstReading() { if (firstReading == 0) firstReading = esp_timer_get_time(); }
+  void markFirstFrame() { if (firstFrame == 0) firstFrame = esp_timer_get_time(); }
+
+  uint32_t totalSamples() const { return samples.load(std::memory_order_relaxed); }
+  uint32_t missedDeadlines() const { return missed.load(std::memory_order_relaxed); }
+
+  // Microseconds from the start of the app to the milestone (0 until it has happened)
+  uint32_t firstReadingUs() const { return firstReading; }
+  uint32_t firstFrameUs() const { return firstFrame; }
+  uint32_t queueOverruns() const { return overruns.load(std::memory_order_relaxed); }
+
+  // Fills in 'report' and starts a new window once every 'periodMs', otherwise returns false
+  bool poll(uint32_t nowMs, uint32_t periodMs, InstrumentReport &report);
+
+private:
+  struct StageCounter {
+    std::atomic<uint32_t> calls{0};
+    std::atomic<uint32_t> cycles{0};       // wraps, a window's worth is well below 2^32 cycles
+    std::atomic<uint32_t> maxCycles[2] = {}; // worst case of the windows with an even and an odd number
+    uint32_t window = 0;                   // writer's own copy of the window it is filling
+  };
+
+  // Only ever called by the counter's one writer, so a load and a store are enough (no read-modify-write cycle)
+  static void bump(std::atomic<uint32_t> &counter, uint32_t by) {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+  }
+
+  StageCounter stages[STAGE_COUNT];
+  std::atomic<uint32_t> window{0}; // moved on by poll()
+  std::atomic<uint32_t> samples{0};
+  std::atomic<uint32_t> missed{0};
+  std::atomic<uint32_t> overruns{0};
+  std::atomic<uint32_t> sleepUs{0}; // wraps, like the cycle counts
+  volatile uint32_t firstReading = 0;
+  volatile uint32_t firstFrame = 0;
+
+  // Totals at the start of the current window
+  uint32_t windowStart = 0;
+  uint32_t lastCalls[STAGE_COUNT] = {};
+  uint32_t lastCycles[STAGE_COUNT] = {};
+  uint32_t lastSamples = 0;
+  uint32_t lastSleepUs = 0;
+};
+
+// Records the cycles spent between construction and destruction against a stage
+class StageTimer {
+public:
+  StageTimer(Instrumentation &inst, Stage s) : instruments(inst), stage(s), start(ESP.getCycleCount()) {}
+  ~StageTimer() { instruments.record(stage, ESP.getCycleCount() - start); }
+
+private:
+  Instrumentation &instruments;
+  Stage stage;
+  uint32_t start;
+};
@@ -0,0 +1,39 @@
+/*********************************************************************************************************
+ * NeedleAnimator - critically damped needle motion between readings
+ *
+ * Description:
+ *   The filtered reading only changes LOOP_PERIOD at a time, and once it is shown as-is the needle jumps
+ *   straight to each new value. The animator treats the needle like a damped spring pulled towards the
+ *   latest reading and works out where it is at every display frame, so the needle glides at the frame
+ *   rate however far apart the readings are. The spring is critically damped: it gets there as quickly
+ *   as it can without overshooting or ringing.
+ *
+ *   Each update() solves the spring exactly over the elapsed time (one expf()), so a long gap between
+ *   frames (skipped frames, low-power bursts) just brings the needle closer to the reading instead of
+ *   making the motion unstable.
+ *
+ * Notes:
+ *   - Runs in the display task only; nothing here blocks or touches the acquisition path.
+ *   - Within about 5 time constants the needle is back at rest on the reading.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+
+class NeedleAnimator {
+public:
+  // Spring with the given time constant, at rest at 'value'
+  void begin(float timeConstantMs, float value);
+
+  // Move towards 'target' for 'elapsedUs' microseconds, returns where the needle is now
+  float update(float target, uint32_t elapsedUs);
+
+  // Where the needle is
+  float value() const { return position; }
+
+private:
+  float omega = 1; // 1 / time constant, in 1/s
+  float position = 0;
+  float velocity = 0; // units per second
+};
@@ -0,0 +1,96 @@
+/*********************************************************************************************************
+ * NeedleMeter - analog meter with a precomputed needle geometry table
+ *
+ * Description:
+ *   The face is drawn by TFT_eWidget's MeterWidget::analogMeter(), but the needle is drawn here. Like
+ *   MeterWidget, the needle has 121 positions (-10 to 110 on the meter's 0-100 scale, one degree apart),
+ *   and the tip and base coordinates for every position are worked out once at start-up, so moving the
+ *   needle is a table lookup and a few line draws with no sin/cos/tan.
+ *
+ * Notes:
+ *   - The needle sweep is symmetric about the vertical, so only the 61 angles from vertical to the end stop
+ *     are stored (3 bytes each). The table is shared by every NeedleMeter instance.
+ *   - updateNeedle() never blocks and does nothing if neither the needle nor the markers would move.
+ *   - Optional peak-hold markers (small triangles just inside the scale) show the lowest and highest value
+ *     over a period. They are drawn under the needle and redrawn whenever the needle moves.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+#include <TFT_eWidget.h>
+
+// Needle positions either side of the vertical (the sweep is -60 to +60 degrees)
+#define NEEDLE_HALF_SWEEP 60
+
+#define NEEDLE_HIDDEN INT16_MIN // needle position when no needle is drawn
+
+#define MARKER_COLOR TFT_BLUE
+#define MARKER_NONE INT16_MIN // marker position when no marker is shown
+
+// Text positions on the face, relative to the meter's top left corner
+#define METER_READOUT_X 60           // right edge of the value readout in the bottom left corner
+#define METER_READOUT_Y (119 - 20)   // top of the value readout and the units text
+#define METER_READOUT_CELLS 6        // characters in the readout (e.g. "-917.0")
+#define METER_UNITS_X (5 + 230 - 40) // centre of the units text in the bottom right corner
+
+class NeedleMeter {
+public:
+  explicit NeedleMeter(TFT_eSPI *tft);
+
+  // Same as the MeterWidget functions
+  void setZones(uint16_t rs, uint16_t re, uint16_t os, uint16_t oe, uint16_t ys, uint16_t ye, uint16_t gs, uint16_t ge);
+  void analogMeter(uint16_t x, uint16_t y, float fullScale, const char *units, const char *s0, const char *s1,
+                   const char *s2, const char *s3, const char *s4);
+
+  // Take over a face that analogMeter() drew earlier and that was copied back in since (e.g. from a saved
+  // image), with its needle still at 0. Sets everything up as analogMeter() would without drawing anything.
+  void attachFace(uint16_t x, uint16_t y, float fullScale, const char *units);
+
+  // Move the needle to 'value' (0 to fullScale), returns false if the needle and markers were already there
+  bool updateNeedle(float value);
+
+  // Erase the needle (e.g. the one analogMeter() leaves at 0), the next updateNeedle() draws it again
+  void removeNeedle();
+
+  // Peak-hold markers at 'low' and 'high' (same units as updateNeedle()), drawn by the next updateNeedle()
+  void setMarkers(float low, float high);
+  void clearMarkers();
+
+  // Needle position (-10 to 110) for a value
+  int position(float value) const;
+
+private:
+  struct Needle {
+    int16_t baseX; // where the needle starts (it doesn't start at the pivot), y is always 150 - 24
+    int16_t tipX;
+    int16_t tipY;
+  };
+
+  struct GeometryEntry {
+    uint8_t tipDx;  // 98 * sin(angle), horizontal distance from the pivot to the tip
+    uint8_t tipDy;  // 98 * cos(angle), height of the tip above the pivot
+    uint8_t baseDx; // 24 * tan(angle), horizontal offset of the needle base
+  };
+
+  static void buildGeometry();
+  static Needle needleAt(int position);
+  void drawNeedle(const Needle &needle, uint16_t sideColor, uint16_t centreColor);
+  void drawMarker(int position, uint16_t color);
+
+  static GeometryEntry geometry[NEEDLE_HALF_SWEEP + 1];
+  static bool geometryReady;
+
+  TFT_eSPI *display;
+  MeterWidget face;
+  uint16_t mx = 0;
+  uint16_t my = 0;
+  float scale = 1.0f;
+  const char *label = "";
+  int shownPosition = 0; // NEEDLE_HIDDEN after removeNeedle()
+  Needle shown = {};
+
+  // Peak-hold markers (low, high): where they should be and where they are drawn
+  int16_t markerWanted[2] = {MARKER_NONE, MARKER_NONE};
+  int16_t markerShown[2] = {MARKER_NONE, MARKER_NONE};
+};
@@ -0,0 +1,60 @@
+/*********************************************************************************************************
+ * PowerManager - backlight, CPU clock and sleep control for running from the battery
+ *
+ * Description:
+ *   In low-power mode the backlight is dimmed, the CPU clock drops from 240MHz to 80MHz, and the caller
+ *   sleeps between short bursts of sampling (see main.cpp). A sleep is either an ordinary task delay,
+ *   where both cores sit in the idle task's wait-for-interrupt, or a light sleep of the whole chip, which
+ *   also stops the clocks and most of the peripherals. A light sleep ends on a timer or when the wake pin
+ *   (the button) goes low.
+ *
+ * Notes:
+ *   - The backlight PWM runs from the RTC 8MHz clock, which is kept on in light sleep, so the dimmed
+ *     backlight doesn't switch off or flash while the chip sleeps.
+ *   - The native USB serial port drops out during a light sleep, so don't light-sleep while streaming.
+ *   - Nothing may be using the display bus (e.g. a DMA transfer) when a light sleep starts.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <driver/ledc.h>
+
+#define BACKLIGHT_PIN 38 // TFT_BL on the T-Display-S3
+#define LCD_POWER_PIN 15 // switches the display supply (needed when running from the battery)
+#define BACKLIGHT_FULL 255
+
+#define FULL_POWER_CPU_MHZ 240
+#define LOW_POWER_CPU_MHZ 80 // lowest clock that keeps the APB (and so the peripherals' timing) at 80MHz
+
+class PowerManager {
+public:
+  // Switch on the display supply (before tft.init()), 'wakePin' ends a light sleep when it goes low
+  void begin(uint8_t wakePin);
+
+  // Drive the backlight with the PWM (after tft.init(), which sets the pin up as a plain output)
+  void attachBacklight();
+
+  // Backlight brightness, 0 (off) to BACKLIGHT_FULL
+  void setBacklight(uint8_t level);
+
+  // Dim the backlight to 'dimLevel' and slow the CPU down
+  void enterLowPower(uint8_t dimLevel);
+
+  // Restore the full backlight and CPU clock
+  void exitLowPower();
+
+  bool lowPower() const { return isLow.load(std::memory_order_acquire); }
+
+  // Sleep for 'ms' (woken early by the wake pin in a light sleep), returns how long was spent asleep in us
+  uint32_t sleep(uint32_t ms, bool light);
+
+  // The last light sleep was ended by the wake pin rather than the timer
+  bool wokeOnPin() const { return pinWake; }
+
+private:
+  uint8_t wakeGpio = 0;
+  bool pinWake = false;
+  std::atomic<bool> isLow{false};
+};
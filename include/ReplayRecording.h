@@ -0,0 +1,512 @@
+// Generated by tools/embed_recording.py from synthetic 0.40s (8000 samples of 1 channels at 20000 S/s), do not edit
+
+#pragma once
+
+#include <Arduino.h>
+
+#define REPLAY_CHANNELS 1
+#define REPLAY_SAMPLE_RATE_HZ 20000
+#define REPLAY_SOURCE "synthetic 0.40s"
+
+const uint16_t REPLAY_SAMPLES[] PROGMEM = {
+    2047,2051,2049,2051,2053,2053,2050,2055,2051,2051,2055,2055,2051,2049,2049,2054,
+    2057,2053,2054,2054,2053,2059,2060,2055,2061,2061,2055,2061,2055,2056,2057,2056,
+    2057,2061,2057,2064,2057,2065,2065,2065,2061,2059,2062,2062,2063,2068,2068,2062,
+    2062,2063,2070,2065,2068,2069,2065,2071,2070,2071,2069,2065,2070,2065,2065,2072,
+    2069,2065,2073,2073,2073,2067,2074,2071,2067,2070,2068,2072,2074,2069,2068,2074,
+    2075,2076,2072,2072,2070,2069,2076,2076,2077,2077,2074,2075,2069,2072,2077,2077,
+    2076,2074,2072,2077,2070,2073,2071,2072,2077,2070,2075,2069,2070,2072,2069,2071,
+    2075,2071,2074,2070,2076,2071,2075,2076,2076,2075,2075,2069,2070,2075,2074,2075,
+    2071,2070,2070,2068,2071,2068,2073,2071,2069,2066,2067,2066,2071,2066,2066,2064,
+    2068,2070,2071,2063,2065,2068,2067,2064,2067,2067,2061,2066,2066,2064,2064,2062,
+    2066,2066,2065,2064,2065,2060,2060,2060,2057,2060,2060,2056,2056,2055,2056,2058,
+    2056,2059,2052,2055,2058,2058,2053,2054,2054,2058,2057,2054,2051,2056,2052,2053,
+    2055,2049,2050,2052,2048,2047,2052,2047,2050,2051,2046,2050,2044,2048,2047,2041,
+    2041,2041,2043,2048,2039,2044,2045,2044,2045,2044,2045,2037,2039,2044,2039,2042,
+    2041,2040,2036,2038,2034,2036,2035,2040,2033,2040,2034,2036,2031,2034,2037,2037,
+    2033,2031,2037,2031,2029,2033,2035,2027,2033,2033,2032,2034,2027,2028,2032,2026,
+    2033,2025,2028,2024,2027,2027,2031,2026,2028,2031,2024,2030,2025,2023,2030,2030,
+    2026,2023,2026,2029,2022,2028,2023,2024,2022,2020,2026,2028,2026,2020,2027,2027,
+    2019,2027,2020,2019,2020,2024,2026,2019,2019,2019,2022,2023,2027,2025,2025,2021,
+    2023,2021,2022,2023,2021,2025,2020,2027,2021,2026,2027,2022,2026,2023,2020,2022,
+    2025,2021,2025,2028,2021,2025,2024,2023,2023,2025,2025,2025,2022,2022,2022,2029,
+    2023,2025,2024,2026,2025,2025,2030,2027,2030,2026,2033,2029,2033,2028,2034,2034,
+    2035,2034,2028,2034,2036,2031,2029,2035,2037,2034,2036,2034,2032,2033,2032,2038,
+    2039,2034,2037,2035,2033,2040,2037,2041,2042,2038,2036,2040,2040,2039,2038,2044,
+    2040,2046,2042,2042,2039,2047,2043,2048,2045,2041,2046,2047,2045,2051,2043,2048,
+    2049,2048,2045,2053,2047,2054,2054,2052,2048,2053,2055,2052,2052,2057,2051,2057,
+    2054,2055,2057,2054,2058,2053,2059,2053,2054,2059,2054,2054,2063,2056,2056,2057,
+    2063,2063,2064,2058,2060,2061,2066,2064,2066,2059,2065,2063,2061,2068,2062,2065,
+    2065,2065,2070,2062,2062,2066,2064,2063,2065,2070,2071,2071,2066,2068,2071,2065,
+    2069,2066,2074,2070,2071,2073,2074,2071,2069,2071,2075,2070,2071,2073,2074,2076,
+    2074,2076,2075,2070,2070,2071,2069,2075,2076,2070,2072,2076,2074,2069,2070,2074,
+    2076,2073,2069,2071,2072,2072,2069,2071,2077,2071,2077,2076,2075,2075,2077,2071,
+    2077,2075,2068,2075,2069,2074,2074,2072,2073,2071,2070,2071,2075,2067,2067,2067,
+    2074,2072,2071,2072,2069,2074,2074,2068,2073,2066,2070,2066,2071,2070,2071,2064,
+    2067,2069,2068,2064,2064,2070,2070,2065,2063,2066,2063,2061,2062,2067,2067,2059,
+    2061,2064,2063,2064,2063,2062,2065,2056,2062,2058,2055,2062,2057,2061,2061,2062,
+    2057,2059,2059,2056,2052,2053,2058,2053,2054,2054,2049,2054,2052,2052,2053,2056,
+    2052,2048,2050,2049,2054,2046,2053,2052,2051,2048,2047,2044,2047,2048,2048,2047,
+    2041,2044,2041,2044,2041,2046,2042,2043,2042,2043,2042,2042,2040,2037,2043,2037,
+    2040,2034,2039,2036,2040,2038,2034,2032,2037,2039,2039,2039,2039,2034,2033,2034,
+    2037,2037,2035,2035,2033,2034,2035,2033,2031,2029,2026,2030,2031,2026,2031,2033,
+    2027,2024,2030,2024,2028,2029,2023,2029,2024,2024,2029,2025,2026,2029,2030,2027,
+    2029,2027,2028,2029,2026,2029,2020,2026,2027,2026,2022,2024,2024,2020,2020,2024,
+    2027,2027,2020,2024,2022,2021,2019,2027,2023,2020,2021,2022,2019,2024,2019,2023,
+    2026,2024,2025,2025,2026,2025,2027,2019,2020,2022,2023,2022,2025,2023,2028,2021,
+    2025,2023,2027,2024,2023,2021,2024,2025,2024,2029,2022,2029,2027,2026,2026,2031,
+    2029,2026,2026,2032,2027,2032,2026,2026,2027,2029,2025,2031,2030,2026,2032,2031,
+    2027,2027,2029,2030,2031,2028,2036,2029,2033,2038,2034,2037,2036,2037,2037,2032,
+    2033,2036,2040,2033,2035,2040,2039,2039,2042,2040,2037,2041,2039,2045,2042,2045,
+    2046,2043,2045,2039,2040,2048,2040,2047,2044,2041,2047,2049,2047,2045,2049,2051,
+    2044,2049,2046,2046,2050,2054,2052,2054,2049,2052,2052,2050,2055,2050,2056,2052,
+    2058,2056,2058,2056,2058,2054,2058,2060,2056,2056,2059,2057,2063,2059,2059,2062,
+    2060,2060,2064,2060,2058,2062,2062,2063,2067,2065,2063,2062,2061,2065,2069,2065,
+    2063,2067,2069,2069,2062,2067,2071,2068,2071,2064,2072,2065,2071,2069,2072,2068,
+    2066,2070,2067,2066,2069,2070,2071,2066,2075,2070,2074,2067,2073,2075,2074,2075,
+    2070,2072,2076,2076,2073,2075,2072,2074,2077,2077,2070,2073,2069,2074,2069,2075,
+    2076,2073,2073,2075,2077,2074,2071,2072,2077,2075,2069,2075,2077,2073,2073,2077,
+    2076,2071,2070,2072,2072,2073,2072,2069,2069,2075,2071,2071,2072,2073,2069,2073,
+    2074,2071,2071,2069,2066,2073,2071,2067,2068,2070,2068,2065,2067,2069,2066,2065,
+    2064,2071,2065,2062,2069,2064,2070,2069,2065,2062,2066,2065,2062,2068,2066,2063,
+    2064,2062,2066,2064,2064,2063,2063,2056,2059,2058,2058,2055,2059,2057,2061,2059,
+    2059,2058,2056,2056,2053,2054,2054,2054,2054,2055,2053,2052,2052,2050,2048,2055,
+    2049,2050,2050,2049,2048,2048,2053,2045,2950,2052,2047,2048,2045,2045,2042,2043,
+    2043,2045,2043,2047,2044,2046,2046,2039,2042,2042,2045,2037,2039,2043,2041,2038,
+    2041,2034,2041,2038,2036,2035,2039,2035,2038,2034,2033,2039,2032,2035,2030,2034,
+    2030,2035,2033,2033,2029,2032,2027,2035,2035,2034,2031,2028,2032,2030,2032,2032,
+    2026,2030,2024,2032,2029,2026,2027,2025,2027,2029,2026,2027,2029,2027,2029,2029,
+    2028,2029,2026,2022,2025,2024,2022,2024,2028,2024,2027,2028,2020,2021,2024,2025,
+    2019,2023,2020,2022,2024,2019,2024,2019,2020,2025,2026,2020,2025,2019,2024,2020,
+    2020,2025,2025,2023,2024,2024,2020,2022,2021,2022,2023,2021,2026,2028,2024,2028,
+    2028,2020,2022,2023,2027,2024,2021,2028,2025,2027,2025,2028,2030,2027,2029,2025,
+    2025,2027,2027,2027,2031,2029,2030,2029,2033,2030,2031,2027,2026,2030,2029,2030,
+    2029,2030,2031,2034,2030,2033,2033,2034,2032,2031,2031,2031,2036,2031,2039,2037,
+    2040,2035,2034,2033,2039,2039,2037,2035,2039,2040,2044,2039,2036,2044,2042,2045,
+    2040,2046,2042,2042,2040,2044,2047,2046,2042,2043,2050,2043,2042,2047,2046,2045,
+    2051,2050,2050,2053,2049,2048,2047,2053,2050,2048,2052,2053,2057,2054,2055,2054,
+    2050,2059,2052,2058,2055,2056,2059,2055,2058,2059,2056,2054,2057,2056,2060,2064,
+    2059,2061,2059,2063,2065,2064,2060,2061,2059,2065,2066,2066,2060,2068,2061,2064,
+    2064,2063,2065,2065,2067,2064,2068,2067,2068,2066,2064,2072,2069,2072,2068,2071,
+    2066,2067,2068,2066,2069,2067,2070,2069,2072,2070,2072,2075,2070,2068,2075,2076,
+    2069,2072,2073,2076,2073,2070,2072,2072,2073,2075,2069,2072,2072,2076,2075,2074,
+    2069,2076,2071,2071,2071,2076,2070,2071,2070,2070,2072,2075,2070,2070,2073,2077,
+    2069,2072,2073,2069,2073,2068,2072,2070,2070,2076,2072,2068,2072,2074,2068,2073,
+    2069,2070,2068,2070,2069,2066,2071,2072,2069,2065,2065,2068,2072,2070,2067,2065,
+    2067,2067,2071,2066,2070,2068,2070,2063,2064,2066,2069,2061,2064,2067,2066,2066,
+    2064,2059,2061,2060,2058,2064,2058,2063,2058,2060,2058,2055,2061,2059,2054,2062,
+    2058,2057,2059,2053,2058,2052,2053,2059,2057,2052,2057,2052,2055,2055,2056,2051,
+    2055,2055,2052,2049,2052,2049,2046,2049,2045,2050,2045,2047,2046,2050,2042,2045,
+    2047,2045,2048,2046,2039,2042,2040,2040,2045,2043,2042,2042,2037,2041,2038,2040,
+    2041,2042,2040,2040,2038,2040,2034,2036,2036,2037,2037,2033,2033,2038,2030,2032,
+    2035,2034,2033,2035,2033,2036,2027,2034,2034,2030,2028,2027,2033,2034,2028,2028,
+    2027,2026,2028,2026,2026,2027,2023,2031,2027,2026,2022,2025,2027,2028,2030,2025,
+    2025,2027,2025,2021,2021,2028,2025,2022,2021,2021,2023,2020,2025,2025,2025,2023,
+    2027,2023,2025,2027,2027,2025,2022,2019,2023,2020,2020,2019,2019,2020,2024,2023,
+    2025,2026,2023,2027,2026,2026,2026,2025,2023,2023,2023,2021,2025,2026,2022,2028,
+    2027,2026,2026,2027,2029,2023,2021,2026,2021,2030,2030,2028,2030,2026,2022,2030,
+    2030,2028,2027,2027,2028,2029,2026,2025,2032,2030,2033,2034,2032,2030,2026,2028,
+    2034,2027,2029,2035,2030,2033,2029,2037,2030,2037,2031,2038,2035,2034,2032,2032,
+    2034,2034,2034,2041,2041,2041,2036,2042,2043,2038,2044,2041,2044,2037,2039,2043,
+    2044,2038,2041,2040,2046,2040,2042,2045,2044,2046,2049,2047,2043,2043,2046,2049,
+    2044,2048,2052,2050,2050,2050,2051,2052,2049,2048,2055,2049,2057,2056,2049,2053,
+    2052,2057,2052,2059,2052,2054,2060,2053,2054,2057,2054,2060,2056,2056,2063,2060,
+    2061,2056,2059,2059,2063,2066,2063,2058,2060,2059,2066,2062,2063,2065,2069,2062,
+    2067,2068,2063,2068,2069,2065,2064,2068,2071,2064,2065,2069,2072,2071,2065,2071,
+    2070,2072,2067,2071,2072,2074,2071,2069,2075,2067,2073,2068,2074,2075,2076,2068,
+    2072,2068,2069,2070,2070,2068,2071,2076,2074,2072,2071,2076,2072,2076,2071,2075,
+    2074,2074,2072,2076,2073,2077,2074,2073,2074,2070,2076,2071,2069,2074,2070,2075,
+    2077,2070,2070,2070,2075,2069,2076,2074,2071,2071,2074,2075,2073,2075,2067,2073,
+    2070,2074,2071,2066,2066,2072,2070,2067,2067,2071,2073,2064,2070,2071,2067,2068,
+    2068,2071,2070,2062,2065,2065,2063,2065,2061,2067,2063,2060,2064,2068,2061,2067,
+    2063,2063,2059,2064,2058,2061,2062,2057,2059,2057,2061,2058,2059,2057,2054,2060,
+    2059,2054,2052,2058,2052,2057,2051,2057,2051,2053,2050,2050,2054,2054,2050,2056,
+    2055,2050,2053,2052,2049,2046,2049,2052,2051,2049,2045,2046,2045,2046,2045,2048,
+    2049,2041,2040,2042,2042,2046,2046,2045,2041,2044,2039,2044,2037,2042,2038,2035,
+    2043,2039,2035,2034,2034,2040,2033,2032,2039,2036,2033,2031,2037,2038,2037,2037,
+    2034,2035,2036,2029,2029,2031,2032,2033,2028,2028,2028,2030,2032,2034,2025,2031,
+    2029,2025,2032,2028,2028,2025,2023,2027,2030,2031,2022,2022,2024,2030,2028,2026,
+    2023,2025,2025,2025,2027,2029,2020,2020,2024,2026,2021,2028,2024,2027,2024,2023,
+    2022,2023,2019,2026,2020,2022,2022,2020,2026,2020,2023,2026,2021,2027,2025,2021,
+    2027,2026,2020,2023,2022,2021,2021,2022,2023,2024,2025,2024,2022,2022,2028,2021,
+    2020,2021,2025,2023,2024,2022,2029,2025,2029,2023,2030,2026,2022,2024,2025,2028,
+    2031,2026,2023,2029,2026,2032,2025,2028,2026,2033,2032,2034,2027,2030,2030,2034,
+    2029,2032,2030,2028,2032,2032,2029,2034,2037,2031,2037,2038,2032,2034,2036,2040,
+    2032,2037,2037,2035,2038,2039,2034,2040,2036,2040,2044,2037,2041,2039,2040,2044,
+    2040,2041,2045,2045,2046,2048,2047,2047,2044,2043,2046,2050,2050,2047,2044,2047,
+    2044,2044,2046,2053,2052,2051,2046,2049,2048,2050,2048,2052,2051,2051,2049,2055,
+    2051,2059,2057,2059,2053,2056,2056,2056,2061,2058,2057,2057,2055,2062,2063,2063,
+    2059,2056,2060,2058,2064,2065,2063,2063,2062,2061,2064,2062,2063,2066,2062,2069,
+    2061,2065,2063,2069,2066,2069,2067,2063,2070,2072,2066,2069,2071,2070,2066,2072,
+    2071,2073,2066,2070,2074,2067,2066,2071,2070,2068,2068,2068,2071,2069,2068,2074,
+    2074,2073,2076,2070,2071,2073,2071,2073,2072,2073,2076,2070,2075,2072,2075,2075,
+    2071,2070,2072,2072,2076,2075,2069,2070,2069,2073,2077,2076,2072,2073,2073,2070,
+    2076,2073,2075,2068,2073,2073,2072,2069,2073,2070,2074,2073,2067,2075,2067,2071,
+    2075,2066,2073,2072,2070,2070,2074,2068,2069,2070,2071,2070,2064,2066,2066,2068,
+    2063,2069,2066,2066,2063,2067,2069,2061,2064,2061,2061,2062,2067,2064,2061,2066,
+    2060,2065,2065,2060,2065,2057,2063,2063,2060,2056,2055,2061,2057,2060,2054,2057,
+    2059,2056,2056,2057,2057,2059,2059,2058,2052,2057,2055,2054,2050,2049,2055,2050,
+    2049,2055,2052,2051,2047,2049,2045,2045,2049,2045,2050,2047,2047,2047,2042,2047,
+    2042,2046,2047,2043,2045,2041,2043,2038,2038,2040,2043,2042,2040,2038,2039,2043,
+    2036,2037,2037,2039,2040,2037,2041,2032,2035,2033,2039,2037,2035,2035,2032,2033,
+    2031,2037,2031,2029,2034,2030,2035,2035,2035,2032,2029,2030,2032,2029,2028,2031,
+    2028,2028,2026,2027,2028,2026,2025,2028,2024,2028,2024,2026,2025,2028,2029,2028,
+    2021,2023,2027,2022,2029,2025,2028,2024,2023,2022,2027,2021,2021,2021,2025,2021,
+    2020,2022,2021,2023,2024,2027,2022,2020,2020,2025,2027,2025,2019,2022,2027,2019,
+    2022,2027,2024,2022,2022,2022,2024,2019,2023,2021,2025,2024,2022,2020,2025,2026,
+    2026,2023,2022,2023,2024,2027,2021,2023,2024,2026,2023,2030,2029,2029,2029,2025,
+    2029,2023,2030,2030,2026,2026,2028,2027,2025,2026,2033,2026,2034,2028,2032,2030,
+    2035,2030,2030,2033,2029,2028,2035,2034,2035,2034,2031,2036,2032,2033,2032,2032,
+    2037,2036,2040,2035,2041,2040,2039,2036,2035,2042,2041,2044,2039,2042,2041,2043,
+    2046,2042,2042,2043,2044,2047,2048,2040,2046,2048,2044,2049,2044,2048,2045,2051,
+    2046,2050,2052,2047,2049,2047,2050,2053,2054,2056,2048,2049,2052,2050,2050,2055,
+    2054,2059,2058,2052,2058,2055,2060,2061,2053,2059,2062,2056,2055,2058,2062,2061,
+    2063,2058,2060,2063,2063,2066,2063,2058,2060,2067,2062,2062,2065,2065,2068,2069,
+    2068,2065,2066,2062,2069,2068,2067,2067,2064,2072,2069,2067,2067,2066,2069,2065,
+    2069,2070,2066,2073,2072,2070,2071,2073,2069,2072,2074,2073,2070,2075,2074,2074,
+    2073,2070,2070,2076,2076,2068,2076,2070,2072,2077,2070,2074,2077,2075,2071,2070,
+    2076,2073,2074,2069,2069,2076,2070,2073,2072,2074,2069,2073,2072,2075,2072,2073,
+    2077,2070,2070,2071,2074,2069,2070,2070,2073,2075,2069,2073,2069,2071,2073,2072,
+    2072,2073,2069,2069,2067,2071,2067,2066,2067,2067,2067,2067,2070,2064,2064,2071,
+    2064,2066,2064,2070,2070,2064,2065,2063,2068,2064,2063,2063,2066,2066,2067,2066,
+    2062,2063,2064,2064,2061,2063,2060,2056,2064,2059,2058,2063,2057,2056,2056,2059,
+    2061,2055,2056,2056,2053,2053,2051,2058,2056,2057,2055,2057,2053,2050,2050,2049,
+    2051,2052,2048,2046,2054,2050,2052,2046,2045,2046,2043,2046,2043,2046,2049,2046,
+    2042,2041,2041,2048,2044,2041,2041,2039,2038,2038,2039,2043,2043,2039,2040,2036,
+    2035,2041,2036,2042,2041,2036,2038,2038,2035,2036,2038,2037,2039,2030,2033,2034,
+    2033,2035,2034,2034,2033,2036,2030,2028,2029,2028,2027,2027,2029,2030,2027,2033,
+    2027,2024,2029,2024,2024,2026,2029,2031,2023,2026,2022,2028,2024,2022,2027,2026,
+    2024,2028,2023,2021,2022,2024,2023,2024,2026,2027,2024,2020,2022,2028,2025,2024,
+    2027,2026,2025,2027,2021,2021,2024,2020,2022,2022,2020,2022,2025,2023,2024,2021,
+    2019,2027,2026,2027,2019,2021,2024,2023,2022,2020,2026,2025,2025,2022,2021,2020,
+    2027,2022,2024,2022,2027,2027,2026,2025,2023,2029,2029,2024,2024,2025,2022,2023,
+    2029,2025,2029,2024,2025,2030,2028,2029,2028,2031,2025,2033,2028,2030,2030,2027,
+    2030,2034,2027,2030,2031,2030,2030,2031,2036,2031,2035,2038,2033,2032,2036,2037,
+    2035,2033,2038,2039,2033,2034,2039,2034,2040,2039,2044,2037,2037,2038,2037,2041,
+    2040,2040,2040,2043,2047,2043,2046,2043,2048,2046,2045,2042,2047,2047,2051,2047,
+    2044,2047,2047,2046,2046,2051,2049,2054,2052,2051,2048,2051,2057,2051,2056,2052,
+    2054,2053,2059,2052,2060,2058,2052,2059,2059,2057,2055,2060,2056,2058,2059,2056,
+    2056,2061,2064,2057,2061,2064,2063,2066,2066,2059,2060,2062,2068,2064,2065,2064,
+    2064,2066,2068,2063,2070,2066,2069,2065,2063,2072,2067,2065,2066,2072,2072,2068,
+    2067,2069,2074,2074,2069,2068,2066,2071,2075,2069,2073,2074,2071,2072,2076,2072,
+    2074,2072,2073,2075,2069,2071,2074,2072,2070,2070,2076,2077,2076,2070,2070,2072,
+    2076,2074,2077,2070,2077,2074,2074,2070,2076,2073,2076,2074,2077,2076,2072,2069,
+    2072,2075,2068,2072,2073,2073,2075,2074,2068,2072,2068,2070,2075,2072,2067,2069,
+    2068,2068,2073,2071,2071,2073,2068,2069,2071,2072,2067,2064,2064,2067,2070,2071,
+    2064,2071,2068,2067,2065,2069,2063,2069,2068,2061,2066,2068,2067,2065,2063,2063,
+    2061,2061,2058,2059,2058,2059,2064,2058,2061,2060,2057,2062,2062,2057,2057,2055,
+    2055,2057,2058,2052,2054,2059,2058,2052,2051,2058,2054,2050,2053,2053,2056,2054,
+    2055,2047,2054,2046,2046,2050,2052,2049,2944,2046,2050,2051,2048,2049,2045,2041,
+    2043,2048,2048,2048,2046,2044,2047,2041,2045,2038,2043,2044,2043,2040,2038,2042,
+    2043,2034,2040,2037,2040,2034,2035,2039,2038,2039,2033,2037,2038,2038,2032,2031,
+    2030,2034,2032,2031,2036,2036,2034,2027,2030,2034,2028,2026,2031,2027,2029,2033,
+    2033,2029,2024,2024,2027,2032,2028,2028,2023,2027,2027,2024,2029,2025,2027,2023,
+    2021,2029,2024,2028,2023,2024,2027,2020,2020,2020,2020,2028,2022,2022,2025,2023,
+    2023,2021,2026,2025,2027,2025,2020,2023,2020,2027,2026,2023,2023,2023,2026,2027,
+    2025,2022,2022,2020,2024,2025,2024,2019,2019,2025,2026,2021,2021,2024,2026,2025,
+    2025,2021,2022,2027,2021,2027,2024,2027,2024,2027,2029,2022,2027,2028,2029,2029,
+    2031,2025,2023,2032,2029,2030,2028,2025,2029,2031,2032,2029,2031,2031,2027,2031,
+    2032,2034,2033,2036,2034,2035,2030,2030,2034,2038,2035,2031,2031,2036,2031,2038,
+    2034,2039,2039,2039,2037,2035,2036,2041,2038,2036,2041,2041,2042,2038,2038,2045,
+    2041,2042,2046,2039,2041,2045,2048,2045,2046,2043,2047,2050,2049,2047,2048,2051,
+    2044,2047,2049,2048,2050,2048,2052,2050,2047,2055,2056,2054,2053,2057,2049,2052,
+    2056,2054,2057,2055,2055,2054,2059,2055,2053,2054,2062,2055,2058,2061,2058,2061,
+    2060,2058,2064,2064,2062,2066,2064,2063,2063,2065,2066,2062,2064,2061,2064,2068,
+    2065,2068,2063,2066,2070,2066,2067,2065,2067,2070,2064,2064,2064,2069,2068,2065,
+    2072,2070,2074,2071,2066,2072,2066,2070,2074,2071,2073,2074,2071,2074,2076,2069,
+    2075,2076,2068,2069,2071,2069,2075,2073,2070,2073,2071,2070,2071,2072,2076,2073,
+    2076,2075,2072,2076,2071,2069,2077,2069,2073,2070,2072,2070,2076,2069,2071,2071,
+    2073,2076,2076,2074,2069,2076,2070,2073,2070,2073,2072,2067,2067,2071,2074,2071,
+    2070,2069,2072,2071,2073,2069,2070,2073,2068,2067,2071,2066,2072,2070,2072,2064,
+    2065,2071,2069,2068,2067,2067,2069,2066,2069,2064,2061,2065,2065,2067,2067,2065,
+    2067,2060,2065,2064,2060,2060,2064,2061,2062,2062,2063,2058,2062,2062,2056,2054,
+    2057,2053,2058,2052,2058,2057,2057,2055,2058,2051,2058,2049,2052,2055,2051,2055,
+    2055,2048,2047,2047,2046,2046,2047,2044,2045,2044,2047,2051,2048,2046,2049,2045,
+    2049,2044,2043,2045,2043,2041,2041,2039,2038,2046,2044,2041,2040,2040,2042,2036,
+    2043,2035,2042,2038,2041,2038,2036,2034,2033,2033,2033,2037,2031,2033,2037,2033,
+    2032,2029,2032,2036,2035,2033,2028,2035,2032,2027,2034,2031,2034,2028,2031,2025,
+    2032,2026,2033,2025,2025,2029,2030,2026,2027,2028,2030,2027,2030,2024,2027,2026,
+    2023,2030,2029,2029,2023,2025,2026,2027,2023,2026,2027,2021,2025,2021,2027,2020,
+    2027,2024,2022,2021,2022,2027,2025,2026,2024,2020,2028,2024,2024,2021,2021,2020,
+    2028,2022,2022,2027,2023,2024,2027,2025,2023,2026,2022,2030,2023,2028,2029,2028,
+    2026,2030,2023,2025,2025,2026,2032,2027,2024,2024,2033,2032,2029,2032,2034,2029,
+    2032,2030,2033,2034,2027,2036,2035,2029,2033,2031,2034,2032,2031,2034,2039,2035,
+    2037,2034,2037,2040,2036,2040,2037,2035,2037,2035,2037,2039,2044,2038,2040,2039,
+    2046,2039,2041,2047,2041,2045,2042,2047,2043,2047,2052,2050,2052,2050,2054,2047,
+    2053,2053,2049,2052,2049,2057,2051,2052,2052,2059,2057,2058,2060,2060,2064,2058,
+    2058,2062,2066,2063,2059,2067,2061,2068,2067,2066,2067,2068,2070,2071,2074,2070,
+    2070,2075,2071,2074,2074,2072,2078,2080,2075,2079,2080,2080,2084,2079,2081,2083,
+    2084,2081,2081,2089,2083,2084,2084,2092,2093,2094,2093,2097,2094,2096,2091,2098,
+    2096,2101,2096,2097,2101,2103,2102,2105,2100,2100,2101,2106,2104,2107,2109,2110,
+    2109,2110,2109,2111,2116,2119,2114,2120,2117,2122,2123,2122,2120,2125,2126,2121,
+    2130,2125,2124,2129,2128,2127,2133,2133,2131,2135,2132,2141,2135,2143,2143,2140,
+    2141,2147,2142,2142,2148,2149,2151,2154,2148,2150,2152,2153,2160,2158,2154,2160,
+    2157,2158,2160,2168,2165,2169,2166,2168,2171,2169,2171,2172,2175,2176,2177,2183,
+    2182,2178,2179,2182,2190,2189,2191,2189,2193,2190,2193,2199,2200,2195,2203,2201,
+    2202,2208,2206,2210,2209,2209,2216,2214,2216,2220,2216,2221,2218,2224,2223,2226,
+    2228,2234,2229,2231,2233,2241,2242,2239,2243,2241,2242,2250,2251,2247,2251,2253,
+    2258,2257,2264,2266,2267,2266,2271,2268,2275,2275,2276,2281,2277,2282,2285,2286,
+    2291,2294,2292,2295,2295,2297,2300,2302,2310,2306,2308,2310,2314,2315,2315,2324,
+    2327,2325,2328,2327,2334,2336,2338,2339,2341,2346,2343,2348,2354,2351,2355,2361,
+    2362,2368,2364,2367,2369,2375,2381,2378,2382,2381,2385,2385,2394,2397,2394,2404,
+    2404,2405,2412,2406,2411,2415,2414,2424,2424,2428,2431,2434,2437,2441,2444,2444,
+    2445,2444,2454,2451,2459,2459,2462,2463,2470,2473,2477,2473,2482,2483,2483,2491,
+    2487,2491,2493,2502,2499,2500,2509,2512,2509,2514,2514,2522,2524,2525,2532,2528,
+    2538,2534,2539,2539,2545,2551,2550,2553,2559,2559,2567,2563,2565,2568,2573,2573,
+    2577,2581,2586,2586,2592,2589,2594,2595,2603,2603,2608,2611,2613,2613,2615,2614,
+    2618,2620,2625,2631,2632,2636,2637,2634,2636,2640,2642,2646,2646,2655,2653,2655,
+    2660,2660,2663,2661,2664,2667,2670,2678,2676,2680,2681,2686,2686,2683,2685,2693,
+    2695,2690,2694,2699,2702,2701,2702,2708,2708,2710,2708,2709,2709,2712,2715,2713,
+    2714,2724,2722,2721,2720,2725,2722,2731,2730,2731,2735,2736,2734,2733,2739,2739,
+    2737,2736,2740,2737,2745,2742,2743,2739,2743,2743,2748,2744,2748,2750,2749,2750,
+    2752,2746,2753,2750,2750,2748,2754,2751,2747,2746,2754,2751,2749,2754,2748,2751,
+    2750,2748,2747,2752,2748,2746,2747,2747,2751,2744,2747,2750,2749,2744,2746,2741,
+    2742,2738,2743,2737,2736,2742,2734,2738,2737,2731,2730,2734,2727,2732,2725,2724,
+    2726,2725,2720,2726,2719,2717,2722,2713,2710,2711,2715,2712,2704,2706,2706,2702,
+    2698,2701,2694,2697,2693,2694,2694,2688,2682,2679,2678,2678,2674,2671,2673,2672,
+    2672,2666,2663,2665,2656,2655,2656,2648,2645,2646,2648,2646,2641,2637,2630,2634,
+    2631,2627,2627,2621,2620,2619,2616,2611,2604,2606,2601,2602,2596,2592,2589,2585,
+    2582,2580,2574,2576,2574,2567,2562,2566,2558,2553,2554,2549,2550,2549,2541,2536,
+    2533,2528,2532,2525,2521,2522,2513,2515,2510,2503,2508,2500,2493,2497,2494,2487,
+    2487,2484,2476,2473,2475,2468,2466,2459,2461,2458,2451,2447,2447,2439,2438,2432,
+    2430,2430,2429,2418,2422,2414,2413,2407,2402,2399,2397,2392,2394,2389,2382,2382,
+    2383,2373,2374,2366,2367,2365,2364,2361,2354,2355,2344,2345,2345,2341,2332,2335,
+    2330,2325,2324,2323,2318,2318,2312,2306,2306,2300,2297,2299,2296,2292,2289,2286,
+    2278,2277,2276,2273,2275,2267,2266,2265,2259,2253,2254,2255,2252,2242,2240,2242,
+    2234,2237,2234,2233,2225,2228,2220,2218,2221,2216,2217,2209,2210,2202,2205,2202,
+    2199,2200,2199,2196,2193,2184,2186,2184,2185,2178,2181,2171,2171,2168,2167,2168,
+    2164,2165,2163,2160,2153,2155,2150,2148,2150,2147,2146,2142,2138,2140,2140,2139,
+    2137,2138,2130,2134,2132,2123,2127,2125,2124,2119,2116,2119,2117,2120,2117,2115,
+    2113,2113,2113,2105,2106,2106,2102,2106,2097,2099,2097,2096,2097,2093,2093,2094,
+    2090,2093,2091,2093,2092,2089,2091,2085,2089,2080,2086,2084,2085,2085,2084,2076,
+    2078,2077,2075,2076,2073,2078,2077,2073,2074,2073,2068,2075,2071,2073,2068,2071,
+    2067,2068,2065,2068,2063,2062,2066,2064,2061,2061,2063,2061,2065,2059,2065,2063,
+    2066,2059,2065,2062,2066,2062,2064,2059,2059,2063,2061,2060,2060,2056,2060,2062,
+    2058,2059,2059,2060,2061,2058,2059,2055,2063,2061,2063,2062,2060,2056,2060,2057,
+    2059,2058,2060,2063,2062,2058,2060,2057,2064,2059,2058,2056,2058,2064,2063,2063,
+    2057,2061,2064,2064,2058,2059,2060,2060,2060,2066,2063,2065,2063,2065,2059,2063,
+    2065,2062,2061,2062,2061,2062,2062,2067,2066,2063,2066,2070,2063,2063,2069,2062,
+    2068,2070,2064,2070,2063,2065,2072,2072,2065,2064,2073,2066,2068,2069,2067,2068,
+    2071,2073,2070,2069,2068,2069,2069,2068,2074,2069,2068,2069,2075,2068,2069,2074,
+    2073,2071,2075,2071,2072,2077,2072,2069,2076,2072,2069,2077,2073,2070,2072,2070,
+    2075,2071,2073,2073,2070,2073,2072,2076,2078,2078,2078,2072,2070,2072,2075,2073,
+    2075,2073,2074,2072,2074,2071,2077,2071,2076,2076,2077,2071,2078,2070,2075,2070,
+    2074,2069,2072,2075,2070,2069,2076,2076,2071,2075,2072,2073,2069,2074,2072,2071,
+    2067,2072,2068,2073,2068,2069,2066,2073,2067,2069,2071,2071,2068,2064,2072,2067,
+    2067,2069,2064,2068,2067,2065,2068,2064,2062,2064,2069,2063,2067,2068,2061,2059,
+    2060,2060,2058,2061,2065,2058,2063,2064,2058,2062,2060,2063,2060,2059,2057,2062,
+    2058,2061,2053,2053,2055,2052,2055,2059,2055,2055,2050,2050,2057,2048,2049,2049,
+    2047,2055,2053,2050,2050,2053,2051,2045,2052,2046,2050,2049,2047,2042,2049,2041,
+    2049,2048,2044,2048,2041,2047,2042,2046,2039,2043,2039,2043,2043,2039,2043,2036,
+    2040,2041,2041,2035,2041,2036,2034,2033,2040,2034,2031,2035,2038,2032,2033,2037,
+    2034,2029,2029,2032,2029,2032,2027,2032,2035,2028,2031,2026,2026,2027,2025,2029,
+    2030,2030,2025,2025,2027,2029,2029,2026,2030,2028,2028,2024,2022,2024,2022,2023,
+    2027,2024,2028,2029,2024,2027,2025,2025,2021,2024,2023,2021,2027,2026,2021,2021,
+    2026,2020,2021,2019,2021,2023,2025,2020,2020,2022,2019,2027,2027,2026,2022,2027,
+    2024,2027,2027,2019,2022,2019,2022,2025,2022,2021,2020,2028,2021,2027,2024,2027,
+    2025,2022,2025,2029,2024,2029,2023,2029,2022,2025,2025,2022,2023,2030,2026,2023,
+    2023,2025,2029,2029,2027,2026,2028,2024,2033,2030,2026,2032,2026,2034,2030,2035,
+    2029,2035,2031,2036,2034,2035,2037,2032,2029,2035,2038,2035,2034,2033,2039,2032,
+    2037,2033,2036,2039,2036,2039,2038,2038,2040,2036,2036,2038,2039,2043,2040,2043,
+    2038,2042,2044,2044,2039,2048,2048,2040,2047,2048,2050,2049,2043,2050,2046,2047,
+    2052,2047,2047,2049,2049,2047,2051,2047,2050,2048,2053,2055,2052,2056,2051,2051,
+    2058,2058,2058,2052,2060,2060,2057,2057,2054,2062,2055,2056,2059,2057,2057,2062,
+    2062,2061,2065,2062,2058,2058,2062,2066,2059,2065,2064,2066,2068,2066,2063,2065,
+    2065,2067,2068,2062,2068,2069,2070,2067,2071,2069,2071,2068,2071,2069,2069,2065,
+    2072,2070,2067,2072,2066,2066,2072,2067,2071,2070,2074,2069,2067,2074,2074,2072,
+    2075,2073,2071,2076,2075,2070,2069,2076,2075,2074,2077,2073,2077,2070,2076,2075,
+    2075,2075,2070,2077,2076,2071,2070,2069,2075,2071,2070,2072,2070,2075,2076,2076,
+    2070,2070,2073,2070,2069,2075,2071,2070,2073,2074,2068,2067,2073,2067,2068,2074,
+    2067,2073,2069,2074,2070,2070,2069,2071,2066,2071,2065,2072,2072,2070,2067,2068,
+    2064,2064,2068,2066,2068,2065,2064,2067,2061,2068,2061,2068,2067,2065,2063,2061,
+    2066,2061,2059,2063,2060,2065,2061,2063,2056,2063,2055,2057,2059,2057,2060,2062,
+    2059,2053,2055,2055,2054,2055,2058,2051,2050,2051,2056,2051,2055,2053,2048,2054,
+    2052,2054,2051,2046,2048,2047,2049,2052,2946,2049,2051,2047,2043,2049,2047,2044,
+    2041,2042,2044,2047,2046,2045,2041,2038,2041,2044,2041,2037,2042,2041,2044,2037,
+    2042,2041,2040,2037,2034,2036,2036,2034,2039,2034,2036,2034,2038,2035,2036,2033,
+    2030,2030,2037,2028,2030,2033,2033,2027,2035,2035,2028,2027,2027,2028,2030,2028,
+    2033,2030,2032,2029,2028,2031,2027,2023,2024,2023,2029,2028,2027,2028,2029,2024,
+    2027,2025,2024,2023,2025,2027,2021,2021,2021,2024,2022,2027,2028,2028,2021,2022,
+    2020,2019,2021,2019,2027,2026,2020,2023,2026,2027,2027,2024,2027,2027,2020,2026,
+    2020,2023,2022,2023,2019,2025,2020,2019,2025,2028,2025,2022,2020,2023,2022,2026,
+    2022,2022,2020,2028,2027,2027,2025,2023,2023,2028,2028,2023,2027,2030,2025,2025,
+    2025,2028,2028,2024,2029,2031,2024,2025,2031,2031,2026,2030,2026,2033,2031,2034,
+    2030,2032,2034,2036,2029,2032,2030,2033,2034,2037,2035,2031,2037,2035,2039,2036,
+    2032,2035,2037,2035,2037,2041,2037,2042,2036,2036,2036,2044,2043,2044,2042,2042,
+    2045,2041,2040,2039,2040,2045,2046,2048,2048,2048,2048,2049,2049,2044,2050,2052,
+    2050,2050,2048,2047,2053,2052,2054,2048,2049,2056,2048,2055,2051,2056,2051,2053,
+    2055,2052,2054,2056,2057,2053,2060,2054,2061,2060,2059,2060,2061,2061,2058,2063,
+    2057,2058,2062,2063,2063,2061,2060,2061,2064,2063,2066,2064,2062,2061,2065,2068,
+    2068,2068,2067,2067,2064,2064,2066,2068,2068,2070,2069,2068,2069,2071,2067,2066,
+    2067,2066,2072,2074,2066,2072,2067,2069,2067,2075,2068,2071,2070,2067,2075,2075,
+    2076,2076,2070,2075,2074,2074,2076,2075,2072,2071,2074,2074,2070,2076,2075,2073,
+    2075,2075,2072,2071,2074,2071,2073,2076,2077,2077,2076,2071,2076,2070,2076,2070,
+    2075,2074,2074,2076,2070,2069,2074,2076,2075,2071,2076,2073,2074,2071,2070,2071,
+    2067,2074,2067,2071,2072,2069,2070,2071,2070,2070,2065,2066,2066,2067,2065,2067,
+    2066,2065,2066,2070,2063,2062,2067,2062,2069,2061,2065,2065,2062,2061,2059,2066,
+    2063,2061,2058,2062,2058,2060,2065,2061,2058,2059,2060,2063,2059,2057,2059,2061,
+    2057,2060,2060,2060,2057,2058,2057,2059,2050,2056,2050,2051,2055,2053,2051,2054,
+    2049,2054,2052,2047,2054,2045,2046,2051,2045,2047,2051,2046,2048,2049,2050,2041,
+    2047,2042,2040,2045,2043,2039,2044,2043,2046,2040,2037,2045,2037,2044,2038,2038,
+    2038,2039,2037,2040,2034,2034,2037,2032,2038,2040,2031,2035,2036,2034,2038,2031,
+    2034,2029,2033,2031,2033,2036,2028,2029,2032,2032,2034,2034,2034,2026,2032,2029,
+    2032,2029,2031,2024,2031,2028,2026,2026,2023,2023,2027,2028,2022,2023,2022,2022,
+    2024,2029,2022,2023,2025,2023,2028,2027,2024,2021,2021,2023,2025,2026,2020,2024,
+    2021,2027,2023,2022,2027,2022,2027,2026,2023,2021,2024,2024,2020,2020,2026,2022,
+    2019,2020,2019,2021,2025,2020,2023,2023,2020,2026,2027,2025,2028,2027,2028,2025,
+    2021,2026,2025,2022,2028,2028,2021,2028,2025,2024,2030,2029,2027,2026,2022,2026,
+    2030,2028,2024,2031,2027,2024,2028,2024,2032,2031,2029,2026,2029,2029,2033,2034,
+    2027,2034,2030,2028,2030,2028,2030,2029,2030,2035,2031,2034,2035,2033,2035,2040,
+    2036,2034,2038,2034,2041,2034,2039,2042,2041,2043,2037,2043,2040,2037,2039,2042,
+    2040,2041,2042,2046,2040,2048,2040,2042,2048,2049,2042,2046,2049,2047,2051,2045,
+    2049,2045,2052,2047,2049,2053,2051,2048,2055,2055,2055,2054,2050,2055,2053,2055,
+    2055,2051,2051,2058,2052,2056,2058,2055,2056,2059,2055,2058,2059,2057,2060,2057,
+    2063,2056,2064,2057,2057,2059,2060,2065,2060,2059,2066,2063,2067,2067,2061,2065,
+    2062,2069,2062,2064,2069,2069,2063,2069,2067,2068,2071,2072,2066,2067,2067,2067,
+    2068,2073,2069,2073,2068,2071,2071,2069,2070,2075,2075,2074,2075,2071,2073,2072,
+    2075,2075,2071,2074,2071,2075,2076,2075,2076,2074,2074,2077,2074,2077,2073,2072,
+    2073,2073,2076,2074,2070,2071,2076,2071,2076,2069,2069,2069,2075,2069,2076,2075,
+    2069,2073,2072,2074,2071,2071,2073,2072,2075,2076,2075,2069,2068,2073,2067,2069,
+    2070,2073,2074,2070,2069,2069,2066,2069,2065,2072,2065,2072,2066,2066,2069,2071,
+    2067,2063,2068,2067,2064,2066,2064,2063,2067,2062,2067,2064,2067,2066,2066,2067,
+    2065,2062,2059,2065,2064,2064,2061,2064,2056,2061,2060,2060,2058,2061,2061,2056,
+    2054,2059,2055,2052,2057,2059,2052,2056,2058,2054,2054,2055,2049,2054,2055,2055,
+    2050,2050,2052,2046,2053,2052,2049,2051,2046,2050,2046,2045,2044,2045,2047,2042,
+    2046,2045,2043,2041,2044,2043,2045,2045,2039,2042,2043,2038,2040,2042,2044,2038,
+    2041,2035,2036,2036,2033,2037,2038,2037,2035,2037,2039,2038,2038,2032,2037,2035,
+    2033,2032,2032,2036,2029,2036,2031,2029,2029,2030,2031,2028,2027,2027,2031,2028,
+    2029,2026,2030,2025,2029,2031,2024,2023,2024,2027,2022,2028,2024,2022,2028,2029,
+    2029,2026,2029,2027,2024,2023,2028,2028,2021,2024,2026,2026,2023,2021,2026,2025,
+    2025,2026,2021,2019,2024,2026,2019,2019,2021,2025,2026,2022,2021,2022,2025,2024,
+    2022,2019,2022,2020,2026,2027,2026,2026,2020,2028,2028,2022,2021,2020,2020,2025,
+    2026,2020,2021,2023,2028,2024,2028,2026,2021,2026,2028,2026,2025,2027,2022,2028,
+    2027,2024,2024,2032,2028,2030,2024,2032,2030,2027,2033,2026,2028,2034,2029,2030,
+    2028,2034,2031,2034,2031,2032,2032,2030,2037,2030,2033,2030,2034,2031,2033,2039,
+    2038,2038,2039,2035,2036,2038,2035,2034,2043,2036,2040,2040,2037,2039,2044,2045,
+    2039,2043,2047,2046,2044,2041,2045,2041,2048,2046,2046,2045,2044,2046,2051,2048,
+    2044,2045,2046,2053,2047,2051,2050,2052,2047,2051,2052,2056,2055,2054,2054,2057,
+    2050,2059,2057,2052,2053,2052,2056,2057,2053,2055,2059,2059,2059,2060,2060,2057,
+    2063,2056,2063,2065,2062,2065,2066,2062,2066,2063,2060,2063,2068,2067,2068,2062,
+    2065,2063,2066,2068,2063,2064,2064,2063,2064,2072,2070,2068,2071,2067,2065,2068,
+    2071,2072,2071,2071,2074,2071,2071,2073,2067,2068,2072,2071,2068,2068,2074,2071,
+    2075,2069,2075,2069,2076,2070,2076,2068,2077,2070,2075,2075,2072,2077,2072,2070,
+    2074,2077,2074,2076,2077,2074,2075,2077,2071,2076,2069,2075,2073,2072,2075,2076,
+    2070,2076,2073,2069,2071,2069,2076,2076,2075,2073,2074,2072,2072,2070,2069,2071,
+    2075,2072,2066,2072,2069,2070,2072,2068,2073,2066,2069,2067,2071,2071,2068,2065,
+    2068,2063,2067,2068,2065,2066,2067,2064,2063,2065,2066,2061,2064,2060,2065,2065,
+    2062,2065,2063,2065,2061,2058,2065,2063,2059,2062,2063,2055,2060,2054,2058,2058,
+    2060,2061,2058,2060,2056,2051,2055,2053,2053,2056,2056,2049,2056,2050,2048,2052,
+    2047,2051,2054,2049,2054,2053,2046,2047,2050,2050,2046,2048,2049,2046,2044,2048,
+    2048,2047,2048,2043,2043,2043,2039,2043,2039,2040,2040,2043,2039,2044,2039,2038,
+    2036,2041,2042,2037,2038,2036,2038,2033,2039,2040,2036,2033,2034,2035,2036,2036,
+    2036,2030,2034,2032,2032,2033,2035,2033,2032,2029,2026,2030,2033,2031,2033,2030,
+    2030,2028,2028,2029,2032,2029,2024,2028,2027,2028,2024,2029,2022,2030,2027,2027,
+    2025,2022,2026,2022,2029,2028,2020,2021,2023,2023,2028,2021,2023,2020,2022,2021,
+    2020,2024,2025,2022,2021,2021,2026,2020,2023,2019,2022,2022,2023,2021,2020,2021,
+    2026,2020,2025,2023,2026,2026,2020,2024,2027,2024,2020,2022,2026,2024,2028,2024,
+    2026,2021,2025,2021,2029,2023,2023,2029,2024,2029,2026,2024,2022,2027,2023,2029,
+    2023,2025,2029,2030,2032,2025,2025,2024,2033,2029,2032,2028,2030,2033,2029,2029,
+    2032,2034,2031,2031,2028,2034,2032,2029,2030,2031,2036,2036,2033,2037,2037,2035,
+    2033,2037,2039,2035,2033,2038,2036,2039,2040,2036,2036,2036,2036,2040,2039,2041,
+    2046,2041,2043,2039,2043,2047,2046,2043,2043,2043,2042,2046,2049,2044,2044,2049,
+    2050,2049,2053,2045,2054,2046,2049,2054,2054,2050,2052,2053,2056,2056,2054,2050,
+    2053,2052,2053,2052,2060,2058,2060,2060,2059,2057,2062,2057,2055,2063,2063,2056,
+    2060,2056,2060,2063,2063,2062,2066,2059,2065,2065,2062,2061,2066,2064,2069,2062,
+    2066,2064,2070,2070,2062,2070,2068,2071,2065,2072,2067,2069,2069,2069,2068,2071,
+    2072,2068,2069,2072,2074,2067,2067,2071,2067,2075,2070,2069,2067,2073,2073,2073,
+    2074,2075,2071,2069,2071,2069,2068,2073,2076,2069,2076,2071,2071,2076,2069,2074,
+    2069,2072,2071,2070,2074,2074,2073,2077,2072,2076,2069,2072,2073,2069,2072,2077,
+    2071,2075,2068,2070,2076,2069,2074,2069,2074,2074,2072,2069,2070,2068,2070,2067,
+    2070,2068,2070,2072,2073,2074,2069,2072,2067,2065,2067,2068,2070,2072,2068,2064,
+    2071,2063,2071,2065,2063,2065,2063,2068,2065,2063,2063,2067,2063,2063,2060,2066,
+    2065,2066,2064,2059,2058,2064,2062,2059,2056,2056,2062,2061,2056,2058,2057,2056,
+    2053,2061,2058,2057,2059,2055,2059,2053,2052,2056,2053,2053,2053,2055,2051,2051,
+    2055,2050,2051,2053,2050,2047,2049,2047,2050,2048,2048,2046,2045,2042,2043,2049,
+    2048,2048,2043,2043,2047,2039,2039,2041,2041,2038,2038,2045,2042,2038,2042,2035,
+    2041,2039,2040,2037,2033,2040,2036,2040,2037,2040,2036,2032,2034,2030,2032,2035,
+    2032,2033,2029,2029,2028,2030,2027,2027,2030,2032,2032,2034,2034,2026,2027,2031,
+    2029,2026,2025,2031,2028,2028,2029,2024,2025,2023,2030,2027,2027,2027,2027,2022,
+    2028,2022,2028,2028,2026,2022,2028,2024,2023,2021,2025,2028,2028,2026,2028,2020,
+    2025,2024,2024,2022,2026,2024,2024,2021,2023,2019,2026,2027,2022,2027,2020,2023,
+    2026,2026,2026,2023,2020,2025,2026,2023,2026,2026,2023,2026,2020,2026,2021,2026,
+    2025,2022,2022,2024,2022,2023,2022,2029,2029,2028,2029,2022,2029,2024,2024,2023,
+    2031,2027,2027,2027,2031,2031,2032,2026,2027,2026,2027,2031,2027,2031,2026,2030,
+    2028,2028,2029,2033,2030,2036,2033,2036,2035,2031,2038,2035,2034,2036,2034,2035,
+    2037,2039,2035,2040,2037,2036,2036,2036,2043,2041,2040,2042,2043,2040,2037,2040,
+    2039,2046,2046,2045,2047,2043,2048,2041,2043,2049,2049,2043,2047,2045,2048,2051,
+    2046,2048,2051,2052,2049,2054,2047,2048,2047,2054,2051,2051,2057,2055,2053,2057,
+    2054,2054,2051,2059,2057,2059,2059,2054,2059,2058,2054,2060,2060,2056,2062,2061,
+    2056,2060,2058,2057,2064,2065,2059,2062,2063,2064,2060,2066,2066,2066,2061,2064,
+    2068,2064,2067,2064,2069,2064,2068,2064,2070,2065,2068,2072,2069,2068,2066,2071,
+    2073,2068,2071,2073,2072,2069,2071,2073,2069,2074,2072,2070,2071,2074,2070,2073,
+    2070,2070,2074,2072,2074,2076,2074,2075,2072,2069,2073,2075,2073,2069,2075,2076,
+    2075,2076,2075,2069,2071,2076,2070,2077,2076,2071,2076,2073,2073,2071,2077,2074,
+    2071,2069,2070,2076,2073,2073,2076,2069,2076,2072,2071,2067,2069,2069,2067,2067,
+    2068,2069,2071,2074,2066,2071,2070,2073,2072,2072,2065,2068,2069,2067,2071,2069,
+    2063,2066,2070,2062,2063,2065,2069,2064,2061,2069,2068,2068,2061,2064,2060,2062,
+    2066,2066,2064,2065,2062,2060,2060,2063,2063,2064,2060,2056,2061,2054,2054,2062,
+    2057,2057,2053,2056,2055,2059,2054,2055,2050,2053,2057,2052,2050,2050,2055,2055,
+    2055,2054,2053,2054,2050,2053,2051,2044,2949,2048,2047,2043,2044,2048,2045,2042,
+    2043,2042,2040,2040,2044,2044,2043,2040,2046,2037,2044,2040,2037,2036,2041,2041,
+    2043,2039,2037,2037,2034,2040,2036,2036,2037,2034,2036,2033,2031,2033,2030,2032,
+    2030,2029,2035,2036,2033,2036,2028,2030,2034,2028,2026,2028,2031,2034,2032,2027,
+    2030,2031,2027,2029,2028,2031,2028,2031,2027,2028,2022,2022,2024,2024,2024,2023,
+    2026,2025,2029,2024,2025,2029,2023,2028,2023,2028,2023,2028,2023,2025,2025,2023,
+    2019,2019,2023,2020,2023,2022,2021,2023,2020,2022,2026,2019,2021,2020,2021,2020,
+    2027,2019,2019,2027,2023,2020,2023,2027,2021,2021,2026,2027,2024,2028,2025,2027,
+    2020,2026,2026,2024,2029,2029,2028,2025,2022,2022,2026,2028,2029,2026,2027,2023,
+    2025,2023,2024,2025,2028,2031,2030,2025,2025,2025,2028,2030,2030,2031,2033,2034,
+    2028,2029,2028,2036,2035,2031,2034,2030,2036,2038,2037,2031,2031,2039,2036,2032,
+    2037,2039,2040,2035,2038,2036,2037,2042,2037,2041,2037,2042,2037,2042,2039,2041,
+    2043,2046,2046,2041,2042,2045,2048,2046,2045,2041,2049,2043,2045,2049,2051,2047,
+    2052,2044,2046,2047,2047,2049,2046,2049,2054,2048,2051,2051,2053,2052,2050,2055,
+    2050,2053,2053,2058,2052,2057,2055,2060,2055,2058,2058,2059,2061,2058,2057,2057,
+    2064,2063,2058,2064,2057,2065,2061,2059,2067,2059,2061,2067,2061,2067,2067,2067,
+    2063,2065,2066,2067,2070,2066,2069,2071,2064,2071,2070,2068,2065,2067,2067,2071,
+    2066,2070,2066,2067,2068,2069,2073,2074,2070,2072,2070,2068,2075,2069,2068,2076,
+    2072,2076,2076,2071,2069,2076,2072,2069,2069,2072,2070,2077,2072,2070,2076,2074,
+    2076,2074,2075,2072,2072,2073,2071,2069,2069,2073,2069,2073,2069,2075,2075,2072,
+    2071,2075,2070,2072,2073,2075,2071,2071,2071,2073,2074,2074,2075,2075,2075,2073,
+    2069,2067,2072,2069,2067,2073,2071,2069,2067,2073,2065,2067,2071,2067,2065,2068,
+    2068,2067,2071,2063,2063,2070,2067,2063,2067,2069,2069,2064,2062,2061,2065,2060,
+    2065,2060,2062,2064,2064,2064,2063,2064,2061,2060,2063,2063,2058,2055,2054,2062,
+    2058,2053,2059,2052,2052,2054,2059,2059,2054,2055,2049,2050,2056,2056,2050,2048,
+    2055,2049,2050,2050,2052,2047,2050,2051,2047,2045,2046,2047,2049,2044,2043,2046,
+    2041,2046,2046,2041,2039,2043,2043,2043,2045,2044,2045,2043,2041,2042,2043,2041,
+    2041,2037,2035,2041,2040,2036,2038,2033,2036,2035,2034,2036,2037,2035,2038,2035,
+    2035,2034,2030,2034,2029,2030,2032,2035,2032,2035,2026,2033,2031,2029,2030,2026,
+    2030,2031,2027,2025,2025,2031,2028,2031,2024,2024,2022,2029,2029,2022,2028,2022,
+    2028,2028,2027,2024,2025,2023,2023,2025,2028,2021,2024,2027,2024,2025,2021,2020,
+    2021,2021,2026,2020,2023,2026,2021,2025,2027,2022,2019,2023,2023,2024,2019,2024,
+    2022,2023,2027,2022,2020,2022,2021,2024,2022,2026,2025,2026,2022,2021,2020,2026,
+    2027,2022,2023,2027,2026,2022,2028,2028,2025,2024,2029,2024,2024,2023,2025,2029,
+    2029,2029,2025,2032,2024,2024,2029,2032,2030,2032,2031,2030,2026,2031,2032,2029,
+    2031,2030,2027,2036,2032,2035,2036,2032,2033,2037,2034,2038,2033,2035,2035,2039,
+    2039,2036,2040,2036,2036,2042,2035,2034,2042,2040,2040,2038,2039,2041,2037,2040,
+    2039,2038,2039,2039,2039,2044,2048,2046,2049,2046,2047,2049,2046,2048,2050,2051,
+    2052,2049,2046,2048,2047,2050,2050,2051,2051,2048,2054,2053,2053,2052,2055,2057,
+    2056,2051,2052,2055,2052,2052,2058,2061,2056,2054,2056,2054,2061,2057,2062,2056,
+    2057,2057,2061,2064,2058,2063,2060,2059,2064,2061,2066,2063,2063,2068,2066,2066,
+    2068,2063,2070,2064,2068,2063,2071,2067,2067,2071,2066,2068,2071,2065,2071,2065,
+    2072,2065,2070,2067,2066,2068,2070,2067,2067,2070,2073,2067,2074,2071,2074,2075,
+    2076,2074,2072,2070,2073,2075,2075,2075,2071,2073,2076,2073,2070,2077,2071,2077,
+    2075,2072,2077,2069,2073,2073,2076,2074,2074,2071,2073,2071,2075,2074,2071,2069,
+    2074,2069,2073,2072,2073,2071,2076,2070,2071,2072,2069,2070,2069,2073,2075,2072,
+    2072,2071,2068,2071,2071,2069,2072,2073,2065,2073,2072,2072,2068,2069,2067,2072,
+    2070,2069,2066,2066,2064,2070,2067,2064,2064,2064,2067,2060,2063,2065,2063,2060,
+    2061,2065,2062,2059,2064,2062,2064,2064,2061,2060,2057,2062,2061,2056,2055,2056,
+    2060,2059,2059,2059,2059,2059,2058,2059,2056,2053,2055,2050,2054,2053,2054,2050,
+    2048,2054,2051,2046,2046,2046,2050,2049,2050,2050,2047,2048,2045,2045,2043,2042,
+    2045,2043,2042,2042,2044,2039,2039,2046,2041,2045,2043,2039,2041,2037,2041,2041,
+    2038,2037,2037,2035,2034,2041,2036,2039,2036,2036,2032,2036,2039,2038,2036,2038,
+    2031,2031,2037,2029,2033,2034,2031,2032,2034,2032,2028,2029,2030,2028,2025,2026,
+    2028,2025,2025,2026,2031,2031,2027,2024,2031,2029,2026,2026,2030,2029,2026,2024,
+    2029,2022,2025,2023,2028,2027,2025,2024,2026,2026,2021,2021,2026,2028,2022,2027,
+    2027,2027,2027,2023,2027,2022,2021,2020,2027,2020,2020,2021,2023,2023,2026,2023,
+    2019,2025,2019,2024,2027,2022,2019,2021,2025,2022,2028,2024,2028,2028,2023,2021,
+    2027,2021,2022,2023,2025,2026,2027,2025,2022,2027,2025,2022,2030,2023,2030,2023,
+    2029,2027,2027,2028,2026,2027,2027,2030,2030,2033,2031,2028,2026,2032,2030,2033,
+    2027,2033,2029,2030,2028,2029,2030,2031,2037,2038,2031,2031,2032,2031,2034,2039,
+    2032,2035,2034,2034,2040,2034,2037,2034,2042,2040,2038,2042,2041,2044,2040,2039,
+    2045,2040,2044,2047,2044,2045,2044,2045,2049,2047,2042,2046,2042,2045,2051,2047,
+};
@@ -0,0 +1,96 @@
+/*********************************************************************************************************
+ * SampleReplay - a recorded sample stream played back in place of the ADC, for regression runs
+ *
+ * Description:
+ *   Has the same interface as AdcSampler, so the acquisition task reads a recording (e.g. made with
+ *   tools/stream_reader.py and embedded with tools/embed_recording.py) exactly as it would read the DMA
+ *   ring, and everything downstream (filters, calibration, trigger, statistics, spectrum, display) runs
+ *   unchanged. The samples come out at the rate they were recorded at, measured from the time begin()
+ *   was called, in whole blocks of ADC_BLOCK_SAMPLES (rounded down to whole sweeps): the filters are fed
+ *   the same samples in the same blocks on every run, whatever the task timing.
+ *
+ *   The recording plays in a loop. The acquisition task folds what the pipeline made of each block into
+ *   a digest with record(), together with how long it took, and at the end of every pass through the
+ *   recording the digest and the processing time are queued as a ReplayPass (see tools/replay_check.py,
+ *   which compares them with a saved baseline to catch functional and performance regressions).
+ *
+ * Notes:
+ *   - If the pipeline falls behind, the recording is not skipped like an overrun of the ADC would: it
+ *     plays on late (the digest stays the same) and overrunCount() counts the blocks it fell behind by.
+ *   - The first pass starts from the filters as they were at boot, so its digest differs from the ones
+ *     after it, which all start where the recording ends.
+ *   - end() pauses the playback and begin() carries on from the same sample (e.g. in low-power mode).
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <driver/adc.h>
+#include "AdcSampler.h"
+#include "SpscQueue.h"
+
+#define REPLAY_PASS_QUEUE 4 // passes waiting to be reported
+
+struct ReplayPass {
+  uint32_t number;       // 1 for the first pass
+  uint32_t samples;      // samples in the pass (every channel)
+  uint32_t digest;       // CRC32 of the values recorded during the pass
+  float meanBlockUs;     // time to process a block
+  uint32_t maxBlockUs;
+  uint32_t overruns;     // blocks the playback fell behind by, during the pass
+};
+
+class SampleReplay {
+public:
+  // The recording: 'count' samples of 'channels' interleaved channels, taken at 'sampleRateHz' (conversions per
+  // second across all channels, like AdcSampler). Call once, before begin().
+  void load(const uint16_t *samples, uint32_t count, uint8_t channels, uint32_t sampleRateHz);
+
+  // Start (or carry on) playing. The channel list is only checked against the recording, and the rate is the
+  // recorded one. Returns false if the recording doesn't have 'count' channels.
+  bool begin(const adc1_channel_t *channels, uint8_t count, uint32_t sampleRateHz = ADC_SAMPLE_RATE_HZ);
+
+  // Pause the playback
+  void end();
+
+  // Copy the next block of samples into 'samples' once it is due, waiting at most 'timeoutMs' for it. Returns
+  // the number of samples written (one whole block, or 0).
+  size_t readBlock(uint16_t *samples, size_t maxSamples, uint32_t timeoutMs);
+
+  // Acquisition side, after each block: fold the pipeline's results for it into the digest of the pass, with the
+  // time it took to process the block
+  void record(const void *values, size_t bytes, uint32_t processUs);
+
+  // Reporting side: the next finished pass, false if there is none
+  bool nextPass(ReplayPass &pass) { return passes.pop(pass); }
+
+  bool running() const { return isRunning; }
+  uint32_t sampleRate() const { return rateHz; }
+  uint8_t channelCount() const { return numChannels; }
+  uint32_t sampleCount() const { return length; }
+  uint32_t overrunCount() const { return overruns; }
+
+private:
+  const uint16_t *recording = nullptr;
+  uint32_t length = 0;    // samples played per pass (whole blocks)
+  uint32_t blockSize = 0; // samples per block (whole sweeps)
+  uint8_t numChannels = 0;
+  uint32_t rateHz = 0;
+  bool isRunning = false;
+
+  uint32_t position = 0;  // next sample to play
+  uint64_t credit = 0;    // samples due but not yet played, times 1e6
+  uint32_t lastUs = 0;
+  uint32_t overruns = 0;
+
+  // The pass being played
+  bool passEnded = false;
+  uint32_t passNumber = 0;
+  uint32_t digest = 0;
+  uint64_t totalUs = 0;
+  uint32_t blocks = 0;
+  uint32_t maxUs = 0;
+  uint32_t passStartOverruns = 0;
+
+  SpscQueue<ReplayPass, REPLAY_PASS_QUEUE> passes;
+};
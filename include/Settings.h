@@ -0,0 +1,116 @@
+/*********************************************************************************************************
+ * Settings - tuning parameters kept in NVS and changeable over serial without reflashing
+ *
+ * Description:
+ *   The loop period, filter, deadband, trigger, display refresh, telemetry cadence, the zero-field output
+ *   of each sensor and the meter zones live in
+ *   one packed Settings struct. At boot it is loaded from NVS (or from the compiled-in defaults if nothing
+ *   valid is stored), and after that the tasks read its fields directly through current(): no lock, no
+ *   lookup.
+ *
+ *   A change is made to a copy of the struct, checked against the limits of every field, saved to NVS
+ *   and then swapped in with a single atomic pointer store, so a reader always sees either the old or
+ *   the new settings in full, never a mix. generation() counts the swaps, so a task can tell cheaply
+ *   when it needs to apply new settings (e.g. reconfigure its filters).
+ *
+ *   There are three copies of the struct. The reading task calls acknowledge() once per pass, when it
+ *   holds no reference to the settings, and a copy swapped out is only written again once the swap that
+ *   retired it has been acknowledged. With two changes in one pass of the reader neither spare copy is
+ *   free yet: the change is then kept pending (set() still returns at once, nothing waits) and swapped
+ *   in by applyPending() on a later pass of the setting task.
+ *
+ * Notes:
+ *   - Readers take current() once per pass and must not keep the reference across acknowledge(). The
+ *     setting task's own reference stays good until its next change is swapped in.
+ *   - The string lookups (set(), print()) are for the serial console and the config view only, never the
+ *     hot path.
+ *   - Only one task may call set() and restoreDefaults().
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#define SETTINGS_VERSION 3     // bump when the layout of Settings changes (the stored copy is then ignored)
+#define SETTINGS_SLOTS 3       // copies of the struct: the one in force, and two that may still be being read
+#define SETTING_BOXCAR_MAX 128 // most decimated results in the moving average (the filters' capacity)
+#define SETTING_ZERO_CHANNELS 4 // sensors with a zero-field output of their own
+
+struct __attribute__((packed)) Settings {
+  uint16_t loopPeriodMs;       // how often the acquisition task publishes a reading
+  uint8_t filterType;          // FILTER_NONE, FILTER_BOXCAR or FILTER_IIR
+  uint16_t boxcarLength;       // decimated results in the moving average
+  uint8_t iirShift;            // IIR weight of each new result is 1/2^shift
+  uint8_t spikeRejection;      // median-of-5 spike rejector on (1) or off (0)
+  uint16_t deadband;           // readings at or below this (12-bit counts) are shown as 0
+  uint16_t triggerLevel;       // raw ADC counts
+  uint16_t triggerHysteresis;  // counts
+  uint16_t displayMinPeriodMs; // fastest frame period
+  uint16_t displayMaxPeriodMs; // slowest frame period while the needle is steady
+  uint16_t telemetryPeriodMs;  // readings batched into each telemetry frame
+  uint16_t zeroDeciMv[SETTING_ZERO_CHANNELS]; // zero-field output of each sensor, tenths of a mV (captured with 'z')
+  uint8_t redStart, redEnd;    // meter zones, 0-100 along the scale
+  uint8_t orangeStart, orangeEnd;
+  uint8_t yellowStart, yellowEnd;
+  uint8_t greenStart, greenEnd;
+};
+
+class SettingsStore {
+public:
+  // Load the stored settings, or use 'defaults' if there are none (or they don't pass the checks).
+  // Returns true if they came from NVS.
+  bool begin(const Settings &defaults);
+
+  // The settings in force
+  const Settings &current() const { return *active.load(std::memory_order_acquire); }
+
+  // Number of changes since begin()
+  uint32_t generation() const { return changes.load(std::memory_order_acquire); }
+
+  // Reading task, once per pass: no reference to the settings is held from before this call
+  void acknowledge() { acknowledged.store(changes.load(std::memory_order_acquire), std::memory_order_release); }
+
+  // Setting task, once per pass: swap in a change that was kept pending (true if one was)
+  bool applyPending();
+
+  // Change one field by name, returns nullptr on success or why the change was refused
+  const char *set(const char *name, long value);
+
+  // Go back to the compiled-in defaults (and forget the stored copy)
+  const char *restoreDefaults();
+
+  // List every field with its value and limits
+  void print(Print &out) const;
+
+  // The fields by index, for a menu on the display (an index past the end gives nullptr / 0)
+  uint8_t fieldCount() const;
+  const char *fieldName(uint8_t index) const;
+  uint32_t fieldValue(uint8_t index) const;
+  void fieldLimits(uint8_t index, uint16_t &min, uint16_t &max) const;
+
+private:
+  struct Field {
+    const char *name;
+    uint16_t offset;
+    uint8_t size;
+    uint16_t min;
+    uint16_t max;
+  };
+
+  static const Field fields[];
+  static uint32_t read(const Settings &settings, const Field &field);
+  static void write(Settings &settings, const Field &field, uint32_t value);
+  static const char *check(const Settings &settings);
+
+  const char *publish(const Settings &next, bool store);
+
+  Settings defaultSettings = {};
+  Settings slots[SETTINGS_SLOTS] = {};
+  uint32_t retiredAt[SETTINGS_SLOTS] = {}; // the generation that swapped each copy out
+  std::atomic<Settings *> active{&slots[0]};
+  std::atomic<uint32_t> changes{0};
+  std::atomic<uint32_t> acknowledged{0};   // the newest generation the reader has passed
+  Settings pending = {};
+  bool isPending = false;
+};
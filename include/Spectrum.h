@@ -0,0 +1,83 @@
+/*********************************************************************************************************
+ * Spectrum - frequency analysis of the raw samples for AC (periodic) magnetic fields
+ *
+ * Description:
+ *   Near motors and transformers the field alternates, and the moving average of the needle just shows
+ *   its DC level. SpectrumAnalyzer runs a real FFT over the raw samples of one channel instead and finds
+ *   the dominant frequency and its amplitude.
+ *
+ *   The raw samples are first summed SPECTRUM_DECIMATION at a time (a boxcar anti-alias filter, exact in
+ *   integers) into a ring holding the last SPECTRUM_SIZE results; the running sum of the ring gives the DC
+ *   level without a pass over it. Only the SPECTRUM_HOP newest results change between two windows, so
+ *   the windows overlap by SPECTRUM_SIZE - SPECTRUM_HOP and one spectrum comes out every hop (~39 per
+ *   second with the defaults, at 4.9 Hz resolution up to 2.5 kHz).
+ *
+ *   Each spectrum is a Hann-windowed real FFT done as a half-size complex FFT (ESP-DSP's radix-2 FFT,
+ *   which uses the ESP32-S3's SIMD instructions) followed by the usual split of the even and odd halves.
+ *   The peak frequency is interpolated between bins, and its amplitude is taken from the energy of the
+ *   bins around the peak, so it doesn't depend on where the frequency falls between two bins.
+ *
+ *   A finished spectrum (the peak and the strongest bin under each of SPECTRUM_BARS display bars) is handed
+ *   to the reader through a lock-free queue, like the statistics snapshots.
+ *
+ * Notes:
+ *   - Amplitudes are the peak (not RMS) in raw counts of the sinusoid, from 0 Hz up to half the rate of
+ *     the decimated samples. The decimation sum rolls off towards the top (-0.5 dB at 1 kHz, -2.3 dB at
+ *     2 kHz with the defaults).
+ *   - begin() and feed() belong to the acquisition task, latest() to one reader task. If the reader falls
+ *     behind, the FFTs are skipped rather than queued.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "SpscQueue.h"
+
+#define SPECTRUM_SIZE 1024      // samples per FFT window (power of two)
+#define SPECTRUM_HOP 128        // new samples between two windows (the rest overlaps the last window)
+#define SPECTRUM_DECIMATION 4   // raw samples summed into each FFT sample (20kS/s -> 5kS/s)
+#define SPECTRUM_BARS 64        // bars on the display, sharing the bins out evenly
+#define SPECTRUM_QUEUE 4        // spectra buffered for the reader
+
+struct SpectrumFrame {
+  float binHz;                  // width of one FFT bin
+  float peakHz;                 // dominant frequency (0 if there is no AC component)
+  float peakAmplitude;          // its amplitude in raw counts
+  float mean;                   // DC level of the window in raw counts
+  float bars[SPECTRUM_BARS];    // amplitude of the strongest bin under each bar, in raw counts
+};
+
+class SpectrumAnalyzer {
+public:
+  // Start again with an empty window, 'samplesPerSecond' is the rate of the channel being fed
+  bool begin(uint32_t samplesPerSecond);
+
+  // Add every 'stride'-th sample of a block (one channel of an interleaved block)
+  void feed(const uint16_t *samples, size_t count, size_t stride = 1);
+
+  // Newest spectrum, returns false if there is nothing new since the last call
+  bool latest(SpectrumFrame &frame) { return frames.popLatest(frame); }
+
+  // Frequency covered by each display bar
+  float barHz() const { return binHz * (SPECTRUM_SIZE / 2 / SPECTRUM_BARS); }
+
+private:
+  void analyze(SpectrumFrame &frame);
+
+  // Decimated samples (sums of SPECTRUM_DECIMATION raw counts), oldest at 'head'
+  uint32_t ring[SPECTRUM_SIZE];
+  uint32_t head = 0;
+  uint32_t filled = 0;
+  uint32_t fresh = 0; // new samples since the last FFT
+  uint64_t ringSum = 0;
+  uint32_t partialSum = 0;
+  uint8_t partialCount = 0;
+
+  float binHz = 0;
+  alignas(16) float window[SPECTRUM_SIZE];
+  alignas(16) float data[SPECTRUM_SIZE];  // the windowed samples, treated as SPECTRUM_SIZE / 2 complex values
+  float twiddle[SPECTRUM_SIZE];           // cos, sin of 2 pi k / SPECTRUM_SIZE for the real FFT split
+  float power[SPECTRUM_SIZE / 2];         // |X[k]|^2 of each bin
+
+  SpscQueue<SpectrumFrame, SPECTRUM_QUEUE> frames;
+};
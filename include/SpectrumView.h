@@ -0,0 +1,60 @@
+/*********************************************************************************************************
+ * SpectrumView - bar spectrum of the field with the dominant frequency and its amplitude
+ *
+ * Description:
+ *   Shows a SpectrumFrame in the area of the meter: a caption line (set by the caller, e.g. the peak
+ *   frequency and amplitude), SPECTRUM_BARS vertical bars on a logarithmic (dB) amplitude scale, and the
+ *   frequency axis underneath. Like BarMeter only the part of a bar that changed height is redrawn (the
+ *   whole bar when the peak moves to or from it, as it is drawn in a different colour), so a new spectrum
+ *   costs a few small rectangles and the display keeps up with 20+ spectra per second.
+ *
+ *   The axis and its labels never change, so they are drawn by drawBackground() on whatever canvas it is
+ *   given (e.g. a ViewLayers sprite), and reset() makes the next update() draw every bar and the caption.
+ *
+ * Notes:
+ *   - Anything drawing with DMA (e.g. SpriteMeter) must have finished before update().
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "Spectrum.h"
+
+#define SPECTRUM_BAR_COLOR TFT_CYAN
+#define SPECTRUM_PEAK_COLOR TFT_RED
+#define SPECTRUM_FLOOR_DB -10.0f // amplitude at the bottom of the bars (dB relative to 1 raw count)
+#define SPECTRUM_TOP_DB 60.0f    // amplitude at the top
+
+class SpectrumView {
+public:
+  explicit SpectrumView(TFT_eSPI *tft);
+
+  // Lay out the view in an area of the panel, for bars 'barHz' wide (nothing is drawn)
+  void begin(int32_t x, int32_t y, int16_t w, int16_t h, float barHz);
+
+  // Draw the frequency axis on 'canvas', whose top left corner is at ('originX', 'originY') on the panel
+  void drawBackground(TFT_eSPI &canvas, int32_t originX, int32_t originY) const;
+
+  // The background was just put up again: the bars are empty and there is no caption
+  void reset();
+
+  // Show a spectrum, with 'caption' above it (only what changed is redrawn)
+  void update(const SpectrumFrame &frame, const char *caption);
+
+private:
+  int16_t heightOf(float amplitude) const;
+  void drawBar(int bar, int16_t height, uint16_t color);
+
+  TFT_eSPI *display;
+  int32_t areaX = 0;
+  int32_t areaY = 0;
+  int16_t width = 0;
+  int32_t barsTop = 0;
+  int16_t barsHeight = 0;
+  int16_t pitch = 1;    // pixels per bar, including the gap
+  float hzPerBar = 1;
+
+  int16_t shownHeight[SPECTRUM_BARS] = {};
+  int shownPeakBar = -1;
+  char shownCaption[48] = "";
+};
@@ -0,0 +1,123 @@
+/*********************************************************************************************************
+ * SpriteMeter - analog meter composed off-screen, sending only the pixels that changed with DMA
+ *
+ * Description:
+ *   The meter is drawn into a canvas sprite (in PSRAM when available) that always holds exactly what is
+ *   on the panel, next to a clean copy of the face without the needle, markers or readout. When the
+ *   needle moves, only the union bounding box of the old and the new needle is touched: those pixels are
+ *   copied back from the clean face, the markers and an anti-aliased needle are drawn over them, and
+ *   just that rectangle (plus the readout cells, if the number changed) is sent to the panel in a DMA
+ *   transfer. A typical frame sends a few thousand pixels instead of the whole 239x126 meter, and the
+ *   panel only ever receives finished pixels, so there is no flicker from an erase/redraw.
+ *
+ *   The next frame is composed in the canvas while the last one is still being sent: the rectangles are
+ *   packed into a separate transfer buffer, which is only refilled once the transfer has finished.
+ *
+ * Notes:
+ *   - The needle is drawn with floating point end points (from a table built once), so it moves smoothly
+ *     instead of along the staircase of a one pixel line.
+ *   - Anything else drawing directly to the panel must call finishTransfer() first, and must not draw over
+ *     the meter (the canvas would no longer match the panel).
+ *   - The face can be saved to flash and copied back in on the next boot (see FaceCache.h), which is much
+ *     quicker than drawing it.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+#include "NeedleMeter.h"
+#include "ValueReadout.h"
+#include "FaceCache.h"
+
+// Frame size (the size of the meter outline drawn by MeterWidget::analogMeter())
+#define SPRITE_METER_WIDTH 239
+#define SPRITE_METER_HEIGHT 126
+
+class SpriteMeter {
+public:
+  explicit SpriteMeter(TFT_eSPI *tft);
+
+  // Allocate the canvas, face and transfer buffers and set up DMA, returns false if there isn't enough memory
+  bool begin(int32_t x, int32_t y);
+
+  // Same as NeedleMeter::setZones() and NeedleMeter::analogMeter() (the whole meter is sent with the next update())
+  void setZones(uint16_t rs, uint16_t re, uint16_t os, uint16_t oe, uint16_t ys, uint16_t ye, uint16_t gs, uint16_t ge);
+  void analogMeter(float fullScale, const char *units, const char *s0, const char *s1, const char *s2, const char *s3,
+                   const char *s4);
+
+  // Replace the units text in the bottom right corner of the face
+  void setUnitsLabel(const char *label);
+
+  // Save the face as drawn so far (analogMeter(), setUnitsLabel()) under 'key'
+  bool saveFace(FaceCache &cache, uint32_t key);
+
+  // Instead of drawing the face, copy the one saved under 'key' into the canvas. Returns false if there is
+  // none, in which case the face still has to be drawn.
+  bool restoreFace(FaceCache &cache, uint32_t key, float fullScale, const char *units);
+
+  // Number of digits after the decimal point in the readout (see ValueReadout::setDecimals())
+  void setReadoutDecimals(uint8_t digits);
+
+  // Peak-hold markers, shown from the next update() (see NeedleMeter::setMarkers())
+  void setMarkers(float low, float high);
+
+  // Draw the needle at 'value' and the number 'readout' in the bottom left corner, then start sending what
+  // changed (nothing is drawn or sent if neither has changed since the last frame)
+  void update(float value, int32_t readout);
+
+  // Needle position (-10 to 110) for a value
+  int position(float value) const { return meter.position(value); }
+
+  // Wait for the frame currently being sent to finish
+  void finishTransfer();
+
+  // Pixels sent to the panel since begin()
+  uint32_t pixelsSent() const { return sent; }
+
+private:
+  // Rectangle in canvas coordinates, [x0, x1) x [y0, y1)
+  struct Box {
+    int16_t x0, y0, x1, y1;
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+    bool overlaps(const Box &other) const;
+    void add(const Box &other);
+  };
+
+  // Direction of one needle position from the pivot
+  struct Direction {
+    float sine;
+    float cosine;
+    float tangent;
+  };
+
+  static void buildDirections();
+  static const Direction &directionAt(int position);
+  static Box boxAround(const float *x, const float *y, int points, float margin);
+
+  Box needleBox(int position) const;
+  Box markerBox(int position) const;
+  void drawNeedle(int position);
+  void drawMarker(int position);
+  void restoreBackground(const Box &box);
+  void send(const Box *boxes, int count);
+
+  static Direction directions[121];
+  static bool directionsReady;
+
+  TFT_eSPI *display;
+  TFT_eSprite canvas;  // exactly what the panel shows
+  NeedleMeter meter;   // draws the face into the canvas
+  ValueReadout readout;
+  uint16_t *face = nullptr;  // the face without needle, markers or readout
+  uint16_t *patch = nullptr; // the rectangles of the frame being sent, packed one after the other
+  int32_t originX = 0;
+  int32_t originY = 0;
+  bool transferPending = false;
+  bool fullFrame = true; // the panel doesn't show the canvas yet
+  uint32_t sent = 0;
+
+  int needlePosition = NEEDLE_HIDDEN;
+  int32_t lastReadout = INT32_MIN;
+  int16_t markerWanted[2] = {MARKER_NONE, MARKER_NONE};
+  int16_t markerShown[2] = {MARKER_NONE, MARKER_NONE};
+};
@@ -0,0 +1,104 @@
+/*********************************************************************************************************
+ * SpscQueue - lock-free single-producer / single-consumer queue
+ *
+ * Description:
+ *   A fixed-size ring of N items shared between exactly one producer task and one consumer task (which
+ *   may run on different cores). Neither side ever blocks or takes a lock: push() fails when the queue
+ *   is full and pop() fails when it is empty.
+ *
+ *   For large items the slots can also be used in place, without copying: the producer fills the slot
+ *   returned by claim() and then calls publish(), and the consumer reads the slot returned by front() and
+ *   then calls release().
+ *
+ * Notes:
+ *   - N must be a power of two. One slot is never used, so the queue holds at most N - 1 items.
+ *   - Only the producer may call push(), claim() and publish(), and only the consumer may call pop(),
+ *     popLatest(), front() and release().
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <stddef.h>
+
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+
+public:
+  // Producer side: add an item, returns false if the queue is full
+  bool push(const T &item) {
+    size_t h = head.load(std::memory_order_relaxed);
+    size_t next = (h + 1) & (N - 1);
+    if (next == tail.load(std::memory_order_acquire)) {
+      return false; // full
+    }
+
+    items[h] = item;
+    head.store(next, std::memory_order_release); // publish the item to the consumer
+    return true;
+  }
+
+  // Consumer side: remove the oldest item, returns false if the queue is empty
+  bool pop(T &item) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return false; // empty
+    }
+
+    item = items[t];
+    tail.store((t + 1) & (N - 1), std::memory_order_release); // hand the slot back to the producer
+    return true;
+  }
+
+  // Consumer side: skip straight to the newest item, discarding any older ones
+  bool popLatest(T &item) {
+    if (!pop(item)) {
+      return false;
+    }
+    while (pop(item)) {
+    }
+    return true;
+  }
+
+  // Producer side: the free slot the next item will go in, or nullptr if the queue is full
+  T *claim() {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (((h + 1) & (N - 1)) == tail.load(std::memory_order_acquire)) {
+      return nullptr; // full
+    }
+    return &items[h];
+  }
+
+  // Producer side: make the slot filled in after claim() visible to the consumer
+  void publish() {
+    head.store((head.load(std::memory_order_relaxed) + 1) & (N - 1), std::memory_order_release);
+  }
+
+  // Consumer side: the oldest item, left in place in the queue, or nullptr if the queue is empty
+  T *front() {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t == head.load(std::memory_order_acquire)) {
+      return nullptr; // empty
+    }
+    return &items[t];
+  }
+
+  // Consumer side: hand the slot returned by front() back to the producer
+  void release() {
+    tail.store((tail.load(std::memory_order_relaxed) + 1) & (N - 1), std::memory_order_release);
+  }
+
+  bool empty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+  }
+
+  size_t size() const {
+    return (head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire)) & (N - 1);
+  }
+
+private:
+  T items[N];
+  std::atomic<size_t> head{0}; // next slot to write (owned by the producer)
+  std::atomic<size_t> tail{0}; // next slot to read (owned by the consumer)
+};
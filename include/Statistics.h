@@ -0,0 +1,114 @@
+/*********************************************************************************************************
+ * Statistics - min, max, mean and variance of the raw samples over sliding windows
+ *
+ * Description:
+ *   Tracks the raw samples of one channel over the last 1, 10 and 60 seconds. Samples are first summed
+ *   into 10ms buckets (min, max, count, sum and sum of squares, a few operations per sample, done by the
+ *   vector kernels in BlockKernels.h when the channel's samples are contiguous). Each window
+ *   is a ring of STATS_BUCKETS bucket summaries and slides one bucket at a time:
+ *     - 1s window:  buckets of 10ms
+ *     - 10s window: buckets of 100ms (10 of the 10ms buckets merged)
+ *     - 60s window: buckets of 600ms (6 of the 100ms buckets merged)
+ *   The sums are exact integers, so the oldest bucket's sums can simply be subtracted when it leaves the
+ *   window (a running Welford mean can't un-add samples). min and max come from monotonic deques, so
+ *   every update is constant time however long the window is.
+ *
+ *   After every 10ms bucket a snapshot of all three windows is handed to the reader through a lock-free
+ *   queue, so the display task never reads the windows while they are being updated.
+ *
+ * Notes:
+ *   - A window slides in whole buckets, so it lags the newest samples by up to one bucket (10ms, 100ms
+ *     and 600ms). Until a window has filled it covers the samples seen so far.
+ *   - feed(), begin() and summarize() belong to the acquisition task, latest() to one reader task.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "SpscQueue.h"
+
+#define STATS_BUCKETS 100       // bucket summaries per window
+#define STATS_BUCKET_MS 10      // length of the shortest bucket
+#define STATS_SNAPSHOT_QUEUE 16 // snapshots buffered for the reader (one per 10ms bucket)
+
+enum StatsWindow : uint8_t {
+  STATS_1S,
+  STATS_10S,
+  STATS_60S,
+  STATS_WINDOW_COUNT,
+};
+
+// Summary of the samples in one window, in raw ADC counts
+struct StatsSummary {
+  uint16_t min;
+  uint16_t max;
+  float mean;
+  float variance;
+  uint32_t count; // samples covered (0 until the first bucket is complete)
+};
+
+struct StatsSnapshot {
+  StatsSummary window[STATS_WINDOW_COUNT];
+};
+
+class SampleStatistics {
+public:
+  // Start again with empty windows, 'samplesPerSecond' is the rate of the channel being fed
+  void begin(uint32_t samplesPerSecond);
+
+  // Add every 'stride'-th sample of a block (one channel of an interleaved block)
+  void feed(const uint16_t *samples, size_t count, size_t stride = 1);
+
+  // Newest snapshot of all the windows, returns false if there is nothing new since the last call
+  bool latest(StatsSnapshot &snapshot) { return snapshots.popLatest(snapshot); }
+
+  // Summary of all the windows as they are now (only from the task that calls feed(), e.g. for telemetry)
+  void summarize(StatsSnapshot &snapshot) const;
+
+private:
+  struct Bucket {
+    uint16_t min;
+    uint16_t max;
+    uint32_t count;
+    uint64_t sum;
+    uint64_t sumSquares;
+  };
+
+  // Window over the last STATS_BUCKETS buckets
+  class Window {
+  public:
+    void reset();
+    void add(const Bucket &bucket);
+    StatsSummary summary() const;
+
+  private:
+    const Bucket &bucketAt(uint32_t sequence) const { return ring[sequence % STATS_BUCKETS]; }
+
+    Bucket ring[STATS_BUCKETS];
+    uint32_t added = 0; // sequence number of the next bucket
+    uint32_t count = 0;
+    uint64_t sum = 0;
+    uint64_t sumSquares = 0;
+
+    // Sequence numbers of the buckets that can still become the min (or max) of the window, oldest first.
+    // The values along each deque only ever rise (min) or fall (max), so the front is the answer.
+    uint32_t minDeque[STATS_BUCKETS];
+    uint32_t maxDeque[STATS_BUCKETS];
+    uint8_t minFront = 0, minSize = 0;
+    uint8_t maxFront = 0, maxSize = 0;
+  };
+
+  static void clear(Bucket &bucket);
+  static void merge(Bucket &into, const Bucket &from);
+  void closeBucket();
+
+  uint32_t bucketSamples = 1; // samples in a 10ms bucket
+  Bucket current = {};         // the 10ms bucket being filled
+  Bucket medium = {};          // the 100ms bucket being assembled from 10ms buckets
+  Bucket slow = {};            // the 600ms bucket being assembled from 100ms buckets
+  uint8_t mediumParts = 0;
+  uint8_t slowParts = 0;
+
+  Window windows[STATS_WINDOW_COUNT];
+  SpscQueue<StatsSnapshot, STATS_SNAPSHOT_QUEUE> snapshots;
+};
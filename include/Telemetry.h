@@ -0,0 +1,111 @@
+/*********************************************************************************************************
+ * Telemetry - batched readings and statistics published over Wi-Fi (UDP or MQTT)
+ *
+ * Description:
+ *   The acquisition task adds every filtered reading to a frame that is encoded in place in a slot of a
+ *   small pool of frames. Once per batch period (or when the frame is full) the statistics windows are
+ *   appended and the frame is handed to a separate low priority task, which keeps the Wi-Fi connection
+ *   up and sends each frame as one UDP datagram or one MQTT message. Adding a reading only does a few
+ *   varint stores into RAM, and if the network has fallen behind and every frame in the pool is still
+ *   waiting to go out, the batch is dropped (and counted) rather than waiting, so Wi-Fi latency never
+ *   holds up sampling.
+ *
+ * Frame format (integers are LEB128 varints unless noted, signed values zigzag encoded):
+ *   uint8   magic       0x4B ('K')
+ *   uint8   version     1
+ *   uint16  count       readings in the frame (little-endian)
+ *   uint16  spanMs      time from the first to the last reading (little-endian, readings are evenly spaced)
+ *   uint8   columns     values per reading
+ *   varint  device      low 32 bits of the factory MAC address
+ *   varint  sequence    increases by one per frame, including dropped ones
+ *   varint  startMs     time of the first reading, ms since boot
+ *   count x columns x svarint   each value minus the same column of the previous reading (the first
+ *                               reading minus 0)
+ *   uint8   windows     statistics windows that follow (0 if the frame filled up early)
+ *   windows x (varint samples, varint min, varint max, varint mean x 16, varint sd x 16), raw counts
+ *
+ *   A steady reading costs one byte per value, so a second of readings at 100/s fits in about 200 bytes.
+ *   See tools/telemetry_receiver.py for a decoder.
+ *
+ * Notes:
+ *   - add() and send() belong to one producer task; the network task is started by begin().
+ *   - Wi-Fi is started by the caller (it is shared with the dashboard); frames are discarded while it is down.
+ *   - The ADC keeps running on ADC1, which is unaffected by Wi-Fi (only ADC2 is shared with the radio).
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "SpscQueue.h"
+#include "Statistics.h"
+
+#define TELEMETRY_FRAME_BYTES 1024 // largest frame (one UDP datagram / MQTT message)
+#define TELEMETRY_POOL_FRAMES 4    // frames that can wait for the network at once (power of two)
+#define TELEMETRY_MAX_COLUMNS 9    // values per reading
+
+enum TelemetryTransport : uint8_t {
+  TELEMETRY_UDP,
+  TELEMETRY_MQTT,
+};
+
+struct TelemetryConfig {
+  TelemetryTransport transport;
+  const char *host;  // UDP receiver or MQTT broker
+  uint16_t port;
+  const char *topic; // MQTT only
+};
+
+class Telemetry {
+public:
+  // Start the task that sends the frames
+  bool begin(const TelemetryConfig &config, BaseType_t core, UBaseType_t priority);
+
+  // Producer side: add one reading of 'columns' values taken at 'nowMs'
+  void add(uint32_t nowMs, const int32_t *values, uint8_t columns);
+
+  // Producer side: true once the batch being filled is 'periodMs' old
+  bool due(uint32_t nowMs, uint32_t periodMs) const { return batchOpen && nowMs - startMs >= periodMs; }
+
+  // Producer side: append the statistics and hand the frame to the network task
+  void send(const StatsSnapshot &stats);
+
+  bool enabled() const { return taskHandle != nullptr; }
+  bool connected() const { return online; }
+  uint32_t framesSent() const { return sent; }
+  uint32_t framesDropped() const { return dropped + unsent; }
+  uint32_t bytesSent() const { return bytes; }
+
+private:
+  struct Frame {
+    uint16_t length;
+    uint8_t data[TELEMETRY_FRAME_BYTES];
+  };
+
+  static void networkTask(void *parameter);
+  void startBatch(uint32_t nowMs, uint8_t columns);
+  void closeBatch(const StatsSnapshot *stats);
+  void putVarint(uint32_t value);
+  void putSigned(int32_t value) { putVarint(((uint32_t)value << 1) ^ (uint32_t)(value >> 31)); }
+
+  TelemetryConfig settings = {};
+  SpscQueue<Frame, TELEMETRY_POOL_FRAMES> pool;
+  TaskHandle_t taskHandle = nullptr;
+  uint32_t device = 0;
+
+  // The batch being filled, encoded straight into a claimed frame (nullptr if the pool was full, the batch is
+  // then dropped)
+  bool batchOpen = false;
+  Frame *filling = nullptr;
+  uint16_t count = 0;
+  uint8_t numColumns = 0;
+  uint32_t startMs = 0;
+  uint32_t lastMs = 0;
+  int32_t previous[TELEMETRY_MAX_COLUMNS] = {};
+  uint32_t sequence = 0;
+
+  volatile bool online = false;
+  volatile uint32_t sent = 0;
+  volatile uint32_t dropped = 0; // producer side: the pool was full
+  volatile uint32_t unsent = 0;  // network task: the send failed (each counter has one writer)
+  volatile uint32_t bytes = 0;
+};
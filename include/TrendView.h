@@ -0,0 +1,54 @@
+/*********************************************************************************************************
+ * TrendView - scrolling strip chart of the recent history of a reading
+ *
+ * Description:
+ *   The chart lives in a sprite used as a circular buffer of columns: each new value overwrites only the
+ *   oldest column (a clear, the grid and one line segment), so adding a value costs one column of drawing
+ *   however wide the chart is. To show it, the sprite is sent to the panel in two pieces split at the
+ *   newest column, so the oldest value is on the left and the newest on the right without moving any
+ *   pixels in memory.
+ *
+ *   Values keep being added while another view is on screen, so the history is complete when the trend
+ *   view is shown again.
+ *
+ * Notes:
+ *   - Anything drawing with DMA (e.g. SpriteMeter) must have finished before draw() is called.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+
+#define TREND_BACKGROUND TFT_BLACK
+#define TREND_GRID 0x2104 // dark grey
+#define TREND_TRACE TFT_GREEN
+
+class TrendView {
+public:
+  explicit TrendView(TFT_eSPI *tft);
+
+  // Allocate the chart for an area of the panel, plotting 'minValue' at the bottom and 'maxValue' at the
+  // top. Returns false if there isn't enough memory.
+  bool begin(int32_t x, int32_t y, int16_t w, int16_t h, float minValue, float maxValue);
+
+  // Add the newest value as one column (nothing is sent to the panel)
+  void add(float value);
+
+  // Send the chart to the panel
+  void draw();
+
+private:
+  int16_t rowOf(float value) const;
+  void clearColumn(int16_t column);
+
+  TFT_eSprite sprite;
+  int32_t areaX = 0;
+  int32_t areaY = 0;
+  int16_t width = 0;
+  int16_t height = 0;
+  float low = 0;
+  float high = 1;
+
+  int16_t next = 0;     // column the next value goes in (the oldest one on screen)
+  int16_t lastRow = -1; // row of the previous value (-1 until the first value)
+};
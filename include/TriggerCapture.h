@@ -0,0 +1,99 @@
+/*********************************************************************************************************
+ * TriggerCapture - edge trigger on the raw sample stream with a pre-trigger history
+ *
+ * Description:
+ *   Watches one channel of the raw (unfiltered) samples for the signal crossing a level, like the trigger
+ *   of an oscilloscope. The most recent samples are always kept in a ring buffer, so when the trigger
+ *   fires the capture starts with the history leading up to the event, followed by a fixed number of
+ *   samples after it. The capture is then frozen until it is re-armed, so it can be drawn or sent out at
+ *   leisure while sampling carries on.
+ *
+ *   Hysteresis stops a noisy signal sitting near the level from re-triggering: for a rising edge the
+ *   signal must first drop to level - hysteresis before a crossing of the level counts (and the other
+ *   way round for a falling edge).
+ *
+ * Capture layout:
+ *   samples()[0 .. triggerIndex() - 1]             history before the trigger
+ *   samples()[triggerIndex()]                      the sample that crossed the level
+ *   samples()[triggerIndex() + 1 .. length() - 1]  after the trigger
+ *
+ * Notes:
+ *   - feed() is called by the acquisition task with every block; evaluating the trigger is a compare and
+ *     a store per sample, so it keeps up with the full DMA sample rate.
+ *   - begin() must be called before the samples start arriving, and only the acquisition task may call
+ *     feed(). Any other task may call arm(), captured() and, while captured() is true, read the capture.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+#define TRIGGER_HISTORY_SAMPLES 1024 // most pre-trigger samples (power of two, the size of the ring)
+#define TRIGGER_CAPTURE_SAMPLES 2048 // most samples in a capture (pre-trigger + post-trigger)
+
+enum TriggerEdge : uint8_t {
+  TRIGGER_RISING,  // signal going up through the level
+  TRIGGER_FALLING, // signal going down through the level
+  TRIGGER_EITHER,
+};
+
+class TriggerCapture {
+public:
+  // Trigger when the signal crosses 'level' (in raw ADC counts) on the given edge, keeping 'preSamples'
+  // before and 'postSamples' from the trigger on. Starts armed.
+  void begin(uint16_t level, TriggerEdge edge, uint16_t hysteresis, size_t preSamples, size_t postSamples);
+
+  // Look for the trigger in the samples of one block, taking every 'stride'-th sample (one channel of an
+  // interleaved block)
+  void feed(const uint16_t *samples, size_t count, size_t stride = 1);
+
+  // Release the frozen capture and wait for the next trigger
+  void arm() { rearm.store(true, std::memory_order_release); }
+
+  // A capture is complete and frozen (and arm() has not been called since)
+  bool captured() const {
+    return !rearm.load(std::memory_order_relaxed) && state.load(std::memory_order_acquire) == STATE_CAPTURED;
+  }
+
+  // The captured samples (only valid while captured() is true)
+  const uint16_t *samples() const { return capture; }
+  size_t length() const { return captureLength; }
+  size_t triggerIndex() const { return triggerPos; }
+
+  // How many times the trigger has fired since begin()
+  uint32_t captureCount() const { return captures; }
+
+private:
+  enum State : uint8_t {
+    STATE_ARMED,      // waiting for the trigger
+    STATE_COLLECTING, // triggered, filling in the samples after the trigger
+    STATE_CAPTURED,   // complete, frozen until arm()
+  };
+
+  bool edgeDetected(uint16_t sample);
+  void startCapture(uint16_t sample);
+
+  uint16_t triggerLevel = 0;
+  TriggerEdge triggerEdge = TRIGGER_RISING;
+  uint16_t hysteresisCounts = 0;
+  size_t preLength = 0;
+  size_t postLength = 0;
+
+  // Edge detector: which crossings are possible (the signal has been past the hysteresis band)
+  bool risingReady = false;
+  bool fallingReady = false;
+
+  // Rolling history of the most recent samples
+  uint16_t history[TRIGGER_HISTORY_SAMPLES] = {};
+  size_t historyIndex = 0;
+  size_t historyFilled = 0;
+
+  uint16_t capture[TRIGGER_CAPTURE_SAMPLES] = {};
+  size_t captureLength = 0;
+  size_t triggerPos = 0;
+  uint32_t captures = 0;
+
+  std::atomic<uint8_t> state{STATE_ARMED};
+  std::atomic<bool> rearm{false};
+};
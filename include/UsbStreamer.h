@@ -0,0 +1,76 @@
+/*********************************************************************************************************
+ * UsbStreamer - raw ADC blocks streamed to a host over the native USB CDC port
+ *
+ * Description:
+ *   Every block of samples the acquisition task reads is sent to the host as one binary frame (no text
+ *   formatting). The acquisition task reads the DMA results straight into a slot of the streamer's ring
+ *   of frames, and a separate low priority task writes each finished frame to the USB port in a single
+ *   write, so the samples are never copied and a slow or disconnected host never holds up sampling.
+ *
+ * Frame format (little-endian):
+ *   uint16 sync        0x5AA5
+ *   uint16 count       number of samples in the frame
+ *   uint32 sequence    increases by one per block, including blocks that had to be dropped
+ *   uint32 timestamp   time the block was read, in microseconds since boot
+ *   uint8  channels    number of interleaved channels
+ *   uint8  reserved    0
+ *   uint16 samples[count]  raw 12-bit ADC values, interleaved channel by channel (see AdcSampler.h)
+ *
+ * Notes:
+ *   - If the ring is full the block is dropped on the device (and counted). The host can count lost frames
+ *     from gaps in the sequence numbers, see tools/stream_reader.py.
+ *   - The USB Serial/JTAG port on the S3 sustains well over the ~100kB/s needed for 50kS/s.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "AdcSampler.h"
+#include "SpscQueue.h"
+
+#define STREAM_SYNC 0x5AA5
+#define STREAM_RING_FRAMES 32 // frames buffered between the acquisition task and the USB port
+
+struct __attribute__((packed)) StreamFrameHeader {
+  uint16_t sync;
+  uint16_t count;
+  uint32_t sequence;
+  uint32_t timestampUs;
+  uint8_t channels;
+  uint8_t reserved;
+};
+
+struct StreamFrame {
+  StreamFrameHeader header;
+  uint16_t samples[ADC_BLOCK_SAMPLES];
+};
+
+class UsbStreamer {
+public:
+  // Start the task that writes frames of 'channels' interleaved channels to 'port'
+  bool begin(Print &port, uint8_t channels, BaseType_t core, UBaseType_t priority);
+
+  // Acquisition side: buffer to read the next block into. Always returns a buffer; if the ring is full it is
+  // a scratch buffer and the block will be counted as dropped.
+  uint16_t *claimBlock();
+
+  // Acquisition side: the block returned by claimBlock() holds 'count' samples and can be sent
+  void commitBlock(size_t count);
+
+  bool enabled() const { return port != nullptr; }
+  uint32_t framesSent() const { return sent; }
+  uint32_t framesDropped() const { return dropped; }
+
+private:
+  static void streamTask(void *parameter);
+
+  SpscQueue<StreamFrame, STREAM_RING_FRAMES> ring;
+  StreamFrame scratch;          // used when the ring is full
+  StreamFrame *claimed = nullptr;
+  Print *port = nullptr;
+  TaskHandle_t taskHandle = nullptr;
+  uint32_t sequence = 0;
+  uint8_t numChannels = 1;
+  volatile uint32_t sent = 0;
+  volatile uint32_t dropped = 0;
+};
@@ -0,0 +1,63 @@
+/*********************************************************************************************************
+ * ValueReadout - numeric readout that only redraws the digits that changed
+ *
+ * Description:
+ *   The value is shown right-aligned in a row of fixed-width character cells. The readout remembers what
+ *   is currently on the panel and, on each update, only repaints the cells whose character changed, so a
+ *   steady reading costs no SPI traffic at all and a changing one only a few glyphs.
+ *
+ * Notes:
+ *   - Numbers are formatted with integer maths only (no dtostrf()), fixed point values via setDecimals().
+ *   - Call invalidate() if something else has drawn over the readout area; the next update then
+ *     repaints every cell.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+
+// Maximum number of character cells in a readout
+#define READOUT_MAX_CELLS 8
+
+class ValueReadout {
+public:
+  explicit ValueReadout(TFT_eSPI *tft);
+
+  // Place the readout: 'rightX' is the right edge, 'y' the top, 'cells' the number of characters
+  void begin(int32_t rightX, int32_t y, uint8_t cells, uint8_t font, uint16_t fgColor, uint16_t bgColor);
+
+  // Show values as fixed point with this many digits after the decimal point (e.g. 1234 with 1 -> "123.4")
+  void setDecimals(uint8_t digits) { decimals = digits; }
+
+  // Show 'value', drawing only the cells that differ from what is on screen
+  void update(int32_t value);
+
+  // Show a preformatted string (right-aligned, truncated to the number of cells)
+  void update(const char *text);
+
+  // Forget what is on screen so the next update repaints every cell
+  void invalidate() { valid = false; }
+
+  // The area the cells cover
+  int32_t x() const { return left; }
+  int32_t y() const { return top; }
+  int32_t width() const { return cellWidth * numCells; }
+  int32_t height() const { return cellHeight; }
+
+private:
+  void drawCell(uint8_t cell, char c);
+
+  TFT_eSPI *display;
+  int32_t left = 0;
+  int32_t top = 0;
+  int16_t cellWidth = 0;
+  int16_t cellHeight = 0;
+  uint8_t numCells = 0;
+  uint8_t textFont = 2;
+  uint8_t decimals = 0;
+  uint16_t fg = TFT_BLACK;
+  uint16_t bg = TFT_WHITE;
+
+  char shown[READOUT_MAX_CELLS + 1] = {}; // characters currently on the panel
+  bool valid = false;
+};
@@ -0,0 +1,67 @@
+/*********************************************************************************************************
+ * ViewController - state machine of the views on screen, driven by the buttons
+ *
+ * Description:
+ *   The views are described by a table (ViewSpec): a prerendered background layer, what to draw on
+ *   entering, one frame, what the action button does, and the frame period the view needs. The current
+ *   view is the state, and the button events are the transitions:
+ *     - view button click   next view (skipping views that aren't available)
+ *     - view button hold    back to the first view
+ *     - action button       handed to the current view (e.g. re-arm, select, change a setting)
+ *   On a switch the new view's layer is pushed from its sprite, its enter() draws the changing parts and
+ *   its period is handed to the frame scheduler, so the display task wakes exactly as often as the view
+ *   on screen needs. Only the current view's frame() ever runs: a hidden view costs nothing.
+ *
+ * Notes:
+ *   - Runs in the display task only.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include "Buttons.h"
+#include "FrameScheduler.h"
+#include "ViewLayers.h"
+
+struct ViewSpec {
+  const char *name;
+  uint16_t periodMs;     // frame period while shown (0 = the frame scheduler's adaptive period)
+  bool available;        // false leaves the view out of the cycle
+  LayerRenderer layer;   // static background (nullptr = enter() draws the whole view)
+  void (*enter)();       // draw the view over its background
+  void (*frame)();       // one frame while the view is shown
+  void (*action)(const ButtonEvent &event); // the action button's events (nullptr = ignored)
+};
+
+class ViewController {
+public:
+  ViewController(ViewLayers *viewLayers, FrameScheduler *frameScheduler);
+
+  // Views 'views[0 .. count)', showing 'first'. 'beforeSwitch' is called before the panel is touched on every
+  // switch (e.g. to wait for a DMA transfer). Nothing is drawn until show().
+  void begin(const ViewSpec *views, uint8_t count, uint8_t first, uint8_t viewButton, uint8_t actionButton,
+             void (*beforeSwitch)());
+
+  // Switch to a view (drawing it again if it is already shown)
+  void show(uint8_t view);
+
+  // One button event
+  void handle(const ButtonEvent &event);
+
+  // One frame of the current view
+  void frame();
+
+  uint8_t current() const { return shown; }
+  const char *name() const { return table[shown].name; }
+
+private:
+  ViewLayers *layers;
+  FrameScheduler *scheduler;
+  const ViewSpec *table = nullptr;
+  uint8_t viewCount = 0;
+  uint8_t shown = 0;
+  uint8_t home = 0;
+  uint8_t nextButton = 0;
+  uint8_t doButton = 1;
+  void (*prepare)() = nullptr;
+};
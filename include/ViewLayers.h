@@ -0,0 +1,53 @@
+/*********************************************************************************************************
+ * ViewLayers - the static part of each view prerendered into a sprite, so switching views is instant
+ *
+ * Description:
+ *   Most views are a fixed background (titles, labels, axes, grid lines) with a few values drawn over it.
+ *   The background of each view is rendered once into a sprite of its own, the size of the area under
+ *   the heading, and from then on showing the view is a single push of that sprite to the panel instead
+ *   of clearing the area and drawing every line and label again. The view then only draws what changes.
+ *
+ *   A layer is rendered by a function of the view that draws with (0, 0) at the top left of the area, on
+ *   whatever canvas it is given: the layer's sprite, or the panel itself (through a viewport) if there
+ *   wasn't the memory for the sprite. invalidate() makes the next show() render the layer again, e.g.
+ *   when a setting it shows has changed.
+ *
+ * Notes:
+ *   - The sprites are in PSRAM (~90kB each for the area below the heading) and allocated on first use.
+ *   - Anything drawing with DMA (e.g. SpriteMeter) must have finished before show().
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <TFT_eSPI.h>
+
+#define VIEW_LAYERS_MAX 8 // views that can have a layer
+
+typedef void (*LayerRenderer)(TFT_eSPI &canvas, int16_t w, int16_t h);
+
+class ViewLayers {
+public:
+  explicit ViewLayers(TFT_eSPI *tft);
+
+  // The area of the panel the views share
+  void begin(int32_t x, int32_t y, int16_t w, int16_t h);
+
+  // Put the background of view 'id' on the panel, rendering it with 'render' first if it isn't cached
+  void show(uint8_t id, LayerRenderer render);
+
+  // Render the layer again on its next show()
+  void invalidate(uint8_t id);
+
+  // Bytes of sprite memory in use
+  uint32_t bytes() const { return allocated; }
+
+private:
+  TFT_eSPI *display;
+  TFT_eSprite *layers[VIEW_LAYERS_MAX] = {};
+  bool rendered[VIEW_LAYERS_MAX] = {};
+  int32_t areaX = 0;
+  int32_t areaY = 0;
+  int16_t width = 0;
+  int16_t height = 0;
+  uint32_t allocated = 0;
+};
@@ -0,0 +1,129 @@
+#include "AdcSampler.h"
+
+bool AdcSampler::begin(adc1_channel_t channel, uint32_t sampleRateHz) {
+  return begin(&channel, 1, sampleRateHz);
+}
+
+bool AdcSampler::begin(const adc1_channel_t *channels, uint8_t count, uint32_t sampleRateHz) {
+  if (isRunning) {
+    end();
+  }
+
+  if (count == 0 || count > ADC_MAX_CHANNELS) {
+    return false;
+  }
+
+  // Keep the requested rate inside what the hardware can do
+  if (sampleRateHz < SOC_ADC_SAMPLE_FREQ_THRES_LOW) sampleRateHz = SOC_ADC_SAMPLE_FREQ_THRES_LOW;
+  if (sampleRateHz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) sampleRateHz = SOC_ADC_SAMPLE_FREQ_THRES_HIGH;
+
+  numChannels = count;
+  rateHz = sampleRateHz;
+  lastIndex = -1;
+
+  uint32_t channelMask = 0;
+  memset(channelIndex, -1, sizeof(channelIndex));
+  for (uint8_t i = 0; i < count; i++) {
+    channelList[i] = channels[i];
+    channelIndex[channels[i]] = i;
+    channelMask |= BIT(channels[i]);
+  }
+
+  // Driver ring buffer and the number of bytes converted per DMA interrupt
+  adc_digi_init_config_t initConfig = {};
+  initConfig.max_store_buf_size = sizeof(raw) * ADC_RING_BLOCKS;
+  initConfig.conv_num_each_intr = sizeof(raw);
+  initConfig.adc1_chan_mask = channelMask;
+  initConfig.adc2_chan_mask = 0;
+
+  if (adc_digi_initialize(&initConfig) != ESP_OK) {
+    return false;
+  }
+
+  // One pattern entry per channel: full 0-3.3V range, 12-bit results
+  adc_digi_pattern_config_t pattern[ADC_MAX_CHANNELS] = {};
+  for (uint8_t i = 0; i < count; i++) {
+    pattern[i].atten = ADC_ATTEN_DB_11;
+    pattern[i].channel = channels[i];
+    pattern[i].unit = 0; // ADC1
+    pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+  }
+
+  adc_digi_configuration_t config = {};
+  config.conv_limit_en = false;
+  config.conv_limit_num = 250;
+  config.pattern_num = count;
+  config.adc_pattern = pattern;
+  config.sample_freq_hz = sampleRateHz;
+  config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+  config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+  if (adc_digi_controller_configure(&config) != ESP_OK || adc_digi_start() != ESP_OK) {
+    adc_digi_deinitialize();
+    return false;
+  }
+
+  isRunning = true;
+  return true;
+}
+
+void AdcSampler::end() {
+  if (!isRunning) {
+    return;
+  }
+
+  adc_digi_stop();
+  adc_digi_deinitialize();
+  isRunning = false;
+}
+
+size_t AdcSampler::readBlock(uint16_t *samples, size_t maxSamples, uint32_t timeoutMs) {
+  if (!isRunning || maxSamples < numChannels) {
+    return 0;
+  }
+
+  if (maxSamples > ADC_BLOCK_SAMPLES) {
+    maxSamples = ADC_BLOCK_SAMPLES;
+  }
+
+  // Part of a sweep may be left over from the last read, so leave room for it to complete
+  size_t maxEntries = maxSamples - (numChannels - 1);
+
+  uint32_t bytesRead = 0;
+  esp_err_t result = adc_digi_read_bytes((uint8_t *)raw, maxEntries * sizeof(raw[0]), &bytesRead, timeoutMs);
+  if (result == ESP_ERR_INVALID_STATE) {
+    overruns++; // the ring buffer filled up and older conversions were dropped, but the data is valid
+  } else if (result != ESP_OK) {
+    return 0; // timed out
+  }
+
+  // Unpack the 12-bit results into whole frames, skipping anything that is not from our channels
+  size_t count = 0;
+  size_t entries = bytesRead / sizeof(raw[0]);
+  for (size_t i = 0; i < entries; i++) {
+    uint8_t channel = raw[i].type2.channel;
+    if (channel >= ADC1_CHANNEL_COUNT || channelIndex[channel] < 0) {
+      continue;
+    }
+
+    int8_t index = channelIndex[channel];
+    if (index <= lastIndex && count + numChannels <= maxSamples) {
+      // A new sweep started before the last one finished (conversions were dropped), send what we have
+      memcpy(samples + count, frame, numChannels * sizeof(frame[0]));
+      count += numChannels;
+    }
+
+    frame[index] = raw[i].type2.data;
+    lastIndex = index;
+
+    if (index == numChannels - 1) {
+      if (count + numChannels <= maxSamples) {
+        memcpy(samples + count, frame, numChannels * sizeof(frame[0]));
+        count += numChannels;
+      }
+      lastIndex = -1;
+    }
+  }
+
+  return count;
+}
@@ -0,0 +1,109 @@
+#include "BarMeter.h"
+
+#define BAR_BACKGROUND TFT_DARKGREY
+#define BAR_NO_ZONE TFT_WHITE // a bar outside every zone (white like the face of the analog meter)
+#define BAR_LABEL_WIDTH 24 // space for the channel label on the left
+#define BAR_VALUE_WIDTH 36 // space for the value on the right (4 digits in font 2)
+
+BarMeter::BarMeter(TFT_eSPI *tft) : display(tft) {}
+
+void BarMeter::setZones(uint16_t rs, uint16_t re, uint16_t os, uint16_t oe, uint16_t ys, uint16_t ye, uint16_t gs,
+                        uint16_t ge) {
+  zones[0] = {gs, ge, TFT_GREEN};
+  zones[1] = {ys, ye, TFT_YELLOW};
+  zones[2] = {os, oe, TFT_ORANGE};
+  zones[3] = {rs, re, TFT_RED};
+}
+
+void BarMeter::begin(int32_t x, int32_t y, int32_t w, int32_t h, uint8_t channels, const char *const *labels,
+                     int32_t fullScale) {
+  if (channels > ADC_MAX_CHANNELS) {
+    channels = ADC_MAX_CHANNELS;
+  }
+
+  areaX = x;
+  areaY = y;
+  numChannels = channels;
+  scale = fullScale;
+  rowHeight = h / (channels ? channels : 1);
+  if (rowHeight > 32) rowHeight = 32;
+  barHeight = rowHeight - 4;
+  barX = x + BAR_LABEL_WIDTH;
+  barWidth = w - BAR_LABEL_WIDTH - BAR_VALUE_WIDTH - 4;
+  valueX = x + w; // values are right-aligned
+
+  // Labels and empty bars (the labels never change, so they are drawn once)
+  display->fillRect(x, y, w, rowHeight * channels, TFT_BLACK);
+  uint8_t datum = display->getTextDatum();
+  display->setTextColor(TFT_WHITE, TFT_BLACK);
+  display->setTextDatum(ML_DATUM);
+  for (uint8_t i = 0; i < channels; i++) {
+    int32_t rowY = y + i * rowHeight;
+    display->drawString(labels[i], x, rowY + rowHeight / 2, 2);
+    display->fillRect(barX, rowY + 2, barWidth, barHeight, BAR_BACKGROUND);
+    shownLength[i] = 0;
+    shownColor[i] = zoneColor(0);
+    shownValue[i] = INT32_MIN; // draw the value on the first update
+  }
+  display->setTextDatum(datum);
+}
+
+int16_t BarMeter::barLength(int32_t value) const {
+  if (value < 0) value = 0;
+  if (value > scale) value = scale;
+  return (int16_t)((value * barWidth) / scale);
+}
+
+int16_t BarMeter::pixelDelta(uint8_t channel, int32_t value) const {
+  int16_t delta = barLength(value) - shownLength[channel];
+  return delta < 0 ? -delta : delta;
+}
+
+// Same zones as the analog meter, which draws green over yellow over orange over red
+uint16_t BarMeter::zoneColor(int16_t length) const {
+  int32_t percent = barWidth ? (length * 100) / barWidth : 0;
+  for (const Zone &zone : zones) {
+    if (zone.end > zone.start && percent >= zone.start && percent <= zone.end) {
+      return zone.color;
+    }
+  }
+  return BAR_NO_ZONE;
+}
+
+void BarMeter::update(uint8_t channel, int32_t value) {
+  if (channel >= numChannels) {
+    return;
+  }
+
+  int32_t rowY = areaY + channel * rowHeight;
+  int32_t top = rowY + 2;
+  int16_t length = barLength(value);
+  uint16_t color = zoneColor(length);
+  int16_t old = shownLength[channel];
+
+  if (color != shownColor[channel]) {
+    // Changed zone, repaint the whole bar in the new colour
+    display->fillRect(barX, top, length, barHeight, color);
+    display->fillRect(barX + length, top, barWidth - length, barHeight, BAR_BACKGROUND);
+  } else if (length > old) {
+    display->fillRect(barX + old, top, length - old, barHeight, color); // grow
+  } else if (length < old) {
+    display->fillRect(barX + length, top, old - length, barHeight, BAR_BACKGROUND); // shrink
+  }
+  shownLength[channel] = length;
+  shownColor[channel] = color;
+
+  if (value != shownValue[channel]) {
+    char text[12];
+    snprintf(text, sizeof(text), "%ld", (long)value);
+
+    uint8_t datum = display->getTextDatum();
+    display->setTextDatum(MR_DATUM);
+    display->setTextColor(TFT_WHITE, TFT_BLACK);
+    display->setTextPadding(BAR_VALUE_WIDTH);
+    display->drawString(text, valueX, rowY + rowHeight / 2, 2);
+    display->setTextPadding(0);
+    display->setTextDatum(datum);
+    shownValue[channel] = value;
+  }
+}
@@ -0,0 +1,352 @@
+#include "BlockKernels.h"
+
+// ---- Scalar reference versions ----
+
+int32_t blockSumScalar(const int16_t *samples, size_t count) {
+  int32_t sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    sum += samples[i];
+  }
+  return sum;
+}
+
+int64_t blockSumSquaresScalar(const int16_t *samples, size_t count) {
+  int64_t sum = 0;
+  for (size_t i = 0; i < count; i++) {
+    sum += (int32_t)samples[i] * samples[i];
+  }
+  return sum;
+}
+
+void blockMinMaxScalar(const int16_t *samples, size_t count, int16_t &low, int16_t &high) {
+  low = INT16_MAX;
+  high = INT16_MIN;
+  for (size_t i = 0; i < count; i++) {
+    if (samples[i] < low) low = samples[i];
+    if (samples[i] > high) high = samples[i];
+  }
+}
+
+void blockStatsScalar(const int16_t *samples, size_t count, BlockStats &stats) {
+  int32_t sum = 0;
+  int64_t sumSquares = 0;
+  int16_t low = INT16_MAX;
+  int16_t high = INT16_MIN;
+  for (size_t i = 0; i < count; i++) {
+    int32_t sample = samples[i];
+    sum += sample;
+    sumSquares += sample * sample;
+    if (sample < low) low = sample;
+    if (sample > high) high = sample;
+  }
+  stats.sum = sum;
+  stats.sumSquares = sumSquares;
+  stats.min = low;
+  stats.max = high;
+}
+
+void blockLookupScalar(const uint16_t *in, int16_t *out, size_t count, const int16_t *table, uint16_t mask) {
+  for (size_t i = 0; i < count; i++) {
+    out[i] = table[in[i] & mask];
+  }
+}
+
+#if BLOCK_KERNELS_PIE
+
+// ---- ESP32-S3 PIE versions ----
+// Each kernel is one asm block, so nothing the compiler generates runs between loading a vector register (or
+// the accumulator) and using it. The loops count down whole vectors of 8 samples from a 16-byte aligned address.
+
+alignas(16) static const int16_t ONES[8] = {1, 1, 1, 1, 1, 1, 1, 1};
+alignas(16) static const int16_t HIGHEST[8] = {INT16_MAX, INT16_MAX, INT16_MAX, INT16_MAX,
+                                               INT16_MAX, INT16_MAX, INT16_MAX, INT16_MAX};
+alignas(16) static const int16_t LOWEST[8] = {INT16_MIN, INT16_MIN, INT16_MIN, INT16_MIN,
+                                              INT16_MIN, INT16_MIN, INT16_MIN, INT16_MIN};
+
+// Samples before the first 16-byte boundary, which are done one at a time
+static size_t unalignedHead(const int16_t *samples, size_t count) {
+  size_t head = ((16 - ((uintptr_t)samples & 15)) & 15) / sizeof(int16_t);
+  return head < count ? head : count;
+}
+
+// The 40-bit ACCX accumulator as a signed number (ACCX_1 holds bits 32-39)
+static int64_t accumulator(uint32_t low, uint32_t high) {
+  return (int64_t)(((uint64_t)(int64_t)(int8_t)high << 32) | low);
+}
+
+// Sum of 'vectors' x 8 samples from 'p' (the samples times a vector of ones), 'p' is moved past them
+static int64_t pieSum(const int16_t *&p, size_t vectors) {
+  uint32_t low, high;
+  asm volatile("ee.zero.accx\n"
+               "ee.vld.128.ip q7, %[ones], 0\n"
+               "1:\n"
+               "ee.vld.128.ip q0, %[p], 16\n"
+               "ee.vmulas.s16.accx q0, q7\n"
+               "addi %[n], %[n], -1\n"
+               "bnez %[n], 1b\n"
+               "rur.accx_0 %[low]\n"
+               "rur.accx_1 %[high]\n"
+               : [p] "+r"(p), [n] "+r"(vectors), [low] "=r"(low), [high] "=r"(high)
+               : [ones] "r"(ONES)
+               : "memory");
+  return accumulator(low, high);
+}
+
+// Sum of the squares of 'vectors' x 8 samples from 'p', 'p' is moved past them
+static int64_t pieSumSquares(const int16_t *&p, size_t vectors) {
+  uint32_t low, high;
+  asm volatile("ee.zero.accx\n"
+               "1:\n"
+               "ee.vld.128.ip q0, %[p], 16\n"
+               "ee.vmulas.s16.accx q0, q0\n"
+               "addi %[n], %[n], -1\n"
+               "bnez %[n], 1b\n"
+               "rur.accx_0 %[low]\n"
+               "rur.accx_1 %[high]\n"
+               : [p] "+r"(p), [n] "+r"(vectors), [low] "=r"(low), [high] "=r"(high)
+               :
+               : "memory");
+  return accumulator(low, high);
+}
+
+// Lowest and highest of 'vectors' x 8 samples from 'p' (kept per lane, then the 8 lanes are compared), 'p' is moved
+// past them
+static void pieMinMax(const int16_t *&p, size_t vectors, int16_t &low, int16_t &high) {
+  alignas(16) int16_t lanes[16];
+  int16_t *out = lanes;
+  asm volatile("ee.vld.128.ip q5, %[highest], 0\n"
+               "ee.vld.128.ip q6, %[lowest], 0\n"
+               "1:\n"
+               "ee.vld.128.ip q0, %[p], 16\n"
+               "ee.vmin.s16 q5, q5, q0\n"
+               "ee.vmax.s16 q6, q6, q0\n"
+               "addi %[n], %[n], -1\n"
+               "bnez %[n], 1b\n"
+               "ee.vst.128.ip q5, %[out], 16\n"
+               "ee.vst.128.ip q6, %[out], 16\n"
+               : [p] "+r"(p), [n] "+r"(vectors), [out] "+r"(out)
+               : [highest] "r"(HIGHEST), [lowest] "r"(LOWEST)
+               : "memory");
+
+  for (int lane = 0; lane < 8; lane++) {
+    if (lanes[lane] < low) low = lanes[lane];
+    if (lanes[8 + lane] > high) high = lanes[8 + lane];
+  }
+}
+
+// Sum, sum of squares, lowest and highest of 'vectors' x 8 samples from 'p' in one pass, 'p' is moved past them.
+// The squares go into ACCX as in pieSumSquares(), the sum into the eight 40-bit lanes of QACC (samples x ones) and the
+// extremes into one vector register each. 'stats' comes in with the min and max so far.
+static void pieStats(const int16_t *&p, size_t vectors, BlockStats &stats) {
+  alignas(16) uint8_t out[96]; // lowest and highest lanes, then QACC_L and QACC_H (128 + 32 bits each)
+  uint8_t *store = out;
+  uint32_t low, high;
+  asm volatile("ee.zero.accx\n"
+               "ee.zero.qacc\n"
+               "ee.vld.128.ip q7, %[ones], 0\n"
+               "ee.vld.128.ip q5, %[highest], 0\n"
+               "ee.vld.128.ip q6, %[lowest], 0\n"
+               "1:\n"
+               "ee.vld.128.ip q0, %[p], 16\n"
+               "ee.vmulas.s16.accx q0, q0\n"
+               "ee.vmulas.s16.qacc q0, q7\n"
+               "ee.vmin.s16 q5, q5, q0\n"
+               "ee.vmax.s16 q6, q6, q0\n"
+               "addi %[n], %[n], -1\n"
+               "bnez %[n], 1b\n"
+               "rur.accx_0 %[low]\n"
+               "rur.accx_1 %[high]\n"
+               "ee.vst.128.ip q5, %[store], 16\n"
+               "ee.vst.128.ip q6, %[store], 16\n"
+               "ee.st.qacc_l.l.128.ip %[store], 16\n"
+               "ee.st.qacc_l.h.32.ip %[store], 16\n"
+               "ee.st.qacc_h.l.128.ip %[store], 16\n"
+               "ee.st.qacc_h.h.32.ip %[store], 16\n"
+               : [p] "+r"(p), [n] "+r"(vectors), [store] "+r"(store), [low] "=r"(low), [high] "=r"(high)
+               : [ones] "r"(ONES), [highest] "r"(HIGHEST), [lowest] "r"(LOWEST)
+               : "memory");
+
+  stats.sumSquares = accumulator(low, high);
+
+  // Each half of QACC is four signed 40-bit lanes, packed little-endian into 20 bytes (only their total matters)
+  int64_t sum = 0;
+  for (int half = 0; half < 2; half++) {
+    const uint8_t *lane = out + 32 + half * 32;
+    for (int i = 0; i < 4; i++, lane += 5) {
+      uint64_t bits = 0;
+      for (int b = 0; b < 5; b++) {
+        bits |= (uint64_t)lane[b] << (8 * b);
+      }
+      sum += (int64_t)(bits << 24) >> 24;
+    }
+  }
+  stats.sum = (int32_t)sum;
+
+  const int16_t *lanes = (const int16_t *)out;
+  for (int i = 0; i < 8; i++) {
+    if (lanes[i] < stats.min) stats.min = lanes[i];
+    if (lanes[8 + i] > stats.max) stats.max = lanes[8 + i];
+  }
+}
+
+// Table lookup of 'vectors' x 8 counts from 'in' into 'out', both moved past them. The counts are masked 8 at a time
+// (EE.ANDQ) and stored as indexes, then the 8 table loads are interleaved over two registers so they overlap (PIE has
+// no gather load). 'out' needs no alignment.
+static void pieLookup(const uint16_t *&in, int16_t *&out, size_t vectors, const int16_t *table, uint16_t mask) {
+  alignas(16) uint16_t masks[8] = {mask, mask, mask, mask, mask, mask, mask, mask};
+  alignas(16) uint16_t index[8];
+  uint16_t *indexes = index;
+  uint32_t a, b;
+  asm volatile("ee.vld.128.ip q7, %[masks], 0\n"
+               "1:\n"
+               "ee.vld.128.ip q0, %[in], 16\n"
+               "ee.andq q0, q0, q7\n"
+               "ee.vst.128.ip q0, %[index], 0\n"
+               "l16ui %[a], %[index], 0\n"
+               "l16ui %[b], %[index], 2\n"
+               "addx2 %[a], %[a], %[table]\n"
+               "addx2 %[b], %[b], %[table]\n"
+               "l16si %[a], %[a], 0\n"
+               "l16si %[b], %[b], 0\n"
+               "s16i %[a], %[out], 0\n"
+               "s16i %[b], %[out], 2\n"
+               "l16ui %[a], %[index], 4\n"
+               "l16ui %[b], %[index], 6\n"
+               "addx2 %[a], %[a], %[table]\n"
+               "addx2 %[b], %[b], %[table]\n"
+               "l16si %[a], %[a], 0\n"
+               "l16si %[b], %[b], 0\n"
+               "s16i %[a], %[out], 4\n"
+               "s16i %[b], %[out], 6\n"
+               "l16ui %[a], %[index], 8\n"
+               "l16ui %[b], %[index], 10\n"
+               "addx2 %[a], %[a], %[table]\n"
+               "addx2 %[b], %[b], %[table]\n"
+               "l16si %[a], %[a], 0\n"
+               "l16si %[b], %[b], 0\n"
+               "s16i %[a], %[out], 8\n"
+               "s16i %[b], %[out], 10\n"
+               "l16ui %[a], %[index], 12\n"
+               "l16ui %[b], %[index], 14\n"
+               "addx2 %[a], %[a], %[table]\n"
+               "addx2 %[b], %[b], %[table]\n"
+               "l16si %[a], %[a], 0\n"
+               "l16si %[b], %[b], 0\n"
+               "s16i %[a], %[out], 12\n"
+               "s16i %[b], %[out], 14\n"
+               "addi %[out], %[out], 16\n"
+               "addi %[n], %[n], -1\n"
+               "bnez %[n], 1b\n"
+               : [in] "+r"(in), [out] "+r"(out), [n] "+r"(vectors), [a] "=&r"(a), [b] "=&r"(b)
+               : [masks] "r"(masks), [index] "r"(indexes), [table] "r"(table)
+               : "memory");
+}
+
+int32_t blockSum(const int16_t *samples, size_t count) {
+  size_t head = unalignedHead(samples, count);
+  size_t vectors = (count - head) / 8;
+  const int16_t *p = samples + head;
+  int32_t sum = blockSumScalar(samples, head);
+  if (vectors > 0) {
+    sum += (int32_t)pieSum(p, vectors);
+  }
+  return sum + blockSumScalar(p, samples + count - p);
+}
+
+int64_t blockSumSquares(const int16_t *samples, size_t count) {
+  size_t head = unalignedHead(samples, count);
+  size_t vectors = (count - head) / 8;
+  const int16_t *p = samples + head;
+  int64_t sum = blockSumSquaresScalar(samples, head);
+  if (vectors > 0) {
+    sum += pieSumSquares(p, vectors);
+  }
+  return sum + blockSumSquaresScalar(p, samples + count - p);
+}
+
+void blockMinMax(const int16_t *samples, size_t count, int16_t &low, int16_t &high) {
+  size_t head = unalignedHead(samples, count);
+  size_t vectors = (count - head) / 8;
+  const int16_t *p = samples + head;
+  blockMinMaxScalar(samples, head, low, high);
+  if (vectors > 0) {
+    pieMinMax(p, vectors, low, high);
+  }
+
+  int16_t tailLow, tailHigh;
+  blockMinMaxScalar(p, samples + count - p, tailLow, tailHigh);
+  if (tailLow < low) low = tailLow;
+  if (tailHigh > high) high = tailHigh;
+}
+
+void blockStats(const int16_t *samples, size_t count, BlockStats &stats) {
+  size_t head = unalignedHead(samples, count);
+  size_t vectors = (count - head) / 8;
+  const int16_t *p = samples + head;
+  blockStatsScalar(samples, head, stats);
+
+  BlockStats part;
+  if (vectors > 0) {
+    part.min = stats.min;
+    part.max = stats.max;
+    pieStats(p, vectors, part);
+    stats.sum += part.sum;
+    stats.sumSquares += part.sumSquares;
+    stats.min = part.min;
+    stats.max = part.max;
+  }
+
+  blockStatsScalar(p, samples + count - p, part);
+  stats.sum += part.sum;
+  stats.sumSquares += part.sumSquares;
+  if (part.min < stats.min) stats.min = part.min;
+  if (part.max > stats.max) stats.max = part.max;
+}
+
+void blockLookup(const uint16_t *in, int16_t *out, size_t count, const int16_t *table, uint16_t mask) {
+  size_t head = unalignedHead((const int16_t *)in, count);
+  size_t vectors = (count - head) / 8;
+  blockLookupScalar(in, out, head, table, mask);
+  const uint16_t *p = in + head;
+  int16_t *q = out + head;
+  if (vectors > 0) {
+    pieLookup(p, q, vectors, table, mask);
+  }
+  blockLookupScalar(p, q, in + count - p, table, mask);
+}
+
+#else
+
+int32_t blockSum(const int16_t *samples, size_t count) {
+  return blockSumScalar(samples, count);
+}
+
+int64_t blockSumSquares(const int16_t *samples, size_t count) {
+  return blockSumSquaresScalar(samples, count);
+}
+
+void blockMinMax(const int16_t *samples, size_t count, int16_t &low, int16_t &high) {
+  blockMinMaxScalar(samples, count, low, high);
+}
+
+void blockStats(const int16_t *samples, size_t count, BlockStats &stats) {
+  blockStatsScalar(samples, count, stats);
+}
+
+void blockLookup(const uint16_t *in, int16_t *out, size_t count, const int16_t *table, uint16_t mask) {
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    // Four independent loads per pass, so they can overlap
+    int16_t a = table[in[i] & mask];
+    int16_t b = table[in[i + 1] & mask];
+    int16_t c = table[in[i + 2] & mask];
+    int16_t d = table[in[i + 3] & mask];
+    out[i] = a;
+    out[i + 1] = b;
+    out[i + 2] = c;
+    out[i + 3] = d;
+  }
+  blockLookupScalar(in + i, out + i, count - i, table, mask);
+}
+
+#endif
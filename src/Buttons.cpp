@@ -0,0 +1,95 @@
+#include "Buttons.h"
+#include <driver/gpio.h>
+
+#define DEBOUNCE_MASK ((1 << BUTTON_DEBOUNCE_SAMPLES) - 1)
+#define HOLD_SAMPLES (BUTTON_HOLD_MS / BUTTON_SAMPLE_MS)
+#define REPEAT_SAMPLES (BUTTON_REPEAT_MS / BUTTON_SAMPLE_MS)
+
+Buttons *Buttons::instance = nullptr;
+
+bool Buttons::begin(const uint8_t *pins, uint8_t count, uint8_t timerNumber) {
+  numButtons = count < BUTTON_MAX ? count : BUTTON_MAX;
+  for (uint8_t i = 0; i < numButtons; i++) {
+    pinMode(pins[i], INPUT_PULLUP);
+    state[i] = {};
+    state[i].pin = pins[i];
+  }
+
+  ready = xSemaphoreCreateBinary();
+  if (ready == nullptr) {
+    return false;
+  }
+  instance = this;
+
+  // 1MHz count from the 80MHz APB clock (which stays at 80MHz in low-power mode too)
+  timer = timerBegin(timerNumber, 80, true);
+  if (timer == nullptr) {
+    return false;
+  }
+  timerAttachInterrupt(timer, &onTimer, true);
+  timerAlarmWrite(timer, BUTTON_SAMPLE_MS * 1000, true);
+  timerAlarmEnable(timer);
+  return true;
+}
+
+void Buttons::pause() {
+  if (timer != nullptr) {
+    timerAlarmDisable(timer);
+  }
+}
+
+void Buttons::resume() {
+  if (timer == nullptr) {
+    return;
+  }
+  for (uint8_t i = 0; i < numButtons; i++) {
+    bool pressed = gpio_get_level((gpio_num_t)state[i].pin) == 0;
+    state[i].history = pressed ? DEBOUNCE_MASK : 0;
+    state[i].down = pressed;
+    state[i].ignore = pressed;
+    state[i].heldSamples = 0;
+  }
+  timerAlarmEnable(timer);
+}
+
+void Buttons::onTimer() {
+  BaseType_t woken = pdFALSE;
+  instance->sample(woken);
+  portYIELD_FROM_ISR(woken); // straight to the consumer if it was waiting and has the higher priority
+}
+
+void Buttons::sample(BaseType_t &woken) {
+  for (uint8_t i = 0; i < numButtons; i++) {
+    ButtonState &button = state[i];
+    button.history = (button.history << 1) | (gpio_get_level((gpio_num_t)button.pin) == 0);
+    uint8_t recent = button.history & DEBOUNCE_MASK;
+
+    if (!button.down && recent == DEBOUNCE_MASK) {
+      button.down = true; // pressed
+      button.heldSamples = 0;
+      button.repeats = 0;
+    } else if (button.down && recent == 0) {
+      button.down = false; // released
+      if (!button.ignore) {
+        emit(i, button.heldSamples < HOLD_SAMPLES ? BUTTON_CLICK : BUTTON_RELEASE, button.repeats, woken);
+      }
+      button.ignore = false;
+    } else if (button.down && !button.ignore && button.heldSamples < UINT16_MAX) {
+      button.heldSamples++;
+      if (button.heldSamples == HOLD_SAMPLES) {
+        emit(i, BUTTON_HOLD, 0, woken);
+      } else if (button.heldSamples > HOLD_SAMPLES && (button.heldSamples - HOLD_SAMPLES) % REPEAT_SAMPLES == 0) {
+        emit(i, BUTTON_REPEAT, ++button.repeats, woken);
+      }
+    }
+  }
+}
+
+void Buttons::emit(uint8_t button, ButtonAction action, uint16_t repeats, BaseType_t &woken) {
+  ButtonEvent event = {button, action, repeats};
+  if (!events.push(event)) {
+    dropped++;
+    return;
+  }
+  xSemaphoreGiveFromISR(ready, &woken);
+}
@@ -0,0 +1,53 @@
+#include "Calibration.h"
+
+#define DEFAULT_VREF_MV 1100 // only used if the chip has no eFuse calibration
+
+void AdcCalibration::begin() {
+  esp_adc_cal_characteristics_t characteristics;
+  calSource = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, DEFAULT_VREF_MV, &characteristics);
+
+  for (uint32_t counts = 0; counts < CAL_TABLE_SIZE; counts++) {
+    table[counts] = esp_adc_cal_raw_to_voltage(counts, &characteristics);
+  }
+}
+
+const char *AdcCalibration::source() const {
+  switch (calSource) {
+    case ESP_ADC_CAL_VAL_EFUSE_TP:
+      return "eFuse two point";
+    case ESP_ADC_CAL_VAL_EFUSE_VREF:
+      return "eFuse Vref";
+    case ESP_ADC_CAL_VAL_EFUSE_TP_FIT:
+      return "eFuse two point, curve fit";
+    default:
+      return "default Vref";
+  }
+}
+
+void FieldCalibration::begin(const AdcCalibration &adc, float zeroFieldMv, float mvPerGauss) {
+  adcCal = &adc;
+  zeroMv = zeroFieldMv;
+  sensitivity = mvPerGauss;
+  build();
+}
+
+void FieldCalibration::setZeroField(float zeroFieldMv) {
+  if (adcCal == nullptr) {
+    return;
+  }
+  zeroMv = zeroFieldMv;
+  build();
+}
+
+void FieldCalibration::build() {
+  float deciGaussPerMv = 10.0f / sensitivity;
+  int16_t *spare = active.load(std::memory_order_relaxed) == tables[0] ? tables[1] : tables[0];
+
+  for (uint32_t counts = 0; counts < CAL_TABLE_SIZE; counts++) {
+    float field = (adcCal->millivolts(counts) - zeroMv) * deciGaussPerMv;
+    if (field > INT16_MAX) field = INT16_MAX;
+    if (field < INT16_MIN) field = INT16_MIN;
+    spare[counts] = (int16_t)lroundf(field);
+  }
+  active.store(spare, std::memory_order_release);
+}
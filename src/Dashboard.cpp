@@ -0,0 +1,113 @@
+#include "Dashboard.h"
+#include <ESPAsyncWebServer.h>
+#include "DashboardPage.h"
+
+#define SAMPLE_BYTES(channels) (6 + 2 * (channels)) // time, field and the channels of one reading
+#define MESSAGE_BYTES (2 + (DASHBOARD_QUEUE - 1) * SAMPLE_BYTES(DASHBOARD_MAX_CHANNELS))
+
+bool Dashboard::begin(uint16_t port, uint8_t channels, const char *const *labels, uint16_t fullScaleGauss,
+                      uint8_t decimation, BaseType_t core, UBaseType_t priority) {
+  numChannels = channels < DASHBOARD_MAX_CHANNELS ? channels : DASHBOARD_MAX_CHANNELS;
+  keepEvery = decimation > 0 ? decimation : 1;
+
+  // Greeting for each page: which unit this is and how to label the chart
+  int length = snprintf(hello, sizeof(hello), "{\"device\":\"%08lx\",\"fullScale\":%u,\"labels\":[",
+                        (unsigned long)(uint32_t)ESP.getEfuseMac(), fullScaleGauss);
+  for (uint8_t ch = 0; ch < numChannels && length < (int)sizeof(hello); ch++) {
+    length += snprintf(hello + length, sizeof(hello) - length, "%s\"%s\"", ch ? "," : "", labels[ch]);
+  }
+  if (length < (int)sizeof(hello)) {
+    snprintf(hello + length, sizeof(hello) - length, "]}");
+  }
+
+  server = new AsyncWebServer(port);
+  socket = new AsyncWebSocket("/ws");
+
+  // The page is sent exactly as it is stored, the browser unzips it
+  server->on("/", HTTP_GET, [](AsyncWebServerRequest *request) {
+    AsyncWebServerResponse *response = request->beginResponse_P(200, "text/html", DASHBOARD_PAGE, sizeof(DASHBOARD_PAGE));
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("Cache-Control", "max-age=3600");
+    request->send(response);
+  });
+
+  // The client list is only touched in the AsyncTCP task, here and inside the library
+  socket->onEvent([this](AsyncWebSocket *ws, AsyncWebSocketClient *client, AwsEventType type, void *, uint8_t *, size_t) {
+    if (type == WS_EVT_CONNECT) {
+      ws->cleanupClients(DASHBOARD_MAX_CLIENTS);
+      client->text(hello);
+    }
+    if (type == WS_EVT_CONNECT || type == WS_EVT_DISCONNECT) {
+      connectedClients = ws->count();
+    }
+  });
+  server->addHandler(socket);
+  server->begin();
+
+  return xTaskCreatePinnedToCore(pushTask, "dashboard", 4096, this, priority, &taskHandle, core) == pdPASS;
+}
+
+void Dashboard::add(uint32_t nowMs, int16_t fieldDeciGauss, const uint16_t *channelValues) {
+  if (++offered < keepEvery) {
+    return;
+  }
+  offered = 0;
+
+  Sample *sample = samples.claim();
+  if (sample == nullptr) {
+    dropped++; // the push task has stalled, the readings in the queue are sent first
+    return;
+  }
+  sample->ms = nowMs;
+  sample->field = fieldDeciGauss;
+  memcpy(sample->channels, channelValues, numChannels * sizeof(uint16_t));
+  samples.publish();
+}
+
+size_t Dashboard::encode(uint8_t *out) {
+  // Little-endian, as read by the page's DataView
+  uint8_t count = 0;
+  size_t length = 2;
+  const Sample *sample;
+  while ((sample = samples.front()) != nullptr) {
+    memcpy(out + length, &sample->ms, 4);
+    memcpy(out + length + 4, &sample->field, 2);
+    memcpy(out + length + 6, sample->channels, 2 * numChannels);
+    length += SAMPLE_BYTES(numChannels);
+    count++;
+    samples.release();
+  }
+
+  out[0] = count;
+  out[1] = numChannels;
+  return count > 0 ? length : 0;
+}
+
+void Dashboard::pushTask(void *parameter) {
+  Dashboard *self = (Dashboard *)parameter;
+  static uint8_t message[MESSAGE_BYTES];
+  TickType_t lastWake = xTaskGetTickCount();
+
+  for (;;) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(DASHBOARD_FRAME_MS));
+
+    // Everything since the last frame goes in one message (read even with no clients, so the queue keeps moving)
+    size_t length = self->encode(message);
+    if (length == 0 || self->connectedClients == 0) {
+      continue;
+    }
+
+    // One shared buffer queued to every client by the library, which walks its client list under its own lock.
+    // A client still working through earlier frames misses this one instead of holding up the rest.
+    AsyncWebSocketMessageBuffer *buffer = self->socket->makeBuffer(message, length);
+    if (buffer == nullptr) {
+      self->skipped++; // out of memory, try again with the next frame
+      continue;
+    }
+    if (!self->socket->availableForWriteAll()) {
+      self->missed++; // still sent, the clients with room get it
+    }
+    self->socket->binaryAll(buffer);
+    self->sent++;
+  }
+}
@@ -0,0 +1,265 @@
+#include "DataLogger.h"
+#include <SD.h>
+#include <SPI.h>
+#include <rom/crc.h>
+
+#define PAGE_MAGIC 0x31474C4B // "KLG1", change when the page or record layout changes
+#define PAGES_PER_BLOCK (LOG_BLOCK_BYTES / LOG_PAGE_BYTES)
+#define RECORD_HEADER_BYTES 6 // type, size, timeMs
+
+static_assert(LOG_BLOCK_BYTES % LOG_PAGE_BYTES == 0, "pages must tile the blocks");
+
+bool DataLogger::begin(const LogConfig &config, BaseType_t core, UBaseType_t priority) {
+  settings = config;
+
+  // An SD card if there is one, with the ring in a file that is opened for overwriting in place
+  if (config.useSd) {
+    SPI.begin(config.sdSck, config.sdMiso, config.sdMosi, config.sdCs);
+    if (SD.begin(config.sdCs, SPI)) {
+      if (!SD.exists(LOG_FILE)) {
+        SD.open(LOG_FILE, FILE_WRITE).close();
+      }
+      file = SD.open(LOG_FILE, "r+");
+      if (file) {
+        storage = LOG_SD;
+        pageCount = config.sdBytes / LOG_BLOCK_BYTES * PAGES_PER_BLOCK;
+      }
+    }
+  }
+
+  // Otherwise the SPIFFS partition, after whatever else is kept there
+  if (storage == LOG_NONE) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+    if (partition != nullptr && partition->size >= config.flashStart + LOG_BLOCK_BYTES) {
+      storage = LOG_FLASH;
+      pageCount = (partition->size - config.flashStart) / LOG_BLOCK_BYTES * PAGES_PER_BLOCK;
+    }
+  }
+
+  if (storage == LOG_NONE || pageCount == 0) {
+    storage = LOG_NONE;
+    return false;
+  }
+  return xTaskCreatePinnedToCore(writerTask, "logger", 4096, this, priority, &taskHandle, core) == pdPASS;
+}
+
+void DataLogger::logReading(uint32_t nowMs, int16_t field, const uint16_t *channels, uint8_t count) {
+  if (count > LOG_MAX_CHANNELS) {
+    count = LOG_MAX_CHANNELS;
+  }
+  uint8_t payload[sizeof(int16_t) + LOG_MAX_CHANNELS * sizeof(uint16_t)];
+  memcpy(payload, &field, sizeof(field));
+  memcpy(payload + sizeof(field), channels, count * sizeof(uint16_t));
+  addRecord(nowMs, LOG_READING, payload, sizeof(field) + count * sizeof(uint16_t));
+}
+
+void DataLogger::logEvent(uint32_t nowMs, LogEventCode event, int32_t value) {
+  uint8_t payload[sizeof(uint16_t) + sizeof(int32_t)];
+  uint16_t code = event;
+  memcpy(payload, &code, sizeof(code));
+  memcpy(payload + sizeof(code), &value, sizeof(value));
+  addRecord(nowMs, LOG_EVENT, payload, sizeof(payload));
+}
+
+void DataLogger::requestExport(Print &port) {
+  exportPort = &port;
+  xTaskNotifyGive(taskHandle);
+}
+
+void DataLogger::addRecord(uint32_t nowMs, LogRecordType type, const void *payload, uint8_t length) {
+  uint8_t size = RECORD_HEADER_BYTES + length;
+
+  // A full page, or one that has waited long enough, goes to the writer before the new record starts the next one
+  if (filling != nullptr && (used + size > LOG_PAGE_BYTES || nowMs - pageOpenedMs >= settings.flushMs)) {
+    closePage();
+  }
+  if (filling == nullptr) {
+    filling = pool.claim();
+    if (filling == nullptr) {
+      dropped++; // every page is still waiting to be written
+      return;
+    }
+    memset(filling->bytes, 0xFF, LOG_PAGE_BYTES); // the header is filled in by the writer
+    used = sizeof(PageHeader);
+    pageOpenedMs = nowMs;
+  }
+
+  uint8_t *out = filling->bytes + used;
+  out[0] = type;
+  out[1] = size;
+  memcpy(out + 2, &nowMs, sizeof(nowMs));
+  memcpy(out + RECORD_HEADER_BYTES, payload, length);
+  used += size;
+}
+
+void DataLogger::closePage() {
+  filling = nullptr;
+  pool.publish();
+  xTaskNotifyGive(taskHandle);
+}
+
+void DataLogger::writerTask(void *parameter) {
+  DataLogger *self = (DataLogger *)parameter;
+  self->recover();
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // woken by a finished page or an export request
+
+    LogPage *page;
+    while ((page = self->pool.front()) != nullptr) {
+      self->writePage(*page);
+      self->pool.release();
+    }
+
+    Print *port = self->exportPort;
+    if (port != nullptr) {
+      self->exportPages(*port);
+      self->exportPort = nullptr;
+    }
+  }
+}
+
+// Find the newest page that passes its check and carry on after it
+void DataLogger::recover() {
+  uint32_t blocks = pageCount / PAGES_PER_BLOCK;
+  PageHeader header;
+  bool found = false;
+  uint32_t newest = 0;
+  uint32_t newestBlock = 0;
+
+  // The blocks are written in order, so the newest one starts with the highest sequence number
+  for (uint32_t block = 0; block < blocks; block++) {
+    if (!pageValid(block * PAGES_PER_BLOCK, header)) {
+      continue;
+    }
+    if (header.wear > highestWear) {
+      highestWear = header.wear;
+    }
+    if (!found || header.sequence > newest) {
+      found = true;
+      newest = header.sequence;
+      newestBlock = block;
+      blockWear = header.wear;
+    }
+  }
+  if (!found) {
+    nextSequence = 0; // a new log
+    return;
+  }
+
+  // Then the pages that follow it in that block
+  uint32_t first = newestBlock * PAGES_PER_BLOCK;
+  for (uint32_t index = first + 1; index < first + PAGES_PER_BLOCK; index++) {
+    if (!pageValid(index, header) || header.sequence != newest + 1) {
+      break;
+    }
+    newest = header.sequence;
+  }
+  nextSequence = newest + 1;
+
+  // Flash can only be written where it is erased, so if anything was left in the rest of the block (a page cut short)
+  // the log goes on from the next block instead
+  uint32_t index = nextSequence % pageCount;
+  uint32_t rest = PAGES_PER_BLOCK - index % PAGES_PER_BLOCK;
+  if (storage == LOG_FLASH && rest < PAGES_PER_BLOCK) {
+    bool erased = readRegion(index * LOG_PAGE_BYTES, transfer, rest * LOG_PAGE_BYTES);
+    for (size_t i = 0; erased && i < rest * LOG_PAGE_BYTES; i++) {
+      erased = transfer[i] == 0xFF;
+    }
+    if (!erased) {
+      nextSequence += rest;
+    }
+  }
+}
+
+bool DataLogger::pageValid(uint32_t index, PageHeader &header) {
+  if (!readRegion(index * LOG_PAGE_BYTES, transfer, LOG_PAGE_BYTES)) {
+    return false;
+  }
+  memcpy(&header, transfer, sizeof(header));
+  return header.magic == PAGE_MAGIC && header.sequence % pageCount == index && header.crc == pageCrc(transfer);
+}
+
+void DataLogger::writePage(LogPage &page) {
+  uint32_t index = nextSequence % pageCount;
+  uint32_t offset = index * LOG_PAGE_BYTES;
+
+  // Starting a block: erase it, one more cycle than the last time round (or as many as the most worn block, if what
+  // was there can't be read)
+  if (index % PAGES_PER_BLOCK == 0) {
+    PageHeader old;
+    bool known = readRegion(offset, &old, sizeof(old)) && old.magic == PAGE_MAGIC && old.sequence % pageCount == index;
+    blockWear = known ? old.wear + 1 : highestWear > 0 ? (uint32_t)highestWear : 1;
+    if (blockWear > highestWear) {
+      highestWear = blockWear;
+    }
+    if (!eraseBlock(offset)) {
+      errors++;
+    }
+  }
+
+  PageHeader header = {PAGE_MAGIC, nextSequence, blockWear, 0};
+  memcpy(page.bytes, &header, sizeof(header));
+  header.crc = pageCrc(page.bytes);
+  memcpy(page.bytes, &header, sizeof(header));
+
+  if (writeRegion(offset, page.bytes, LOG_PAGE_BYTES)) {
+    written++;
+  } else {
+    errors++;
+  }
+  nextSequence++; // a page that failed is skipped, its check fails when read back
+}
+
+void DataLogger::exportPages(Print &port) {
+  uint32_t count = pagesUsed();
+  uint32_t index = nextSequence >= pageCount ? nextSequence % pageCount : 0; // the oldest page
+  port.printf("Log export: %lu pages of %u bytes\n", (unsigned long)count, LOG_PAGE_BYTES);
+
+  // As stored, up to a block at a time
+  for (uint32_t sent = 0; sent < count;) {
+    uint32_t pages = count - sent;
+    if (pages > PAGES_PER_BLOCK) pages = PAGES_PER_BLOCK;
+    if (pages > pageCount - index) pages = pageCount - index; // up to the end of the region, then from the start
+    size_t bytes = pages * LOG_PAGE_BYTES;
+    if (!readRegion(index * LOG_PAGE_BYTES, transfer, bytes)) {
+      memset(transfer, 0xFF, bytes); // keeps the framing, the host skips these pages
+    }
+    port.write(transfer, bytes);
+    sent += pages;
+    index = (index + pages) % pageCount;
+  }
+  port.println("Log export done");
+}
+
+bool DataLogger::readRegion(uint32_t offset, void *data, size_t length) {
+  if (storage == LOG_FLASH) {
+    return esp_partition_read(partition, settings.flashStart + offset, data, length) == ESP_OK;
+  }
+
+  // The file only grows as far as the log has got on its first lap: past the end reads as erased
+  size_t got = file.seek(offset) ? file.read((uint8_t *)data, length) : 0;
+  memset((uint8_t *)data + got, 0xFF, length - got);
+  return true;
+}
+
+bool DataLogger::writeRegion(uint32_t offset, const void *data, size_t length) {
+  if (storage == LOG_FLASH) {
+    return esp_partition_write(partition, settings.flashStart + offset, data, length) == ESP_OK;
+  }
+  bool ok = file.seek(offset) && file.write((const uint8_t *)data, length) == length;
+  file.flush(); // on the card before the next page, so a power loss costs at most the page being filled
+  return ok;
+}
+
+bool DataLogger::eraseBlock(uint32_t offset) {
+  if (storage == LOG_FLASH) {
+    return esp_partition_erase_range(partition, settings.flashStart + offset, LOG_BLOCK_BYTES) == ESP_OK;
+  }
+  return true; // a card is written over in place
+}
+
+uint32_t DataLogger::pageCrc(const uint8_t *page) {
+  uint32_t crc = crc32_le(0, page, offsetof(PageHeader, crc));
+  return crc32_le(crc, page + sizeof(PageHeader), LOG_PAGE_BYTES - sizeof(PageHeader));
+}
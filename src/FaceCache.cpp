@@ -0,0 +1,137 @@
+#include "FaceCache.h"
+
+#define FACE_MAGIC 0x46414332 // "FAC2", change when the layout or what is saved changes
+#define WRITE_RUNS 128        // runs encoded in RAM before each flash write
+#define SECTOR_BYTES 4096     // flash erase sector
+
+bool FaceCache::begin() {
+  partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+  if (partition != nullptr && partition->size < FACE_CACHE_SIZE) {
+    partition = nullptr;
+  }
+  return partition != nullptr;
+}
+
+bool FaceCache::load(uint32_t key, uint16_t *pixels, uint16_t width, uint16_t height) {
+  if (partition == nullptr) {
+    return false;
+  }
+
+  const void *mapped;
+  spi_flash_mmap_handle_t handle;
+  if (esp_partition_mmap(partition, 0, FACE_CACHE_SIZE, SPI_FLASH_MMAP_DATA, &mapped, &handle) != ESP_OK) {
+    return false;
+  }
+
+  const Header *header = (const Header *)mapped;
+  const Run *runs = (const Run *)(header + 1);
+  size_t maxRuns = (FACE_CACHE_SIZE - sizeof(Header)) / sizeof(Run);
+  bool valid = header->magic == FACE_MAGIC && header->key == key && header->width == width &&
+               header->height == height && header->runs <= maxRuns;
+
+  // Check the runs add up to the whole image before touching the frame buffer
+  size_t total = (size_t)width * height;
+  if (valid) {
+    size_t covered = 0;
+    for (uint32_t i = 0; i < header->runs; i++) {
+      covered += runs[i].length;
+    }
+    valid = covered == total;
+  }
+
+  if (valid) {
+    uint16_t *out = pixels;
+    for (uint32_t i = 0; i < header->runs; i++) {
+      uint16_t colour = runs[i].colour;
+      for (uint16_t n = runs[i].length; n > 0; n--) {
+        *out++ = colour;
+      }
+    }
+  }
+
+  spi_flash_munmap(handle);
+  return valid;
+}
+
+bool FaceCache::holds(uint32_t key, uint16_t width, uint16_t height) {
+  Header header;
+  return partition != nullptr && esp_partition_read(partition, 0, &header, sizeof(header)) == ESP_OK &&
+         header.magic == FACE_MAGIC && header.key == key && header.width == width && header.height == height;
+}
+
+// Number of runs store() encodes the image in (the same split into runs of at most UINT16_MAX pixels)
+static uint32_t countRuns(const uint16_t *pixels, size_t total) {
+  uint32_t runs = 0;
+  size_t i = 0;
+  while (i < total) {
+    size_t start = i;
+    while (i < total && pixels[i] == pixels[start] && i - start < UINT16_MAX) {
+      i++;
+    }
+    runs++;
+  }
+  return runs;
+}
+
+bool FaceCache::store(uint32_t key, const uint16_t *pixels, uint16_t width, uint16_t height) {
+  if (partition == nullptr) {
+    return false;
+  }
+
+  // Only the sectors the image will take are erased (each one stalls both cores)
+  size_t bytes = sizeof(Header) + countRuns(pixels, (size_t)width * height) * sizeof(Run);
+  size_t erase = (bytes + SECTOR_BYTES - 1) / SECTOR_BYTES * SECTOR_BYTES;
+  if (erase > FACE_CACHE_SIZE || esp_partition_erase_range(partition, 0, erase) != ESP_OK) {
+    return false;
+  }
+
+  // Encode and write the runs a batch at a time, behind the space for the header
+  Run batch[WRITE_RUNS];
+  size_t batched = 0;
+  size_t offset = sizeof(Header);
+  uint32_t runCount = 0;
+  size_t total = (size_t)width * height;
+
+  auto flush = [&]() {
+    size_t bytes = batched * sizeof(Run);
+    if (offset + bytes > FACE_CACHE_SIZE || esp_partition_write(partition, offset, batch, bytes) != ESP_OK) {
+      return false;
+    }
+    offset += bytes;
+    batched = 0;
+    return true;
+  };
+
+  size_t i = 0;
+  while (i < total) {
+    uint16_t colour = pixels[i];
+    size_t start = i;
+    while (i < total && pixels[i] == colour && i - start < UINT16_MAX) {
+      i++;
+    }
+
+    batch[batched].length = i - start;
+    batch[batched].colour = colour;
+    batched++;
+    runCount++;
+    if (batched == WRITE_RUNS && !flush()) {
+      return false;
+    }
+  }
+  if (batched > 0 && !flush()) {
+    return false;
+  }
+
+  // The header makes the image valid, so it goes in last
+  Header header = {FACE_MAGIC, key, width, height, runCount};
+  return esp_partition_write(partition, 0, &header, sizeof(header)) == ESP_OK;
+}
+
+uint32_t FaceCache::hash(const char *description) {
+  uint32_t h = 2166136261u;
+  for (const char *c = description; *c != '\0'; c++) {
+    h ^= (uint8_t)*c;
+    h *= 16777619u;
+  }
+  return h;
+}
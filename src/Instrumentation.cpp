@@ -0,0 +1,44 @@
+#include "Instrumentation.h"
+
+bool Instrumentation::poll(uint32_t nowMs, uint32_t periodMs, InstrumentReport &report) {
+  uint32_t elapsed = nowMs - windowStart;
+  if (elapsed < periodMs) {
+    return false;
+  }
+
+  float cyclesPerUs = ESP.getCpuFreqMHz();
+  report.windowMs = elapsed;
+
+  // The writers put their worst cases in the other slot from now on
+  uint32_t ended = window.load(std::memory_order_relaxed);
+  window.store(ended + 1, std::memory_order_release);
+
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    StageCounter &c = stages[i];
+    uint32_t calls = c.calls.load(std::memory_order_relaxed);
+    uint32_t cycles = c.cycles.load(std::memory_order_relaxed);
+
+    report.calls[i] = calls - lastCalls[i];
+    report.meanUs[i] = report.calls[i] ? (uint32_t)(cycles - lastCycles[i]) / (float)report.calls[i] / cyclesPerUs : 0;
+    // A stage with no calls in the window never started its slot afresh, so it has no worst case either
+    report.maxUs[i] = report.calls[i] ? c.maxCycles[ended & 1].load(std::memory_order_relaxed) / cyclesPerUs : 0;
+
+    lastCalls[i] = calls;
+    lastCycles[i] = cycles;
+  }
+
+  uint32_t total = samples.load(std::memory_order_relaxed);
+  report.sampleRate = (total - lastSamples) * 1000.0f / elapsed;
+  report.framesPerSecond = report.calls[STAGE_FRAME] * 1000.0f / elapsed;
+  report.missedDeadlines = missed.load(std::memory_order_relaxed);
+  report.queueOverruns = overruns.load(std::memory_order_relaxed);
+  lastSamples = total;
+
+  uint32_t sleptTotal = sleepUs.load(std::memory_order_relaxed);
+  float asleep = (uint32_t)(sleptTotal - lastSleepUs) / (elapsed * 1000.0f);
+  report.dutyCycle = asleep < 1 ? 1 - asleep : 0;
+  lastSleepUs = sleptTotal;
+
+  windowStart = nowMs;
+  return true;
+}
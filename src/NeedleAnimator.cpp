@@ -0,0 +1,28 @@
+#include "NeedleAnimator.h"
+
+#define SETTLE_TIME_CONSTANTS 8 // beyond this the remaining motion is far below one needle step
+
+void NeedleAnimator::begin(float timeConstantMs, float value) {
+  omega = 1000.0f / (timeConstantMs > 0 ? timeConstantMs : 1);
+  position = value;
+  velocity = 0;
+}
+
+float NeedleAnimator::update(float target, uint32_t elapsedUs) {
+  float t = elapsedUs * 1e-6f;
+  if (omega * t >= SETTLE_TIME_CONSTANTS) {
+    position = target;
+    velocity = 0;
+    return position;
+  }
+
+  // Critically damped spring, x'' = -2w x' - w^2 (x - target), solved exactly over t:
+  //   e(t) = (e0 + (v0 + w e0) t) exp(-w t)
+  //   v(t) = (v0 - w (v0 + w e0) t) exp(-w t)
+  float error = position - target;
+  float k = velocity + omega * error;
+  float decay = expf(-omega * t);
+  position = target + (error + k * t) * decay;
+  velocity = (velocity - omega * k * t) * decay;
+  return position;
+}
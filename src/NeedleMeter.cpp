@@ -0,0 +1,147 @@
+#include "NeedleMeter.h"
+
+NeedleMeter::GeometryEntry NeedleMeter::geometry[NEEDLE_HALF_SWEEP + 1];
+bool NeedleMeter::geometryReady = false;
+
+NeedleMeter::NeedleMeter(TFT_eSPI *tft) : display(tft), face(tft) {}
+
+void NeedleMeter::buildGeometry() {
+  if (geometryReady) {
+    return;
+  }
+
+  for (int d = 0; d <= NEEDLE_HALF_SWEEP; d++) {
+    float rad = d * 0.0174532925f;
+    geometry[d].tipDx = (uint8_t)lroundf(98 * sinf(rad));
+    geometry[d].tipDy = (uint8_t)lroundf(98 * cosf(rad));
+    geometry[d].baseDx = (uint8_t)lroundf(24 * tanf(rad));
+  }
+  geometryReady = true;
+}
+
+NeedleMeter::Needle NeedleMeter::needleAt(int position) {
+  // Position 50 is vertical, each step either side is one degree
+  int d = position - 50;
+  const GeometryEntry &g = geometry[d < 0 ? -d : d];
+
+  Needle needle;
+  needle.baseX = d < 0 ? 120 - g.baseDx : 120 + g.baseDx;
+  needle.tipX = d < 0 ? 120 - g.tipDx : 120 + g.tipDx;
+  needle.tipY = 150 - g.tipDy;
+  return needle;
+}
+
+void NeedleMeter::setZones(uint16_t rs, uint16_t re, uint16_t os, uint16_t oe, uint16_t ys, uint16_t ye, uint16_t gs,
+                           uint16_t ge) {
+  face.setZones(rs, re, os, oe, ys, ye, gs, ge);
+}
+
+void NeedleMeter::analogMeter(uint16_t x, uint16_t y, float fullScale, const char *units, const char *s0,
+                              const char *s1, const char *s2, const char *s3, const char *s4) {
+  face.analogMeter(x, y, fullScale, units, s0, s1, s2, s3, s4);
+  attachFace(x, y, fullScale, units);
+}
+
+void NeedleMeter::attachFace(uint16_t x, uint16_t y, float fullScale, const char *units) {
+  buildGeometry();
+
+  mx = x;
+  my = y;
+  scale = fullScale;
+  label = units;
+
+  // MeterWidget finishes the face by drawing its own needle at 0, so remember exactly where it put it
+  // (same maths as MeterWidget::updateNeedle()) so the first update can erase it
+  float sdeg = -140 * 0.0174532925f; // position 0
+  shownPosition = 0;
+  markerShown[0] = markerShown[1] = MARKER_NONE; // the new face has no markers on it
+  shown.baseX = (int16_t)(mx + 120 + 24 * tanf(sdeg + 90 * 0.0174532925f)) - mx;
+  shown.tipX = (uint16_t)(98 * cosf(sdeg) + 120);
+  shown.tipY = (uint16_t)(98 * sinf(sdeg) + 150);
+}
+
+int NeedleMeter::position(float value) const {
+  int pos = (int)(value * 100.0f / scale);
+  if (pos < -10) pos = -10; // limit value to emulate needle end stops
+  if (pos > 110) pos = 110;
+  return pos;
+}
+
+bool NeedleMeter::updateNeedle(float value) {
+  int pos = position(value);
+  bool markersMoved = markerWanted[0] != markerShown[0] || markerWanted[1] != markerShown[1];
+  if (pos == shownPosition && !markersMoved) {
+    return false;
+  }
+
+  // Erase the old needle, then re-plot the text under it
+  removeNeedle();
+
+  // Move the markers (erasing one can nick the needle, which is drawn next anyway)
+  for (int i = 0; i < 2; i++) {
+    if (markerShown[i] != markerWanted[i]) {
+      drawMarker(markerShown[i], TFT_WHITE);
+      markerShown[i] = markerWanted[i];
+    }
+  }
+  for (int i = 0; i < 2; i++) {
+    drawMarker(markerShown[i], MARKER_COLOR); // the old needle may have crossed the one that stayed put
+  }
+
+  // Draw the needle in the new position
+  shown = needleAt(pos);
+  shownPosition = pos;
+  drawNeedle(shown, TFT_RED, TFT_MAGENTA);
+  return true;
+}
+
+void NeedleMeter::removeNeedle() {
+  if (shownPosition == NEEDLE_HIDDEN) {
+    return;
+  }
+  drawNeedle(shown, TFT_WHITE, TFT_WHITE);
+  display->setTextColor(TFT_BLACK, TFT_WHITE);
+  display->drawCentreString(label, mx + 120, my + 70, 4);
+  shownPosition = NEEDLE_HIDDEN;
+}
+
+void NeedleMeter::setMarkers(float low, float high) {
+  markerWanted[0] = position(low);
+  markerWanted[1] = position(high);
+}
+
+void NeedleMeter::clearMarkers() {
+  markerWanted[0] = markerWanted[1] = MARKER_NONE;
+}
+
+void NeedleMeter::drawMarker(int position, uint16_t color) {
+  if (position == MARKER_NONE) {
+    return;
+  }
+
+  // Small triangle with its base 2 degrees either side of the position at the needle tip's radius and its
+  // point 10 pixels nearer the pivot (inside the scale, where the face is plain white)
+  auto corner = [&](int pos, int radius, int32_t &x, int32_t &y) {
+    if (pos < -10) pos = -10;
+    if (pos > 110) pos = 110;
+    int d = pos - 50;
+    const GeometryEntry &g = geometry[d < 0 ? -d : d];
+    int32_t dx = g.tipDx * radius / 98;
+    x = mx + (d < 0 ? 120 - dx : 120 + dx);
+    y = my + 150 - g.tipDy * radius / 98;
+  };
+
+  int32_t x0, y0, x1, y1, x2, y2;
+  corner(position, 88, x0, y0);
+  corner(position - 2, 98, x1, y1);
+  corner(position + 2, 98, x2, y2);
+  display->fillTriangle(x0, y0, x1, y1, x2, y2, color);
+}
+
+void NeedleMeter::drawNeedle(const Needle &needle, uint16_t sideColor, uint16_t centreColor) {
+  // Three lines side by side to thicken the needle
+  int32_t baseY = my + 150 - 24;
+  display->drawLine(mx + needle.baseX - 1, baseY, mx + needle.tipX - 1, my + needle.tipY, sideColor);
+  display->drawLine(mx + needle.baseX, baseY, mx + needle.tipX, my + needle.tipY, centreColor);
+  display->drawLine(mx + needle.baseX + 1, baseY, mx + needle.tipX + 1, my + needle.tipY, sideColor);
+}
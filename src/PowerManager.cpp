@@ -0,0 +1,73 @@
+#include "PowerManager.h"
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+
+#define BACKLIGHT_TIMER LEDC_TIMER_3
+#define BACKLIGHT_CHANNEL LEDC_CHANNEL_7
+#define BACKLIGHT_PWM_HZ 2000
+
+void PowerManager::begin(uint8_t wakePin) {
+  wakeGpio = wakePin;
+
+  pinMode(LCD_POWER_PIN, OUTPUT);
+  digitalWrite(LCD_POWER_PIN, HIGH);
+}
+
+void PowerManager::attachBacklight() {
+  // PWM on the RTC 8MHz clock (not the APB clock, which stops in light sleep)
+  ledc_timer_config_t timer = {};
+  timer.speed_mode = LEDC_LOW_SPEED_MODE;
+  timer.duty_resolution = LEDC_TIMER_8_BIT;
+  timer.timer_num = BACKLIGHT_TIMER;
+  timer.freq_hz = BACKLIGHT_PWM_HZ;
+  timer.clk_cfg = LEDC_USE_RTC8M_CLK;
+  ledc_timer_config(&timer);
+
+  ledc_channel_config_t channel = {};
+  channel.gpio_num = BACKLIGHT_PIN;
+  channel.speed_mode = LEDC_LOW_SPEED_MODE;
+  channel.channel = BACKLIGHT_CHANNEL;
+  channel.intr_type = LEDC_INTR_DISABLE;
+  channel.timer_sel = BACKLIGHT_TIMER;
+  channel.duty = BACKLIGHT_FULL;
+  channel.hpoint = 0;
+  ledc_channel_config(&channel);
+
+  esp_sleep_pd_config(ESP_PD_DOMAIN_RTC8M, ESP_PD_OPTION_ON);
+}
+
+void PowerManager::setBacklight(uint8_t level) {
+  ledc_set_duty(LEDC_LOW_SPEED_MODE, BACKLIGHT_CHANNEL, level);
+  ledc_update_duty(LEDC_LOW_SPEED_MODE, BACKLIGHT_CHANNEL);
+}
+
+void PowerManager::enterLowPower(uint8_t dimLevel) {
+  setBacklight(dimLevel);
+  setCpuFrequencyMhz(LOW_POWER_CPU_MHZ);
+  isLow.store(true, std::memory_order_release);
+}
+
+void PowerManager::exitLowPower() {
+  setCpuFrequencyMhz(FULL_POWER_CPU_MHZ);
+  setBacklight(BACKLIGHT_FULL);
+  isLow.store(false, std::memory_order_release);
+}
+
+uint32_t PowerManager::sleep(uint32_t ms, bool light) {
+  int64_t start = esp_timer_get_time(); // keeps counting through a light sleep
+
+  pinWake = false;
+  if (light) {
+    esp_sleep_enable_timer_wakeup((uint64_t)ms * 1000);
+    gpio_wakeup_enable((gpio_num_t)wakeGpio, GPIO_INTR_LOW_LEVEL);
+    esp_sleep_enable_gpio_wakeup();
+    esp_light_sleep_start();
+    pinWake = esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_GPIO;
+    gpio_wakeup_disable((gpio_num_t)wakeGpio);
+  } else {
+    vTaskDelay(pdMS_TO_TICKS(ms));
+  }
+
+  return (uint32_t)(esp_timer_get_time() - start);
+}
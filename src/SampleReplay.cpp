@@ -0,0 +1,89 @@
+#include "SampleReplay.h"
+#include <rom/crc.h>
+
+#define MICRO 1000000ull
+
+void SampleReplay::load(const uint16_t *samples, uint32_t count, uint8_t channels, uint32_t sampleRateHz) {
+  recording = samples;
+  numChannels = channels;
+  rateHz = sampleRateHz;
+  blockSize = channels > 0 ? ADC_BLOCK_SAMPLES - ADC_BLOCK_SAMPLES % channels : 0;
+  length = blockSize > 0 ? count - count % blockSize : 0; // a pass is whole blocks, so every pass splits the same
+  position = 0;
+}
+
+bool SampleReplay::begin(const adc1_channel_t *channels, uint8_t count, uint32_t sampleRateHz) {
+  (void)channels;
+  (void)sampleRateHz;
+  if (recording == nullptr || length == 0 || count != numChannels) {
+    return false;
+  }
+  credit = 0;
+  lastUs = micros();
+  isRunning = true;
+  return true;
+}
+
+void SampleReplay::end() {
+  isRunning = false;
+}
+
+size_t SampleReplay::readBlock(uint16_t *samples, size_t maxSamples, uint32_t timeoutMs) {
+  if (!isRunning || maxSamples < blockSize) {
+    return 0;
+  }
+
+  uint32_t startMs = millis();
+  for (;;) {
+    uint32_t now = micros();
+    credit += (uint64_t)(now - lastUs) * rateHz;
+    lastUs = now;
+
+    // Like the DMA ring, only so many blocks can be waiting (but here the recording plays on late rather than skip)
+    uint64_t ring = (uint64_t)ADC_RING_BLOCKS * blockSize * MICRO;
+    if (credit > ring) {
+      credit = ring;
+      overruns++;
+    }
+    if (credit >= blockSize * MICRO) {
+      break;
+    }
+    if (millis() - startMs >= timeoutMs) {
+      return 0;
+    }
+    vTaskDelay(1);
+  }
+  credit -= blockSize * MICRO;
+
+  memcpy(samples, recording + position, blockSize * sizeof(uint16_t));
+  position += blockSize;
+  if (position >= length) {
+    position = 0;
+    passEnded = true; // reported once the pipeline has recorded this block
+  }
+  return blockSize;
+}
+
+void SampleReplay::record(const void *values, size_t bytes, uint32_t processUs) {
+  digest = crc32_le(digest, (const uint8_t *)values, bytes);
+  totalUs += processUs;
+  blocks++;
+  if (processUs > maxUs) {
+    maxUs = processUs;
+  }
+  if (!passEnded) {
+    return;
+  }
+
+  // Dropped if nobody is taking the reports (the next pass starts afresh either way)
+  ReplayPass pass = {++passNumber, length, digest, blocks > 0 ? (float)totalUs / blocks : 0, maxUs,
+                     overruns - passStartOverruns};
+  passes.push(pass);
+
+  passEnded = false;
+  digest = 0;
+  totalUs = 0;
+  blocks = 0;
+  maxUs = 0;
+  passStartOverruns = overruns;
+}
@@ -0,0 +1,180 @@
+#include "Settings.h"
+#include <Preferences.h>
+#include <stddef.h>
+#include "Filters.h"
+
+#define SETTINGS_NAMESPACE "ky035"
+
+#define FIELD(member, low, high) {#member, offsetof(Settings, member), sizeof(Settings::member), low, high}
+#define FIELD_AT(member, index, low, high) \
+  {#member #index, offsetof(Settings, member) + index * sizeof(Settings::member[0]), sizeof(Settings::member[0]), low, high}
+
+static_assert(SETTING_ZERO_CHANNELS == 4, "list every zeroDeciMv entry in the fields");
+
+// Everything that can be changed, with the values each field may take
+const SettingsStore::Field SettingsStore::fields[] = {
+    FIELD(loopPeriodMs, 1, 1000),
+    FIELD(filterType, FILTER_NONE, FILTER_IIR),
+    FIELD(boxcarLength, 1, SETTING_BOXCAR_MAX),
+    FIELD(iirShift, 1, 12),
+    FIELD(spikeRejection, 0, 1),
+    FIELD(deadband, 0, 4095),
+    FIELD(triggerLevel, 0, 4095),
+    FIELD(triggerHysteresis, 0, 4095),
+    FIELD(displayMinPeriodMs, 5, 1000),
+    FIELD(displayMaxPeriodMs, 5, 5000),
+    FIELD(telemetryPeriodMs, 100, 60000),
+    FIELD_AT(zeroDeciMv, 0, 0, 33000),
+    FIELD_AT(zeroDeciMv, 1, 0, 33000),
+    FIELD_AT(zeroDeciMv, 2, 0, 33000),
+    FIELD_AT(zeroDeciMv, 3, 0, 33000),
+    FIELD(redStart, 0, 100),
+    FIELD(redEnd, 0, 100),
+    FIELD(orangeStart, 0, 100),
+    FIELD(orangeEnd, 0, 100),
+    FIELD(yellowStart, 0, 100),
+    FIELD(yellowEnd, 0, 100),
+    FIELD(greenStart, 0, 100),
+    FIELD(greenEnd, 0, 100),
+};
+
+bool SettingsStore::begin(const Settings &defaults) {
+  defaultSettings = defaults;
+
+  Preferences prefs;
+  Settings stored;
+  bool loaded = prefs.begin(SETTINGS_NAMESPACE, true) && prefs.getUShort("version") == SETTINGS_VERSION &&
+                prefs.getBytesLength("settings") == sizeof(Settings) &&
+                prefs.getBytes("settings", &stored, sizeof(Settings)) == sizeof(Settings) && check(stored) == nullptr;
+  prefs.end();
+
+  slots[0] = loaded ? stored : defaults;
+  active.store(&slots[0], std::memory_order_release);
+  isPending = false;
+  return loaded;
+}
+
+const char *SettingsStore::set(const char *name, long value) {
+  for (const Field &field : fields) {
+    if (strcmp(field.name, name) != 0) {
+      continue;
+    }
+    if (value < field.min || value > field.max) {
+      return "out of range";
+    }
+
+    Settings next = isPending ? pending : current(); // not lose a change still waiting for a free copy
+    write(next, field, value);
+    return publish(next, true);
+  }
+  return "unknown setting";
+}
+
+const char *SettingsStore::restoreDefaults() {
+  Preferences prefs;
+  if (prefs.begin(SETTINGS_NAMESPACE, false)) {
+    prefs.clear();
+    prefs.end();
+  }
+  return publish(defaultSettings, false);
+}
+
+void SettingsStore::print(Print &out) const {
+  const Settings &settings = current();
+  for (const Field &field : fields) {
+    out.printf("%s = %lu (%u-%u)\n", field.name, (unsigned long)read(settings, field), field.min, field.max);
+  }
+}
+
+uint8_t SettingsStore::fieldCount() const {
+  return sizeof(fields) / sizeof(fields[0]);
+}
+
+const char *SettingsStore::fieldName(uint8_t index) const {
+  return index < fieldCount() ? fields[index].name : nullptr;
+}
+
+uint32_t SettingsStore::fieldValue(uint8_t index) const {
+  return index < fieldCount() ? read(current(), fields[index]) : 0;
+}
+
+void SettingsStore::fieldLimits(uint8_t index, uint16_t &min, uint16_t &max) const {
+  min = index < fieldCount() ? fields[index].min : 0;
+  max = index < fieldCount() ? fields[index].max : 0;
+}
+
+const char *SettingsStore::publish(const Settings &next, bool store) {
+  const char *problem = check(next);
+  if (problem != nullptr) {
+    return problem;
+  }
+
+  if (store) {
+    Preferences prefs;
+    bool saved = prefs.begin(SETTINGS_NAMESPACE, false) && prefs.putUShort("version", SETTINGS_VERSION) > 0 &&
+                 prefs.putBytes("settings", &next, sizeof(Settings)) == sizeof(Settings);
+    prefs.end();
+    if (!saved) {
+      return "could not save to NVS";
+    }
+  }
+
+  pending = next;
+  isPending = true;
+  applyPending();
+  return nullptr;
+}
+
+bool SettingsStore::applyPending() {
+  if (!isPending) {
+    return false;
+  }
+
+  // A copy is free once the reader has acknowledged the swap that retired it (the one in force never is)
+  uint32_t passed = acknowledged.load(std::memory_order_acquire);
+  Settings *inForce = active.load(std::memory_order_relaxed);
+  for (int i = 0; i < SETTINGS_SLOTS; i++) {
+    if (&slots[i] == inForce || (int32_t)(passed - retiredAt[i]) < 0) {
+      continue;
+    }
+    slots[i] = pending;
+    retiredAt[inForce - slots] = changes.load(std::memory_order_relaxed) + 1;
+    active.store(&slots[i], std::memory_order_release);
+    changes.fetch_add(1, std::memory_order_release);
+    isPending = false;
+    return true;
+  }
+  return false; // still being read, tried again on the next pass
+}
+
+const char *SettingsStore::check(const Settings &settings) {
+  for (const Field &field : fields) {
+    uint32_t value = read(settings, field);
+    if (value < field.min || value > field.max) {
+      return "out of range";
+    }
+  }
+
+  if (settings.displayMinPeriodMs > settings.displayMaxPeriodMs) {
+    return "displayMinPeriodMs must not be above displayMaxPeriodMs";
+  }
+  if (settings.redStart > settings.redEnd || settings.orangeStart > settings.orangeEnd ||
+      settings.yellowStart > settings.yellowEnd || settings.greenStart > settings.greenEnd) {
+    return "a zone must not start after it ends";
+  }
+  return nullptr;
+}
+
+uint32_t SettingsStore::read(const Settings &settings, const Field &field) {
+  // Fields are 1 or 2 bytes, unaligned in the packed struct (little-endian)
+  const uint8_t *bytes = (const uint8_t *)&settings + field.offset;
+  return field.size == 1 ? bytes[0] : bytes[0] | (bytes[1] << 8);
+}
+
+void SettingsStore::write(Settings &settings, const Field &field, uint32_t value) {
+  uint8_t *bytes = (uint8_t *)&settings + field.offset;
+  bytes[0] = value & 0xFF;
+  if (field.size == 2) {
+    bytes[1] = value >> 8;
+  }
+}
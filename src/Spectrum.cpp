@@ -0,0 +1,115 @@
+#include "Spectrum.h"
+#include <esp_dsp.h>
+
+#define HALF (SPECTRUM_SIZE / 2)              // complex points in the FFT, and bins in the spectrum
+#define BINS_PER_BAR (HALF / SPECTRUM_BARS)
+#define FIRST_PEAK_BIN 2                      // bins 0 and 1 hold the DC level leaking through the window
+#define MIN_PEAK_AMPLITUDE 0.5f               // counts, anything smaller is noise and reported as no peak
+
+static_assert((SPECTRUM_SIZE & (SPECTRUM_SIZE - 1)) == 0, "SPECTRUM_SIZE must be a power of two");
+static_assert(HALF % SPECTRUM_BARS == 0, "the bins must share out evenly between the bars");
+
+bool SpectrumAnalyzer::begin(uint32_t samplesPerSecond) {
+  binHz = (float)samplesPerSecond / SPECTRUM_DECIMATION / SPECTRUM_SIZE;
+  head = filled = fresh = 0;
+  ringSum = 0;
+  partialSum = 0;
+  partialCount = 0;
+
+  dsps_wind_hann_f32(window, SPECTRUM_SIZE);
+  for (int k = 0; k < HALF; k++) {
+    twiddle[2 * k] = cosf(2 * PI * k / SPECTRUM_SIZE);
+    twiddle[2 * k + 1] = sinf(2 * PI * k / SPECTRUM_SIZE);
+  }
+  return dsps_fft2r_init_fc32(nullptr, HALF) == ESP_OK;
+}
+
+void SpectrumAnalyzer::feed(const uint16_t *samples, size_t count, size_t stride) {
+  for (size_t i = 0; i < count; i += stride) {
+    partialSum += samples[i];
+    if (++partialCount < SPECTRUM_DECIMATION) {
+      continue;
+    }
+
+    // One more decimated sample replaces the oldest, and the running sum follows it
+    ringSum += partialSum;
+    if (filled == SPECTRUM_SIZE) {
+      ringSum -= ring[head];
+    } else {
+      filled++;
+    }
+    ring[head] = partialSum;
+    head = (head + 1) & (SPECTRUM_SIZE - 1);
+    partialSum = 0;
+    partialCount = 0;
+
+    if (++fresh >= SPECTRUM_HOP && filled == SPECTRUM_SIZE) {
+      fresh = 0;
+      SpectrumFrame *frame = frames.claim();
+      if (frame != nullptr) {
+        analyze(*frame);
+        frames.publish();
+      }
+    }
+  }
+}
+
+void SpectrumAnalyzer::analyze(SpectrumFrame &frame) {
+  // The window starts at the oldest sample. The DC level is taken out first so it doesn't leak into the low
+  // bins, and the sums are scaled back to counts.
+  float mean = (float)ringSum / SPECTRUM_SIZE;
+  for (uint32_t i = 0, j = head; i < SPECTRUM_SIZE; i++, j = (j + 1) & (SPECTRUM_SIZE - 1)) {
+    data[i] = ((float)ring[j] - mean) * window[i] * (1.0f / SPECTRUM_DECIMATION);
+  }
+
+  // The real samples, read as interleaved complex values, go through a half-size complex FFT
+  dsps_fft2r_fc32(data, HALF);
+  dsps_bit_rev_fc32(data, HALF);
+
+  // Split into the spectrum of the real signal: X[k] = E[k] + W^k O[k], from Z[k] and conj(Z[HALF - k])
+  for (int k = 0; k < HALF; k++) {
+    int m = (HALF - k) & (HALF - 1);
+    float a = data[2 * k], b = data[2 * k + 1];
+    float c = data[2 * m], d = data[2 * m + 1];
+    float evenRe = (a + c) * 0.5f, evenIm = (b - d) * 0.5f;
+    float oddRe = (b + d) * 0.5f, oddIm = (c - a) * 0.5f;
+    float cosine = twiddle[2 * k], sine = twiddle[2 * k + 1];
+    float re = evenRe + cosine * oddRe + sine * oddIm;
+    float im = evenIm + cosine * oddIm - sine * oddRe;
+    power[k] = re * re + im * im;
+  }
+
+  // Bars: the strongest bin under each one, as the amplitude of a sinusoid centred on that bin (the Hann
+  // window's gain is 1/2, so the amplitude is 4 |X| / N)
+  for (int bar = 0; bar < SPECTRUM_BARS; bar++) {
+    float strongest = 0;
+    for (int k = bar ? bar * BINS_PER_BAR : FIRST_PEAK_BIN; k < (bar + 1) * BINS_PER_BAR; k++) {
+      if (power[k] > strongest) strongest = power[k];
+    }
+    frame.bars[bar] = sqrtf(strongest) * (4.0f / SPECTRUM_SIZE);
+  }
+
+  int peak = FIRST_PEAK_BIN;
+  for (int k = FIRST_PEAK_BIN + 1; k < HALF - 2; k++) {
+    if (power[k] > power[peak]) peak = k;
+  }
+
+  // The Hann window spreads a sinusoid over 4 bins, summing them gives its power wherever it falls between
+  // bins (Parseval, with the window's sum of squares 3N/8)
+  float energy = 0;
+  for (int k = peak - 2; k <= peak + 2; k++) {
+    energy += power[k];
+  }
+  frame.peakAmplitude = sqrtf(energy * (32.0f / 3)) / SPECTRUM_SIZE;
+
+  // Parabola through the log power of the peak and its neighbours for the frequency between bins
+  float before = logf(power[peak - 1] + 1e-12f);
+  float centre = logf(power[peak] + 1e-12f);
+  float after = logf(power[peak + 1] + 1e-12f);
+  float curve = before - 2 * centre + after;
+  float offset = curve < 0 ? 0.5f * (before - after) / curve : 0;
+
+  frame.peakHz = frame.peakAmplitude >= MIN_PEAK_AMPLITUDE ? (peak + offset) * binHz : 0;
+  frame.binHz = binHz;
+  frame.mean = mean * (1.0f / SPECTRUM_DECIMATION);
+}
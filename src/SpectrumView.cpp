@@ -0,0 +1,96 @@
+#include "SpectrumView.h"
+
+#define SPECTRUM_BACKGROUND TFT_BLACK
+#define SPECTRUM_AXIS TFT_DARKGREY
+#define CAPTION_HEIGHT 18 // font 2 plus a gap
+#define AXIS_HEIGHT 10    // font 1 plus the axis line
+
+SpectrumView::SpectrumView(TFT_eSPI *tft) : display(tft) {}
+
+void SpectrumView::begin(int32_t x, int32_t y, int16_t w, int16_t h, float barHz) {
+  areaX = x;
+  areaY = y;
+  pitch = w / SPECTRUM_BARS > 1 ? w / SPECTRUM_BARS : 1;
+  width = pitch * SPECTRUM_BARS;
+  barsTop = y + CAPTION_HEIGHT;
+  barsHeight = h - CAPTION_HEIGHT - AXIS_HEIGHT;
+  hzPerBar = barHz;
+
+  reset();
+}
+
+void SpectrumView::drawBackground(TFT_eSPI &canvas, int32_t originX, int32_t originY) const {
+  int32_t x = areaX - originX;
+  int32_t axisY = barsTop + barsHeight - originY;
+  canvas.drawFastHLine(x, axisY, width, SPECTRUM_AXIS);
+
+  // Frequency labels at the ends and every quarter of the axis
+  uint8_t datum = canvas.getTextDatum();
+  canvas.setTextColor(SPECTRUM_AXIS, SPECTRUM_BACKGROUND);
+  for (int i = 0; i <= 4; i++) {
+    char label[12];
+    float hz = i * SPECTRUM_BARS * hzPerBar / 4;
+    snprintf(label, sizeof(label), i == 4 ? "%.0f Hz" : "%.0f", hz);
+    canvas.setTextDatum(i == 0 ? TL_DATUM : i == 4 ? TR_DATUM : TC_DATUM);
+    canvas.drawString(label, x + i * width / 4, axisY + 2, 1);
+  }
+  canvas.setTextDatum(datum);
+}
+
+void SpectrumView::reset() {
+  for (int16_t &height : shownHeight) {
+    height = 0;
+  }
+  shownPeakBar = -1;
+  shownCaption[0] = '\0';
+}
+
+int16_t SpectrumView::heightOf(float amplitude) const {
+  float db = amplitude > 0 ? 20 * log10f(amplitude) : SPECTRUM_FLOOR_DB;
+  int16_t height = (int16_t)((db - SPECTRUM_FLOOR_DB) * barsHeight / (SPECTRUM_TOP_DB - SPECTRUM_FLOOR_DB));
+  if (height < 0) height = 0; // clip at the ends of the scale
+  if (height > barsHeight) height = barsHeight;
+  return height;
+}
+
+// Redraw a whole bar: background above, colour below
+void SpectrumView::drawBar(int bar, int16_t height, uint16_t color) {
+  int32_t x = areaX + bar * pitch;
+  int16_t w = pitch > 1 ? pitch - 1 : 1; // a one pixel gap between bars
+  display->fillRect(x, barsTop, w, barsHeight - height, SPECTRUM_BACKGROUND);
+  display->fillRect(x, barsTop + barsHeight - height, w, height, color);
+}
+
+void SpectrumView::update(const SpectrumFrame &frame, const char *caption) {
+  int peakBar = frame.peakHz > 0 ? (int)(frame.peakHz / hzPerBar) : -1;
+  if (peakBar >= SPECTRUM_BARS) peakBar = SPECTRUM_BARS - 1;
+
+  int16_t w = pitch > 1 ? pitch - 1 : 1;
+  for (int bar = 0; bar < SPECTRUM_BARS; bar++) {
+    int16_t height = heightOf(frame.bars[bar]);
+    int16_t old = shownHeight[bar];
+    int32_t x = areaX + bar * pitch;
+    uint16_t color = bar == peakBar ? SPECTRUM_PEAK_COLOR : SPECTRUM_BAR_COLOR;
+
+    if ((bar == peakBar) != (bar == shownPeakBar)) {
+      drawBar(bar, height, color); // changed colour, repaint it all
+    } else if (height > old) {
+      display->fillRect(x, barsTop + barsHeight - height, w, height - old, color); // grow
+    } else if (height < old) {
+      display->fillRect(x, barsTop + barsHeight - old, w, old - height, SPECTRUM_BACKGROUND); // shrink
+    }
+    shownHeight[bar] = height;
+  }
+  shownPeakBar = peakBar;
+
+  if (strcmp(caption, shownCaption) != 0) {
+    uint8_t datum = display->getTextDatum();
+    display->setTextDatum(TL_DATUM);
+    display->setTextColor(TFT_WHITE, SPECTRUM_BACKGROUND);
+    display->setTextPadding(width);
+    display->drawString(caption, areaX, areaY, 2);
+    display->setTextPadding(0);
+    display->setTextDatum(datum);
+    snprintf(shownCaption, sizeof(shownCaption), "%s", caption);
+  }
+}
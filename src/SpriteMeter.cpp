@@ -0,0 +1,317 @@
+#include "SpriteMeter.h"
+
+#define PIVOT_X 120          // needle pivot in the meter (below the bottom edge)
+#define PIVOT_Y 150
+#define NEEDLE_BASE_Y 126    // the needle starts 24 pixels above the pivot
+#define NEEDLE_LENGTH 98
+#define NEEDLE_BASE_RADIUS 1.5f // half the width of the needle at the base and the tip
+#define NEEDLE_TIP_RADIUS 1.0f
+#define MARKER_INNER 88         // marker point and base radius (as drawn by NeedleMeter)
+#define MARKER_OUTER 98
+
+SpriteMeter::Direction SpriteMeter::directions[121];
+bool SpriteMeter::directionsReady = false;
+
+SpriteMeter::SpriteMeter(TFT_eSPI *tft) : display(tft), canvas(tft), meter(&canvas), readout(&canvas) {}
+
+bool SpriteMeter::begin(int32_t x, int32_t y) {
+  originX = x;
+  originY = y;
+  buildDirections();
+
+  const size_t bytes = SPRITE_METER_WIDTH * SPRITE_METER_HEIGHT * sizeof(uint16_t);
+  canvas.setColorDepth(16);
+  canvas.setAttribute(PSRAM_ENABLE, true);
+  bool allocated = canvas.createSprite(SPRITE_METER_WIDTH, SPRITE_METER_HEIGHT) != nullptr;
+  if (allocated) {
+    face = (uint16_t *)(psramFound() ? ps_malloc(bytes) : malloc(bytes));
+    patch = (uint16_t *)(psramFound() ? ps_malloc(bytes) : malloc(bytes));
+  }
+  if (!allocated || face == nullptr || patch == nullptr) {
+    free(face);
+    free(patch);
+    face = patch = nullptr;
+    canvas.deleteSprite();
+    return false;
+  }
+
+  // Same place on the face as the readout drawn directly on the panel
+  readout.begin(METER_READOUT_X, METER_READOUT_Y, METER_READOUT_CELLS, 2, TFT_BLACK, TFT_WHITE);
+
+  // Sprite buffers already hold the colours in the panel's byte order
+  display->setSwapBytes(false);
+  return display->initDMA();
+}
+
+void SpriteMeter::buildDirections() {
+  if (directionsReady) {
+    return;
+  }
+
+  // Position 50 is vertical, each step either side is one degree
+  for (int i = 0; i < 121; i++) {
+    float rad = (i - 10 - 50) * 0.0174532925f;
+    directions[i].sine = sinf(rad);
+    directions[i].cosine = cosf(rad);
+    directions[i].tangent = tanf(rad);
+  }
+  directionsReady = true;
+}
+
+const SpriteMeter::Direction &SpriteMeter::directionAt(int position) {
+  if (position < -10) position = -10;
+  if (position > 110) position = 110;
+  return directions[position + 10];
+}
+
+void SpriteMeter::setZones(uint16_t rs, uint16_t re, uint16_t os, uint16_t oe, uint16_t ys, uint16_t ye, uint16_t gs,
+                           uint16_t ge) {
+  meter.setZones(rs, re, os, oe, ys, ye, gs, ge);
+}
+
+void SpriteMeter::analogMeter(float fullScale, const char *units, const char *s0, const char *s1, const char *s2,
+                              const char *s3, const char *s4) {
+  // The clean face is kept without MeterWidget's own needle, the needle is drawn over it here
+  meter.analogMeter(0, 0, fullScale, units, s0, s1, s2, s3, s4);
+  meter.removeNeedle();
+  memcpy(face, canvas.getPointer(), SPRITE_METER_WIDTH * SPRITE_METER_HEIGHT * sizeof(uint16_t));
+
+  readout.invalidate();
+  needlePosition = NEEDLE_HIDDEN;
+  markerShown[0] = markerShown[1] = MARKER_NONE;
+  fullFrame = true; // the first update sends the whole meter
+}
+
+void SpriteMeter::setUnitsLabel(const char *label) {
+  // Part of the face, so it goes into the clean copy as well (called before the first update)
+  canvas.setTextColor(TFT_BLACK, TFT_WHITE);
+  canvas.setTextDatum(TC_DATUM);
+  canvas.drawString(label, METER_UNITS_X, METER_READOUT_Y, 2);
+  memcpy(face, canvas.getPointer(), SPRITE_METER_WIDTH * SPRITE_METER_HEIGHT * sizeof(uint16_t));
+  fullFrame = true;
+}
+
+bool SpriteMeter::saveFace(FaceCache &cache, uint32_t key) {
+  return cache.store(key, face, SPRITE_METER_WIDTH, SPRITE_METER_HEIGHT);
+}
+
+bool SpriteMeter::restoreFace(FaceCache &cache, uint32_t key, float fullScale, const char *units) {
+  if (!cache.load(key, face, SPRITE_METER_WIDTH, SPRITE_METER_HEIGHT)) {
+    return false;
+  }
+  memcpy(canvas.getPointer(), face, SPRITE_METER_WIDTH * SPRITE_METER_HEIGHT * sizeof(uint16_t));
+
+  // Carry on as if the face had just been drawn
+  meter.attachFace(0, 0, fullScale, units);
+  readout.invalidate();
+  needlePosition = NEEDLE_HIDDEN;
+  markerShown[0] = markerShown[1] = MARKER_NONE;
+  fullFrame = true;
+  return true;
+}
+
+void SpriteMeter::setReadoutDecimals(uint8_t digits) {
+  readout.setDecimals(digits);
+  readout.invalidate();
+  lastReadout = INT32_MIN; // send the readout again
+}
+
+void SpriteMeter::setMarkers(float low, float high) {
+  markerWanted[0] = position(low);
+  markerWanted[1] = position(high);
+}
+
+void SpriteMeter::update(float value, int32_t readoutValue) {
+  // The needle only moves in whole steps of the meter's 0-100 scale
+  int position = meter.position(value);
+  bool markersMoved = markerWanted[0] != markerShown[0] || markerWanted[1] != markerShown[1];
+  bool needleMoved = position != needlePosition || markersMoved;
+  bool readoutChanged = readoutValue != lastReadout;
+  if (!fullFrame && !needleMoved && !readoutChanged) {
+    return; // the panel already shows this
+  }
+
+  // Put the face back over the old and the new needle (and any marker that moves), then draw over it. This can
+  // run while the last frame is still being sent, as that comes from the transfer buffer.
+  Box dirty = {0, 0, 0, 0};
+  if (needleMoved) {
+    dirty = needleBox(position);
+    if (needlePosition != NEEDLE_HIDDEN) {
+      dirty.add(needleBox(needlePosition));
+    }
+    for (int i = 0; i < 2; i++) {
+      if (markerShown[i] != markerWanted[i]) {
+        dirty.add(markerBox(markerShown[i]));
+        dirty.add(markerBox(markerWanted[i]));
+        markerShown[i] = markerWanted[i];
+      }
+    }
+
+    // Drawing is clipped to the rectangle, so the canvas outside it still matches the panel
+    restoreBackground(dirty);
+    canvas.setViewport(dirty.x0, dirty.y0, dirty.x1 - dirty.x0, dirty.y1 - dirty.y0, false);
+    drawMarker(markerShown[0]);
+    drawMarker(markerShown[1]);
+    drawNeedle(position);
+    canvas.resetViewport();
+    needlePosition = position;
+  }
+
+  // Digits the needle's rectangle covered have just been erased, so those are drawn again as well
+  Box digits = {(int16_t)readout.x(), (int16_t)readout.y(), (int16_t)(readout.x() + readout.width()),
+                (int16_t)(readout.y() + readout.height())};
+  if (dirty.overlaps(digits)) {
+    readout.invalidate();
+    readoutChanged = true;
+  }
+  readout.update(readoutValue);
+  lastReadout = readoutValue;
+
+  // Send the rectangles that changed (everything the first time)
+  Box boxes[2];
+  int count = 0;
+  if (fullFrame) {
+    boxes[count++] = {0, 0, SPRITE_METER_WIDTH, SPRITE_METER_HEIGHT};
+    fullFrame = false;
+  } else {
+    if (!dirty.empty()) {
+      boxes[count++] = dirty;
+    }
+    if (readoutChanged) {
+      // One rectangle if they overlap (or both wouldn't fit in the transfer buffer)
+      int32_t area = (dirty.x1 - dirty.x0) * (dirty.y1 - dirty.y0) + readout.width() * readout.height();
+      if (count > 0 && (dirty.overlaps(digits) || area > SPRITE_METER_WIDTH * SPRITE_METER_HEIGHT)) {
+        boxes[0].add(digits);
+      } else {
+        boxes[count++] = digits;
+      }
+    }
+  }
+  send(boxes, count);
+}
+
+void SpriteMeter::send(const Box *boxes, int count) {
+  // The transfer buffer is only refilled once the last frame has gone
+  finishTransfer();
+  if (count == 0) {
+    return;
+  }
+
+  const uint16_t *pixels = (const uint16_t *)canvas.getPointer();
+  uint16_t *out = patch;
+  display->startWrite();
+  for (int b = 0; b < count; b++) {
+    const Box &box = boxes[b];
+    int32_t w = box.x1 - box.x0;
+    int32_t h = box.y1 - box.y0;
+
+    uint16_t *start = out;
+    for (int32_t y = box.y0; y < box.y1; y++) {
+      memcpy(out, pixels + y * SPRITE_METER_WIDTH + box.x0, w * sizeof(uint16_t));
+      out += w;
+    }
+
+    // Each push waits for the one before it, the buffer stays untouched until finishTransfer()
+    display->pushImageDMA(originX + box.x0, originY + box.y0, w, h, start);
+    sent += w * h;
+  }
+  transferPending = true;
+}
+
+void SpriteMeter::finishTransfer() {
+  if (transferPending) {
+    display->dmaWait();
+    display->endWrite();
+    transferPending = false;
+  }
+}
+
+void SpriteMeter::restoreBackground(const Box &box) {
+  uint16_t *pixels = (uint16_t *)canvas.getPointer();
+  size_t bytes = (box.x1 - box.x0) * sizeof(uint16_t);
+  for (int32_t y = box.y0; y < box.y1; y++) {
+    size_t offset = y * SPRITE_METER_WIDTH + box.x0;
+    memcpy(pixels + offset, face + offset, bytes);
+  }
+}
+
+void SpriteMeter::drawNeedle(int position) {
+  // Tapered red needle with a thin magenta centre line, both blended into whatever is under them
+  const Direction &d = directionAt(position);
+  float baseX = PIVOT_X + (PIVOT_Y - NEEDLE_BASE_Y) * d.tangent;
+  float tipX = PIVOT_X + NEEDLE_LENGTH * d.sine;
+  float tipY = PIVOT_Y - NEEDLE_LENGTH * d.cosine;
+  canvas.drawWedgeLine(baseX, NEEDLE_BASE_Y, tipX, tipY, NEEDLE_BASE_RADIUS, NEEDLE_TIP_RADIUS, TFT_RED);
+  canvas.drawWideLine(baseX, NEEDLE_BASE_Y, tipX, tipY, 1.0f, TFT_MAGENTA);
+}
+
+void SpriteMeter::drawMarker(int position) {
+  if (position == MARKER_NONE) {
+    return;
+  }
+
+  // Same triangle as NeedleMeter: base 2 steps either side at the tip's radius, point nearer the pivot
+  const Direction &p = directionAt(position);
+  const Direction &l = directionAt(position - 2);
+  const Direction &r = directionAt(position + 2);
+  canvas.fillTriangle(lroundf(PIVOT_X + MARKER_INNER * p.sine), lroundf(PIVOT_Y - MARKER_INNER * p.cosine),
+                      lroundf(PIVOT_X + MARKER_OUTER * l.sine), lroundf(PIVOT_Y - MARKER_OUTER * l.cosine),
+                      lroundf(PIVOT_X + MARKER_OUTER * r.sine), lroundf(PIVOT_Y - MARKER_OUTER * r.cosine),
+                      MARKER_COLOR);
+}
+
+SpriteMeter::Box SpriteMeter::needleBox(int position) const {
+  const Direction &d = directionAt(position);
+  float x[2] = {PIVOT_X + (PIVOT_Y - NEEDLE_BASE_Y) * d.tangent, PIVOT_X + NEEDLE_LENGTH * d.sine};
+  float y[2] = {NEEDLE_BASE_Y, PIVOT_Y - NEEDLE_LENGTH * d.cosine};
+  return boxAround(x, y, 2, NEEDLE_BASE_RADIUS + 1); // plus the anti-aliased fringe
+}
+
+SpriteMeter::Box SpriteMeter::markerBox(int position) const {
+  if (position == MARKER_NONE) {
+    return {0, 0, 0, 0};
+  }
+
+  const Direction &p = directionAt(position);
+  const Direction &l = directionAt(position - 2);
+  const Direction &r = directionAt(position + 2);
+  float x[3] = {PIVOT_X + MARKER_INNER * p.sine, PIVOT_X + MARKER_OUTER * l.sine, PIVOT_X + MARKER_OUTER * r.sine};
+  float y[3] = {PIVOT_Y - MARKER_INNER * p.cosine, PIVOT_Y - MARKER_OUTER * l.cosine, PIVOT_Y - MARKER_OUTER * r.cosine};
+  return boxAround(x, y, 3, 1); // the corners are rounded to whole pixels
+}
+
+SpriteMeter::Box SpriteMeter::boxAround(const float *x, const float *y, int points, float margin) {
+  float left = x[0], right = x[0], top = y[0], bottom = y[0];
+  for (int i = 1; i < points; i++) {
+    left = fminf(left, x[i]);
+    right = fmaxf(right, x[i]);
+    top = fminf(top, y[i]);
+    bottom = fmaxf(bottom, y[i]);
+  }
+
+  // Whole pixels, kept inside the canvas
+  Box box;
+  box.x0 = (int16_t)fmaxf(floorf(left - margin), 0);
+  box.y0 = (int16_t)fmaxf(floorf(top - margin), 0);
+  box.x1 = (int16_t)fminf(ceilf(right + margin) + 1, SPRITE_METER_WIDTH);
+  box.y1 = (int16_t)fminf(ceilf(bottom + margin) + 1, SPRITE_METER_HEIGHT);
+  return box;
+}
+
+bool SpriteMeter::Box::overlaps(const Box &other) const {
+  return !empty() && !other.empty() && x0 < other.x1 && other.x0 < x1 && y0 < other.y1 && other.y0 < y1;
+}
+
+void SpriteMeter::Box::add(const Box &other) {
+  if (other.empty()) {
+    return;
+  }
+  if (empty()) {
+    *this = other;
+    return;
+  }
+  if (other.x0 < x0) x0 = other.x0;
+  if (other.y0 < y0) y0 = other.y0;
+  if (other.x1 > x1) x1 = other.x1;
+  if (other.y1 > y1) y1 = other.y1;
+}
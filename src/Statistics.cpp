@@ -0,0 +1,177 @@
+#include "Statistics.h"
+#include "BlockKernels.h"
+
+#define MEDIUM_PARTS 10 // 10ms buckets per 100ms bucket
+#define SLOW_PARTS 6    // 100ms buckets per 600ms bucket
+
+void SampleStatistics::begin(uint32_t samplesPerSecond) {
+  bucketSamples = samplesPerSecond * STATS_BUCKET_MS / 1000;
+  if (bucketSamples < 1) {
+    bucketSamples = 1;
+  }
+
+  clear(current);
+  clear(medium);
+  clear(slow);
+  mediumParts = 0;
+  slowParts = 0;
+  for (Window &window : windows) {
+    window.reset();
+  }
+}
+
+void SampleStatistics::feed(const uint16_t *samples, size_t count, size_t stride) {
+  size_t i = 0;
+  while (i < count) {
+    // Fill the current bucket (or use up the block) in a tight loop, with the totals in registers
+    uint16_t low = current.min;
+    uint16_t high = current.max;
+    uint32_t sum = 0;
+    uint64_t sumSquares = 0;
+    uint32_t taken = 0;
+    uint32_t wanted = bucketSamples - current.count;
+
+    if (stride == 1) {
+      // A single channel is contiguous, so the vector kernels can take it (12-bit samples fit an int16_t)
+      taken = count - i < wanted ? count - i : wanted;
+      BlockStats block;
+      blockStats((const int16_t *)samples + i, taken, block);
+      if ((uint16_t)block.min < low) low = block.min;
+      if ((uint16_t)block.max > high) high = block.max;
+      sum = block.sum;
+      sumSquares = block.sumSquares;
+      i += taken;
+    }
+
+    for (; i < count && taken < wanted; i += stride, taken++) {
+      uint32_t sample = samples[i];
+      if (sample < low) low = sample;
+      if (sample > high) high = sample;
+      sum += sample;
+      sumSquares += sample * sample;
+    }
+
+    current.min = low;
+    current.max = high;
+    current.count += taken;
+    current.sum += sum;
+    current.sumSquares += sumSquares;
+
+    if (current.count == bucketSamples) {
+      closeBucket();
+    }
+  }
+}
+
+void SampleStatistics::closeBucket() {
+  windows[STATS_1S].add(current);
+
+  // Longer buckets are built from whole shorter ones
+  merge(medium, current);
+  if (++mediumParts == MEDIUM_PARTS) {
+    windows[STATS_10S].add(medium);
+    merge(slow, medium);
+    clear(medium);
+    mediumParts = 0;
+
+    if (++slowParts == SLOW_PARTS) {
+      windows[STATS_60S].add(slow);
+      clear(slow);
+      slowParts = 0;
+    }
+  }
+  clear(current);
+
+  // Hand the reader a consistent copy (dropped if the reader is far behind, it only wants the newest)
+  StatsSnapshot *snapshot = snapshots.claim();
+  if (snapshot != nullptr) {
+    summarize(*snapshot);
+    snapshots.publish();
+  }
+}
+
+void SampleStatistics::summarize(StatsSnapshot &snapshot) const {
+  for (int w = 0; w < STATS_WINDOW_COUNT; w++) {
+    snapshot.window[w] = windows[w].summary();
+  }
+}
+
+void SampleStatistics::clear(Bucket &bucket) {
+  bucket.min = UINT16_MAX;
+  bucket.max = 0;
+  bucket.count = 0;
+  bucket.sum = 0;
+  bucket.sumSquares = 0;
+}
+
+void SampleStatistics::merge(Bucket &into, const Bucket &from) {
+  if (from.min < into.min) into.min = from.min;
+  if (from.max > into.max) into.max = from.max;
+  into.count += from.count;
+  into.sum += from.sum;
+  into.sumSquares += from.sumSquares;
+}
+
+void SampleStatistics::Window::reset() {
+  added = 0;
+  count = 0;
+  sum = 0;
+  sumSquares = 0;
+  minFront = minSize = 0;
+  maxFront = maxSize = 0;
+}
+
+void SampleStatistics::Window::add(const Bucket &bucket) {
+  uint32_t sequence = added++;
+
+  // The oldest bucket leaves the window (its slot in the ring is about to be reused)
+  if (sequence >= STATS_BUCKETS) {
+    uint32_t expired = sequence - STATS_BUCKETS;
+    const Bucket &old = bucketAt(expired);
+    count -= old.count;
+    sum -= old.sum;
+    sumSquares -= old.sumSquares;
+
+    if (minSize > 0 && minDeque[minFront] == expired) {
+      minFront = (minFront + 1) % STATS_BUCKETS;
+      minSize--;
+    }
+    if (maxSize > 0 && maxDeque[maxFront] == expired) {
+      maxFront = (maxFront + 1) % STATS_BUCKETS;
+      maxSize--;
+    }
+  }
+
+  ring[sequence % STATS_BUCKETS] = bucket;
+  count += bucket.count;
+  sum += bucket.sum;
+  sumSquares += bucket.sumSquares;
+
+  // Buckets that can no longer be the min (or max) of the window are dropped from the back
+  while (minSize > 0 && bucketAt(minDeque[(minFront + minSize - 1) % STATS_BUCKETS]).min >= bucket.min) {
+    minSize--;
+  }
+  minDeque[(minFront + minSize++) % STATS_BUCKETS] = sequence;
+
+  while (maxSize > 0 && bucketAt(maxDeque[(maxFront + maxSize - 1) % STATS_BUCKETS]).max <= bucket.max) {
+    maxSize--;
+  }
+  maxDeque[(maxFront + maxSize++) % STATS_BUCKETS] = sequence;
+}
+
+StatsSummary SampleStatistics::Window::summary() const {
+  StatsSummary result = {};
+  result.count = count;
+  if (count == 0) {
+    return result;
+  }
+
+  result.min = bucketAt(minDeque[minFront]).min;
+  result.max = bucketAt(maxDeque[maxFront]).max;
+
+  double mean = (double)sum / count;
+  double variance = (double)sumSquares / count - mean * mean;
+  result.mean = mean;
+  result.variance = variance > 0 ? variance : 0; // rounding can leave a tiny negative for a constant input
+  return result;
+}
@@ -0,0 +1,166 @@
+#include "Telemetry.h"
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <PubSubClient.h>
+
+#define FRAME_MAGIC 0x4B
+#define FRAME_VERSION 1
+#define HEADER_FIXED_BYTES 7                        // magic, version, count, span, columns
+#define STATS_BYTES (1 + STATS_WINDOW_COUNT * 5 * 5) // worst case of the statistics section
+#define MQTT_RETRY_MS 2000                          // between attempts to reach the broker
+
+bool Telemetry::begin(const TelemetryConfig &config, BaseType_t core, UBaseType_t priority) {
+  settings = config;
+  device = (uint32_t)ESP.getEfuseMac();
+  return xTaskCreatePinnedToCore(networkTask, "telemetry", 4096, this, priority, &taskHandle, core) == pdPASS;
+}
+
+void Telemetry::add(uint32_t nowMs, const int32_t *values, uint8_t columns) {
+  if (columns > TELEMETRY_MAX_COLUMNS) {
+    columns = TELEMETRY_MAX_COLUMNS;
+  }
+
+  // A frame without room for one more reading (at worst 5 bytes a value) goes out early, without the statistics
+  if (filling != nullptr && filling->length + columns * 5 + STATS_BYTES > TELEMETRY_FRAME_BYTES) {
+    closeBatch(nullptr);
+  }
+  if (!batchOpen) {
+    startBatch(nowMs, columns);
+  }
+
+  lastMs = nowMs;
+  if (filling == nullptr) {
+    return; // the pool is full, this batch is being dropped
+  }
+
+  for (uint8_t c = 0; c < numColumns; c++) {
+    putSigned(values[c] - previous[c]);
+    previous[c] = values[c];
+  }
+  count++;
+}
+
+void Telemetry::send(const StatsSnapshot &stats) {
+  if (batchOpen) {
+    closeBatch(&stats);
+  }
+}
+
+void Telemetry::startBatch(uint32_t nowMs, uint8_t columns) {
+  batchOpen = true;
+  startMs = nowMs;
+  lastMs = nowMs;
+  count = 0;
+  numColumns = columns;
+  memset(previous, 0, sizeof(previous));
+
+  filling = pool.claim();
+  if (filling == nullptr) {
+    return;
+  }
+
+  // The count and span are filled in when the frame is closed
+  filling->length = HEADER_FIXED_BYTES;
+  filling->data[0] = FRAME_MAGIC;
+  filling->data[1] = FRAME_VERSION;
+  filling->data[6] = columns;
+  putVarint(device);
+  putVarint(sequence);
+  putVarint(startMs);
+}
+
+void Telemetry::closeBatch(const StatsSnapshot *stats) {
+  batchOpen = false;
+  sequence++;
+  if (filling == nullptr) {
+    dropped++;
+    return;
+  }
+
+  uint32_t span = lastMs - startMs;
+  if (span > UINT16_MAX) {
+    span = UINT16_MAX;
+  }
+  filling->data[2] = count & 0xFF;
+  filling->data[3] = count >> 8;
+  filling->data[4] = span & 0xFF;
+  filling->data[5] = span >> 8;
+
+  // Statistics windows in raw counts, the mean and standard deviation with 4 fraction bits
+  filling->data[filling->length++] = stats != nullptr ? STATS_WINDOW_COUNT : 0;
+  if (stats != nullptr) {
+    for (const StatsSummary &summary : stats->window) {
+      putVarint(summary.count);
+      putVarint(summary.min);
+      putVarint(summary.max);
+      putVarint((uint32_t)(summary.mean * 16 + 0.5f));
+      putVarint((uint32_t)(sqrtf(summary.variance) * 16 + 0.5f));
+    }
+  }
+
+  filling = nullptr;
+  pool.publish();
+  xTaskNotifyGive(taskHandle);
+}
+
+void Telemetry::putVarint(uint32_t value) {
+  uint8_t *out = filling->data + filling->length;
+  while (value >= 0x80) {
+    *out++ = (value & 0x7F) | 0x80;
+    value >>= 7;
+  }
+  *out++ = value;
+  filling->length = out - filling->data;
+}
+
+void Telemetry::networkTask(void *parameter) {
+  Telemetry *self = (Telemetry *)parameter;
+  const TelemetryConfig &config = self->settings;
+
+  WiFiUDP udp;
+  WiFiClient client;
+  PubSubClient mqtt(client);
+  uint32_t lastAttemptMs = 0;
+  char clientId[24];
+  snprintf(clientId, sizeof(clientId), "ky035-%08lx", (unsigned long)self->device);
+
+  if (config.transport == TELEMETRY_MQTT) {
+    mqtt.setServer(config.host, config.port);
+    mqtt.setBufferSize(TELEMETRY_FRAME_BYTES + 64); // a whole frame plus the topic and MQTT header
+  }
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)); // woken by a new frame, or every 100ms to look after MQTT
+
+    bool up = WiFi.status() == WL_CONNECTED;
+    if (up && config.transport == TELEMETRY_MQTT) {
+      if (!mqtt.connected() && millis() - lastAttemptMs >= MQTT_RETRY_MS) {
+        lastAttemptMs = millis();
+        mqtt.connect(clientId);
+      }
+      up = mqtt.connected();
+      mqtt.loop();
+    }
+    self->online = up;
+
+    // Frames that can't go out right now are discarded, so the pool is always free for the newest readings
+    Frame *frame;
+    while ((frame = self->pool.front()) != nullptr) {
+      bool ok = false;
+      if (up && config.transport == TELEMETRY_MQTT) {
+        ok = mqtt.publish(config.topic, frame->data, frame->length);
+      } else if (up) {
+        ok = udp.beginPacket(config.host, config.port) && udp.write(frame->data, frame->length) == frame->length &&
+             udp.endPacket();
+      }
+
+      if (ok) {
+        self->sent++;
+        self->bytes += frame->length;
+      } else {
+        self->unsent++;
+      }
+      self->pool.release();
+    }
+  }
+}
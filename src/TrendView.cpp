@@ -0,0 +1,69 @@
+#include "TrendView.h"
+
+TrendView::TrendView(TFT_eSPI *tft) : sprite(tft) {}
+
+bool TrendView::begin(int32_t x, int32_t y, int16_t w, int16_t h, float minValue, float maxValue) {
+  areaX = x;
+  areaY = y;
+  width = w;
+  height = h;
+  low = minValue;
+  high = maxValue > minValue ? maxValue : minValue + 1;
+
+  sprite.setColorDepth(16);
+  sprite.setAttribute(PSRAM_ENABLE, true);
+  if (sprite.createSprite(w, h) == nullptr) {
+    return false;
+  }
+
+  for (int16_t column = 0; column < width; column++) {
+    clearColumn(column);
+  }
+  next = 0;
+  lastRow = -1;
+  return true;
+}
+
+int16_t TrendView::rowOf(float value) const {
+  int16_t row = (int16_t)((high - value) * (height - 1) / (high - low));
+  if (row < 0) row = 0; // clip at the edges of the chart
+  if (row > height - 1) row = height - 1;
+  return row;
+}
+
+void TrendView::clearColumn(int16_t column) {
+  sprite.drawFastVLine(column, 0, height, TREND_BACKGROUND);
+  for (int i = 1; i < 4; i++) {
+    sprite.drawPixel(column, i * (height - 1) / 4, TREND_GRID); // grid lines at a quarter, half and three quarters
+  }
+}
+
+void TrendView::add(float value) {
+  if (!sprite.created()) {
+    return;
+  }
+
+  int16_t row = rowOf(value);
+  clearColumn(next);
+
+  // Join up to the previous value so fast changes show as a continuous line
+  int16_t from = lastRow < 0 ? row : lastRow;
+  int16_t top = from < row ? from : row;
+  int16_t bottom = from < row ? row : from;
+  sprite.drawFastVLine(next, top, bottom - top + 1, TREND_TRACE);
+
+  lastRow = row;
+  next = (next + 1) % width;
+}
+
+void TrendView::draw() {
+  if (!sprite.created()) {
+    return;
+  }
+
+  // Oldest columns (from 'next' to the end of the sprite) on the left, then the newest ones
+  sprite.pushSprite(areaX, areaY, next, 0, width - next, height);
+  if (next > 0) {
+    sprite.pushSprite(areaX + width - next, areaY, 0, 0, next, height);
+  }
+}
@@ -0,0 +1,99 @@
+#include "TriggerCapture.h"
+
+void TriggerCapture::begin(uint16_t level, TriggerEdge edge, uint16_t hysteresis, size_t preSamples, size_t postSamples) {
+  // Keep the lengths inside the buffers (the trigger sample itself always counts as post-trigger)
+  if (preSamples > TRIGGER_HISTORY_SAMPLES) preSamples = TRIGGER_HISTORY_SAMPLES;
+  if (postSamples < 1) postSamples = 1;
+  if (preSamples + postSamples > TRIGGER_CAPTURE_SAMPLES) postSamples = TRIGGER_CAPTURE_SAMPLES - preSamples;
+
+  triggerLevel = level;
+  triggerEdge = edge;
+  hysteresisCounts = hysteresis;
+  preLength = preSamples;
+  postLength = postSamples;
+
+  risingReady = false;
+  fallingReady = false;
+  historyIndex = 0;
+  historyFilled = 0;
+  captureLength = 0;
+  triggerPos = 0;
+  captures = 0;
+  rearm.store(false, std::memory_order_relaxed);
+  state.store(STATE_ARMED, std::memory_order_release);
+}
+
+void TriggerCapture::feed(const uint16_t *samples, size_t count, size_t stride) {
+  uint8_t current = state.load(std::memory_order_relaxed);
+
+  // arm() only takes effect once the reader is finished with the frozen capture
+  if (rearm.exchange(false, std::memory_order_acquire) && current == STATE_CAPTURED) {
+    risingReady = false; // the signal has to pass through the hysteresis band again before it can trigger
+    fallingReady = false;
+    current = STATE_ARMED;
+  }
+
+  for (size_t i = 0; i < count; i += stride) {
+    uint16_t sample = samples[i];
+
+    if (current == STATE_ARMED) {
+      if (edgeDetected(sample)) {
+        startCapture(sample);
+        current = STATE_COLLECTING;
+      }
+    } else if (current == STATE_COLLECTING) {
+      capture[captureLength++] = sample;
+    }
+
+    if (current == STATE_COLLECTING && captureLength == triggerPos + postLength) {
+      captures++;
+      current = STATE_CAPTURED; // frozen from here on, the history keeps rolling
+    }
+
+    history[historyIndex] = sample;
+    historyIndex = (historyIndex + 1) & (TRIGGER_HISTORY_SAMPLES - 1);
+    if (historyFilled < TRIGGER_HISTORY_SAMPLES) {
+      historyFilled++;
+    }
+  }
+
+  state.store(current, std::memory_order_release); // publishes a finished capture to the reader
+}
+
+bool TriggerCapture::edgeDetected(uint16_t sample) {
+  bool fired = false;
+
+  if (triggerEdge != TRIGGER_FALLING) {
+    if (sample + hysteresisCounts <= triggerLevel) {
+      risingReady = true; // far enough below the level for the next crossing to count
+    } else if (risingReady && sample >= triggerLevel) {
+      risingReady = false;
+      fired = true;
+    }
+  }
+
+  if (triggerEdge != TRIGGER_RISING) {
+    if (sample >= triggerLevel + hysteresisCounts) {
+      fallingReady = true; // far enough above the level for the next crossing to count
+    } else if (fallingReady && sample <= triggerLevel) {
+      fallingReady = false;
+      fired = true;
+    }
+  }
+
+  return fired;
+}
+
+void TriggerCapture::startCapture(uint16_t sample) {
+  // Copy the history leading up to the trigger, oldest first (less than asked for if the trigger came early)
+  size_t pre = preLength < historyFilled ? preLength : historyFilled;
+  size_t index = (historyIndex - pre) & (TRIGGER_HISTORY_SAMPLES - 1);
+  for (size_t i = 0; i < pre; i++) {
+    capture[i] = history[index];
+    index = (index + 1) & (TRIGGER_HISTORY_SAMPLES - 1);
+  }
+
+  triggerPos = pre;
+  capture[pre] = sample;
+  captureLength = pre + 1;
+}
@@ -0,0 +1,55 @@
+#include "UsbStreamer.h"
+#include <esp_timer.h>
+
+bool UsbStreamer::begin(Print &out, uint8_t channels, BaseType_t core, UBaseType_t priority) {
+  port = &out;
+  numChannels = channels;
+  return xTaskCreatePinnedToCore(streamTask, "stream", 4096, this, priority, &taskHandle, core) == pdPASS;
+}
+
+uint16_t *UsbStreamer::claimBlock() {
+  claimed = ring.claim();
+  return claimed ? claimed->samples : scratch.samples;
+}
+
+void UsbStreamer::commitBlock(size_t count) {
+  if (count == 0) {
+    claimed = nullptr; // nothing was read, so there is no frame to account for
+    return;
+  }
+
+  uint32_t seq = sequence++;
+  if (claimed == nullptr) {
+    dropped++; // ring full, the host will see the gap in the sequence numbers
+    return;
+  }
+
+  claimed->header.sync = STREAM_SYNC;
+  claimed->header.count = count;
+  claimed->header.sequence = seq;
+  claimed->header.timestampUs = (uint32_t)esp_timer_get_time();
+  claimed->header.channels = numChannels;
+  claimed->header.reserved = 0;
+  claimed = nullptr;
+
+  ring.publish();
+  xTaskNotifyGive(taskHandle);
+}
+
+void UsbStreamer::streamTask(void *parameter) {
+  UsbStreamer *self = (UsbStreamer *)parameter;
+
+  for (;;) {
+    StreamFrame *frame = self->ring.front();
+    if (frame == nullptr) {
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY); // wait for the next block
+      continue;
+    }
+
+    // Header and samples are contiguous, so the whole frame goes out in one write straight from the ring
+    size_t length = sizeof(StreamFrameHeader) + frame->header.count * sizeof(uint16_t);
+    self->port->write((const uint8_t *)frame, length);
+    self->ring.release();
+    self->sent++;
+  }
+}
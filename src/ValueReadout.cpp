@@ -0,0 +1,91 @@
+#include "ValueReadout.h"
+
+ValueReadout::ValueReadout(TFT_eSPI *tft) : display(tft) {}
+
+void ValueReadout::begin(int32_t rightX, int32_t y, uint8_t cells, uint8_t font, uint16_t fgColor, uint16_t bgColor) {
+  if (cells > READOUT_MAX_CELLS) {
+    cells = READOUT_MAX_CELLS;
+  }
+
+  numCells = cells;
+  textFont = font;
+  fg = fgColor;
+  bg = bgColor;
+
+  // Make every cell as wide as the widest character we might show so the digits don't shift around
+  const char *glyphs = "0123456789-.";
+  char glyph[2] = {0, 0};
+  cellWidth = 0;
+  for (const char *p = glyphs; *p; p++) {
+    glyph[0] = *p;
+    int16_t w = display->textWidth(glyph, font);
+    if (w > cellWidth) cellWidth = w;
+  }
+  cellHeight = display->fontHeight(font);
+
+  left = rightX - cellWidth * cells;
+  top = y;
+  valid = false;
+}
+
+void ValueReadout::update(int32_t value) {
+  // Integer to text without going through the float formatting in dtostrf()
+  char text[12];
+  char *p = text + sizeof(text) - 1;
+  *p = '\0';
+
+  bool negative = value < 0;
+  uint32_t magnitude = negative ? -(uint32_t)value : (uint32_t)value;
+  uint8_t digits = 0;
+  do {
+    *--p = '0' + magnitude % 10;
+    magnitude /= 10;
+    if (++digits == decimals) {
+      *--p = '.';
+      if (magnitude == 0) {
+        *--p = '0'; // leading zero, e.g. "0.5"
+      }
+    }
+  } while (magnitude || digits < decimals);
+  if (negative) {
+    *--p = '-';
+  }
+
+  update(p);
+}
+
+void ValueReadout::update(const char *text) {
+  // Right-align the text in the row of cells (keep the rightmost characters if it is too long)
+  char next[READOUT_MAX_CELLS + 1];
+  size_t len = strlen(text);
+  if (len > numCells) {
+    text += len - numCells;
+    len = numCells;
+  }
+  memset(next, ' ', numCells - len);
+  memcpy(next + numCells - len, text, len);
+  next[numCells] = '\0';
+
+  for (uint8_t i = 0; i < numCells; i++) {
+    if (!valid || next[i] != shown[i]) {
+      drawCell(i, next[i]);
+      shown[i] = next[i];
+    }
+  }
+  valid = true;
+}
+
+void ValueReadout::drawCell(uint8_t cell, char c) {
+  int32_t x = left + cell * cellWidth;
+
+  // Clear the cell, then draw the character centred in it
+  display->fillRect(x, top, cellWidth, cellHeight, bg);
+  if (c != ' ') {
+    char glyph[2] = {c, 0};
+    uint8_t datum = display->getTextDatum();
+    display->setTextDatum(TL_DATUM);
+    display->setTextColor(fg, bg);
+    display->drawString(glyph, x + (cellWidth - display->textWidth(glyph, textFont)) / 2, top, textFont);
+    display->setTextDatum(datum);
+  }
+}
@@ -0,0 +1,59 @@
+#include "ViewController.h"
+
+ViewController::ViewController(ViewLayers *viewLayers, FrameScheduler *frameScheduler)
+    : layers(viewLayers), scheduler(frameScheduler) {}
+
+void ViewController::begin(const ViewSpec *views, uint8_t count, uint8_t first, uint8_t viewButton,
+                           uint8_t actionButton, void (*beforeSwitch)()) {
+  table = views;
+  viewCount = count;
+  shown = first;
+  home = first;
+  nextButton = viewButton;
+  doButton = actionButton;
+  prepare = beforeSwitch;
+}
+
+void ViewController::show(uint8_t view) {
+  if (view >= viewCount) {
+    return;
+  }
+  if (prepare != nullptr) {
+    prepare();
+  }
+
+  shown = view;
+  const ViewSpec &spec = table[view];
+  if (spec.layer != nullptr) {
+    layers->show(view, spec.layer);
+  }
+  if (spec.enter != nullptr) {
+    spec.enter();
+  }
+  scheduler->setViewPeriod(spec.periodMs);
+}
+
+void ViewController::handle(const ButtonEvent &event) {
+  if (event.button == nextButton) {
+    if (event.action == BUTTON_CLICK) {
+      uint8_t view = shown;
+      do {
+        view = (view + 1) % viewCount;
+      } while (!table[view].available && view != shown);
+      show(view);
+    } else if (event.action == BUTTON_HOLD) {
+      show(home);
+    }
+    return;
+  }
+
+  if (event.button == doButton && table[shown].action != nullptr) {
+    table[shown].action(event);
+  }
+}
+
+void ViewController::frame() {
+  if (table[shown].frame != nullptr) {
+    table[shown].frame();
+  }
+}
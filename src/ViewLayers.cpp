@@ -0,0 +1,52 @@
+#include "ViewLayers.h"
+
+#define LAYER_BACKGROUND TFT_BLACK
+
+ViewLayers::ViewLayers(TFT_eSPI *tft) : display(tft) {}
+
+void ViewLayers::begin(int32_t x, int32_t y, int16_t w, int16_t h) {
+  areaX = x;
+  areaY = y;
+  width = w;
+  height = h;
+}
+
+void ViewLayers::show(uint8_t id, LayerRenderer render) {
+  if (id >= VIEW_LAYERS_MAX) {
+    return;
+  }
+
+  if (layers[id] == nullptr) {
+    TFT_eSprite *sprite = new TFT_eSprite(display);
+    sprite->setColorDepth(16);
+    sprite->setAttribute(PSRAM_ENABLE, true);
+    if (sprite->createSprite(width, height) != nullptr) {
+      layers[id] = sprite;
+      allocated += (uint32_t)width * height * 2;
+    } else {
+      delete sprite;
+    }
+  }
+
+  // Out of memory: draw straight to the panel every time, with the same coordinates
+  if (layers[id] == nullptr) {
+    display->fillRect(areaX, areaY, width, height, LAYER_BACKGROUND);
+    display->setViewport(areaX, areaY, width, height);
+    render(*display, width, height);
+    display->resetViewport();
+    return;
+  }
+
+  if (!rendered[id]) {
+    layers[id]->fillSprite(LAYER_BACKGROUND);
+    render(*layers[id], width, height);
+    rendered[id] = true;
+  }
+  layers[id]->pushSprite(areaX, areaY);
+}
+
+void ViewLayers::invalidate(uint8_t id) {
+  if (id < VIEW_LAYERS_MAX) {
+    rendered[id] = false;
+  }
+}
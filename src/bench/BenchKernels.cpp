@@ -0,0 +1,141 @@
+/*********************************************************************************************************
+ * Block kernel benchmark
+ *
+ * Description:
+ *   Checks every kernel in BlockKernels.h against its scalar reference version, for block lengths from 0
+ *   to a few vectors at every alignment (so the scalar head and tail around the vectors are covered too)
+ *   and for blocks of extreme values, then times both versions on 1024 samples.
+ *********************************************************************************************************/
+
+#include "Benchmark.h"
+#include "BlockKernels.h"
+
+#define KERNEL_SAMPLES 1024  // samples per timed call
+#define KERNEL_ITERATIONS 200
+#define CHECK_LENGTHS 40     // every length up to this is checked at every alignment
+
+alignas(16) static int16_t samples[KERNEL_SAMPLES + 8];
+alignas(16) static uint16_t counts[KERNEL_SAMPLES + 8];
+static int16_t lookupOut[KERNEL_SAMPLES + 8];
+static int16_t lookupRef[KERNEL_SAMPLES + 8];
+static int16_t table[4096];
+static volatile int64_t sink;
+
+// Compare the vector and scalar results on samples[offset .. offset + length), returns false (and says where) if any differ
+static bool checkBlock(size_t offset, size_t length) {
+  const int16_t *block = samples + offset;
+  BlockStats vector, scalar;
+  blockStats(block, length, vector);
+  blockStatsScalar(block, length, scalar);
+
+  int16_t low, high, lowRef, highRef;
+  blockMinMax(block, length, low, high);
+  blockMinMaxScalar(block, length, lowRef, highRef);
+
+  bool same = vector.sum == scalar.sum && vector.sumSquares == scalar.sumSquares && vector.min == scalar.min &&
+              vector.max == scalar.max && blockSum(block, length) == blockSumScalar(block, length) &&
+              blockSumSquares(block, length) == blockSumSquaresScalar(block, length) && low == lowRef && high == highRef;
+  if (!same) {
+    Serial.printf("  MISMATCH at offset %u length %u: sum %ld/%ld squares %lld/%lld min %d/%d max %d/%d\n", (unsigned)offset,
+                  (unsigned)length, (long)vector.sum, (long)scalar.sum, (long long)vector.sumSquares,
+                  (long long)scalar.sumSquares, vector.min, scalar.min, vector.max, scalar.max);
+  }
+  return same;
+}
+
+// The same for the table lookup of counts[offset .. offset + length)
+static bool checkLookup(size_t offset, size_t length) {
+  blockLookup(counts + offset, lookupOut, length, table, 4095);
+  blockLookupScalar(counts + offset, lookupRef, length, table, 4095);
+  for (size_t i = 0; i < length; i++) {
+    if (lookupOut[i] != lookupRef[i]) {
+      Serial.printf("  MISMATCH blockLookup at offset %u length %u, sample %u: %d/%d\n", (unsigned)offset,
+                    (unsigned)length, (unsigned)i, lookupOut[i], lookupRef[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool checkKernels() {
+  bool ok = true;
+
+  // 12-bit samples like the ADC's, at every alignment and every short length
+  for (size_t i = 0; i < KERNEL_SAMPLES + 8; i++) {
+    samples[i] = esp_random() & 0xFFF;
+  }
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 0; length <= CHECK_LENGTHS; length++) {
+      ok &= checkBlock(offset, length);
+    }
+  }
+  ok &= checkBlock(1, KERNEL_SAMPLES);
+
+  // The full signed range, which the lane compares and the 40-bit accumulator must handle (256 squares of -32768
+  // are about half of what it holds)
+  for (size_t i = 0; i < KERNEL_SAMPLES + 8; i++) {
+    samples[i] = (i % 3 == 0) ? INT16_MIN : (i % 3 == 1) ? INT16_MAX : (int16_t)esp_random();
+  }
+  ok &= checkBlock(0, 256);
+  ok &= checkBlock(3, 200);
+
+  // Table lookup of counts with bits above the mask (a signed table, so the loads must sign-extend)
+  for (int i = 0; i < 4096; i++) {
+    table[i] = 2047 - i;
+  }
+  for (size_t i = 0; i < KERNEL_SAMPLES + 8; i++) {
+    counts[i] = esp_random();
+  }
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 0; length <= CHECK_LENGTHS; length++) {
+      ok &= checkLookup(offset, length);
+    }
+  }
+  ok &= checkLookup(1, KERNEL_SAMPLES);
+  return ok;
+}
+
+void benchKernels() {
+  Serial.printf("  BlockKernels: %s, results %s\n", BLOCK_KERNELS_PIE ? "PIE vector versions" : "scalar only",
+                checkKernels() ? "match the scalar reference" : "DIFFER from the scalar reference");
+
+  for (size_t i = 0; i < KERNEL_SAMPLES; i++) {
+    samples[i] = esp_random() & 0xFFF;
+  }
+
+  benchRun("blockSum", KERNEL_ITERATIONS, KERNEL_SAMPLES, [](uint32_t) { sink = blockSum(samples, KERNEL_SAMPLES); });
+  benchRun("blockSum (scalar)", KERNEL_ITERATIONS, KERNEL_SAMPLES,
+           [](uint32_t) { sink = blockSumScalar(samples, KERNEL_SAMPLES); });
+
+  benchRun("blockSumSquares", KERNEL_ITERATIONS, KERNEL_SAMPLES,
+           [](uint32_t) { sink = blockSumSquares(samples, KERNEL_SAMPLES); });
+  benchRun("blockSumSquares (scalar)", KERNEL_ITERATIONS, KERNEL_SAMPLES,
+           [](uint32_t) { sink = blockSumSquaresScalar(samples, KERNEL_SAMPLES); });
+
+  benchRun("blockMinMax", KERNEL_ITERATIONS, KERNEL_SAMPLES, [](uint32_t) {
+    int16_t low, high;
+    blockMinMax(samples, KERNEL_SAMPLES, low, high);
+    sink = low + high;
+  });
+  benchRun("blockMinMax (scalar)", KERNEL_ITERATIONS, KERNEL_SAMPLES, [](uint32_t) {
+    int16_t low, high;
+    blockMinMaxScalar(samples, KERNEL_SAMPLES, low, high);
+    sink = low + high;
+  });
+
+  benchRun("blockStats", KERNEL_ITERATIONS, KERNEL_SAMPLES, [](uint32_t) {
+    BlockStats stats;
+    blockStats(samples, KERNEL_SAMPLES, stats);
+    sink = stats.sumSquares;
+  });
+  benchRun("blockStats (scalar)", KERNEL_ITERATIONS, KERNEL_SAMPLES, [](uint32_t) {
+    BlockStats stats;
+    blockStatsScalar(samples, KERNEL_SAMPLES, stats);
+    sink = stats.sumSquares;
+  });
+
+  benchRun("blockLookup", KERNEL_ITERATIONS, KERNEL_SAMPLES,
+           [](uint32_t) { blockLookup(counts, lookupOut, KERNEL_SAMPLES, table, 4095); });
+  benchRun("blockLookup (scalar)", KERNEL_ITERATIONS, KERNEL_SAMPLES,
+           [](uint32_t) { blockLookupScalar(counts, lookupOut, KERNEL_SAMPLES, table, 4095); });
+}
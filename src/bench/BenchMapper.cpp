@@ -0,0 +1,49 @@
+/*********************************************************************************************************
+ * Mapper benchmark
+ *
+ * Description:
+ *   Times the float mapValue() against the fixed point FixedMapper for converting the full range of ADC
+ *   counts to millivolts, and checks the two agree.
+ *********************************************************************************************************/
+
+#include "Benchmark.h"
+#include "FixedMap.h"
+
+#define MAPPER_PASSES 100 // passes over the full 0-4095 input range
+
+typedef FixedMapper<0, 4095, 0, 3300> AdcToMillivolts;
+
+// Inputs are read through a volatile array so the compiler can't fold the conversions away
+static volatile uint16_t inputs[4096];
+static volatile int32_t sink;
+
+// Largest difference between the two versions over the whole input range
+static int32_t maxError() {
+  int32_t worst = 0;
+  for (int i = 0; i < 4096; i++) {
+    int32_t ref = (int32_t)lroundf(mapValue(i, 0, 4095, 0.0, 3300.0));
+    int32_t err = abs(AdcToMillivolts::map(i) - ref);
+    if (err > worst) worst = err;
+  }
+  return worst;
+}
+
+void benchMapper() {
+  for (int i = 0; i < 4096; i++) {
+    inputs[i] = i;
+  }
+
+  benchRun("mapValue (float)", MAPPER_PASSES, 4096, [](uint32_t) {
+    for (int i = 0; i < 4096; i++) {
+      sink = (int32_t)mapValue(inputs[i], 0, 4095, 0.0, 3300.0);
+    }
+  });
+
+  benchRun("FixedMapper", MAPPER_PASSES, 4096, [](uint32_t) {
+    for (int i = 0; i < 4096; i++) {
+      sink = AdcToMillivolts::map(inputs[i]);
+    }
+  });
+
+  Serial.printf("  FixedMapper max difference from mapValue: %ld mV\n", (long)maxError());
+}
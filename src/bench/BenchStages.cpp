@@ -0,0 +1,52 @@
+/*********************************************************************************************************
+ * Sample -> display hot path benchmark
+ *
+ * Description:
+ *   Times each stage of the main loop on its own, using the real sampler, filter and display set up by
+ *   setup():
+ *     - readAndMapSensor(): draining and filtering one LOOP_PERIOD's worth of DMA samples
+ *     - updateMeter():      moving the needle (a different step on every call, the worst case)
+ *     - displayaveValue():  updating the readout (a different value on every call)
+ *     - SpriteMeter:        composing and sending a frame, when the sprite renderer is in use
+ *********************************************************************************************************/
+
+#include "Benchmark.h"
+#include "SpriteMeter.h"
+
+#define STAGE_ITERATIONS 200
+#define STAGE_PERIOD_MS 10 // time between readAndMapSensor() calls, match LOOP_PERIOD in main.cpp
+
+// Stages and state from main.cpp
+extern float readAndMapSensor(int &aveValue);
+extern void updateMeter(float voltage);
+extern void displayaveValue(int aveValue);
+extern SpriteMeter spriteMeter;
+extern bool useSpriteMeter;
+extern const float meterFullScale;
+
+static volatile float sinkVoltage;
+
+void benchStages() {
+  // Let the DMA collect a period's worth of samples before each (untimed) wait, like the acquisition task does
+  benchRun("readAndMapSensor", STAGE_ITERATIONS, 1, [](uint32_t) {
+    int aveValue;
+    sinkVoltage = readAndMapSensor(aveValue);
+  }, [](uint32_t) { delay(STAGE_PERIOD_MS); });
+
+  // Sweep the needle back and forth across the whole dial (whatever DISPLAY_UNITS is), so it moves on every call
+  auto sweep = [](uint32_t i) { return (i % 100 < 50 ? i % 50 : 50 - i % 50) * (meterFullScale / 50); };
+
+  if (useSpriteMeter) {
+    uint32_t pixelsBefore = spriteMeter.pixelsSent();
+    benchRun("SpriteMeter::update", STAGE_ITERATIONS, 1, [&](uint32_t i) {
+      spriteMeter.update(sweep(i), (i * 37) % 4096);
+    });
+    spriteMeter.finishTransfer();
+    Serial.printf("  SpriteMeter pixels sent per frame: %lu\n",
+                  (unsigned long)((spriteMeter.pixelsSent() - pixelsBefore) / STAGE_ITERATIONS));
+    return;
+  }
+
+  benchRun("updateMeter", STAGE_ITERATIONS, 1, [&](uint32_t i) { updateMeter(sweep(i)); });
+  benchRun("displayaveValue", STAGE_ITERATIONS, 1, [](uint32_t i) { displayaveValue((i * 37) % 4096); });
+}
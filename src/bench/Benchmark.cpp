@@ -0,0 +1,22 @@
+#include "Benchmark.h"
+
+uint32_t benchCycles[BENCH_MAX_ITERATIONS];
+
+void benchReport(const char *name, const BenchResult &result, uint32_t iterations, uint32_t itemsPerCall) {
+  float mhz = ESP.getCpuFreqMHz();
+  float meanUs = result.meanCycles / mhz;
+  float perSecond = meanUs > 0 ? 1e6f * itemsPerCall / meanUs : 0;
+
+  Serial.printf("%-24s n=%-5lu min %9.2fus  mean %9.2fus  p99 %9.2fus  %12.0f /s\n", name, (unsigned long)iterations,
+                result.minCycles / mhz, meanUs, result.p99Cycles / mhz, perSecond);
+}
+
+void runBenchmarks() {
+  delay(2000); // give the USB serial port time to connect
+
+  Serial.printf("\nBenchmarks (CPU %lu MHz, times per call, throughput per item)\n", (unsigned long)ESP.getCpuFreqMHz());
+  benchMapper();
+  benchStages();
+  benchKernels();
+  Serial.println("Benchmarks done\n");
+}
@@ -0,0 +1,70 @@
+/*********************************************************************************************************
+ * Benchmark harness (built into the "benchmark" environment only)
+ *
+ * Description:
+ *   benchRun() calls a stage many times, timing every call with the CPU cycle counter, and prints the
+ *   min / mean / 99th percentile latency and the throughput over serial. runBenchmarks() is called at the
+ *   end of setup() in benchmark builds, before the tasks start, and runs every benchmark in src/bench.
+ *
+ * Notes:
+ *   - Times include anything that interrupts the stage on this core (ISRs, higher priority tasks).
+ *   - 'itemsPerCall' lets a stage that processes a batch (e.g. 4096 conversions) report per-item numbers.
+ *********************************************************************************************************/
+
+#pragma once
+
+#include <Arduino.h>
+#include <algorithm>
+
+#define BENCH_MAX_ITERATIONS 1000
+
+struct BenchResult {
+  uint32_t minCycles;
+  uint32_t meanCycles;
+  uint32_t p99Cycles;
+};
+
+// Cycle counts of the current run (shared, benchmarks run one at a time)
+extern uint32_t benchCycles[BENCH_MAX_ITERATIONS];
+
+// Print the result of a run in a fixed format
+void benchReport(const char *name, const BenchResult &result, uint32_t iterations, uint32_t itemsPerCall);
+
+// Time 'iterations' calls of stage(i). prepare(i), if given, runs untimed before each call.
+template <typename Stage, typename Prepare>
+BenchResult benchRun(const char *name, uint32_t iterations, uint32_t itemsPerCall, Stage stage, Prepare prepare) {
+  if (iterations > BENCH_MAX_ITERATIONS) {
+    iterations = BENCH_MAX_ITERATIONS;
+  }
+
+  uint64_t total = 0;
+  for (uint32_t i = 0; i < iterations; i++) {
+    prepare(i);
+    uint32_t start = ESP.getCycleCount();
+    stage(i);
+    benchCycles[i] = ESP.getCycleCount() - start;
+    total += benchCycles[i];
+  }
+
+  BenchResult result;
+  result.meanCycles = total / iterations;
+  std::sort(benchCycles, benchCycles + iterations);
+  result.minCycles = benchCycles[0];
+  result.p99Cycles = benchCycles[(iterations * 99) / 100 < iterations ? (iterations * 99) / 100 : iterations - 1];
+
+  benchReport(name, result, iterations, itemsPerCall);
+  return result;
+}
+
+template <typename Stage>
+BenchResult benchRun(const char *name, uint32_t iterations, uint32_t itemsPerCall, Stage stage) {
+  return benchRun(name, iterations, itemsPerCall, stage, [](uint32_t) {});
+}
+
+// Individual benchmark suites
+void benchMapper();
+void benchStages();
+void benchKernels();
+
+// Run everything and print the results (called from setup() in benchmark builds)
+void runBenchmarks();
@@ -6,22 +6,88 @@
  *   LilyGO T-Display-S3 microcontroller board. It displays the sensor readings using a analog meter
  *   using the TFT_eSPI and TFT_eWidget libraries. The project demonstrates embedded programming concepts,
  *   including:
- *     - Analog Inputs: Reading sensor data from an analog pin.
+ *     - Analog Inputs: Reading sensor data from an analog pin using the continuous (DMA) ADC driver.
  *     - Variables: Storing and manipulating data, such as the sensor reading and averaged values.
  *     - Functions: Placing code into reusable blocks for better organization and modularity.
  *     - TFT_eSPI and TFT_eWidget Libraries: Utilizing these libraries for direct display control and
  *        rendering an analog meter based off of the Meters library example.
- *     - Data Averaging: Taking multiple readings and averaging them to help smooth the reading.
+ *     - Data Filtering: Smoothing the readings with moving average, IIR and median filters.
  *     - Real-Time Meter Display: Visualizing sensor data as a needle on an analog meter.
  *
  * How It Works:
  *   1. Sensor Reading: The code reads the analog output of the KY035 sensor, which varies with the
  *       strength of the magnetic field.
- *   2. Averaging: Multiple readings are taken and averaged to provide a more stable value.
- *   3. Display Update: The averaged sensor reading is displayed as a needle on an analog meter, with the
- *       raw ADC value also shown on the screen.
- *   4. TFT_eWidget Meter: The project utilizes the TFT_eWidget library to render an analog meter with
- *       zones for visual feedback.
+ *   2. Filtering: The ADC runs in continuous (DMA) mode, filling a ring buffer in the background. Every
+ *       sample is fed through a filter pipeline (optional median spike rejector, then oversampling and
+ *       decimation to 13-14 effective bits, then a moving average or IIR filter, then a deadband) that
+ *       updates in constant time, so a smoothed value is always ready.
+ *   3. Calibration: The chip's factory eFuse ADC calibration and each sensor's zero-field output and
+ *       sensitivity are baked into 4096-entry lookup tables at boot, so converting a reading to calibrated
+ *       volts or gauss is a single table lookup. Send 'z' over serial to capture the zero-field output
+ *       (kept in NVS with the settings).
+ *   4. Display Update: The averaged sensor reading is displayed as a needle on an analog meter, with the
+ *       value also shown on the screen: either the calibrated field strength in gauss or millitesla (signed,
+ *       zero field in the middle of the scale), or volts and the raw ADC value (DISPLAY_UNITS). The needle
+ *       glides towards each new reading with critically damped motion at the display frame rate
+ *       (NEEDLE_ANIMATION), so it moves smoothly however far apart the readings are.
+ *   5. Trigger: Every raw sample of the first channel is also checked against an edge trigger (level,
+ *       rising/falling edge, hysteresis). When it fires, the samples from just before the event to a while
+ *       after it are frozen in a capture buffer that can be printed over serial ('c'), so short pulses from
+ *       a passing magnet are not lost in the averaging.
+ *   6. Statistics: The min, max, mean and variance of the raw samples are kept over sliding 1s, 10s and
+ *       60s windows (constant time per update). The lowest and highest field of the last 10s are shown as
+ *       peak-hold markers on the meter, and 's' prints all three windows over serial.
+ *   7. Low Power: Optionally (LOW_POWER_ENABLED), once the field has been steady for a while the ADC only
+ *       samples in short bursts with the chip in light sleep in between, the CPU clock drops and the
+ *       backlight dims. A field change or the button brings back full-rate sampling. The instrumentation
+ *       reports the duty cycle.
+ *   8. Views: The KEY button (GPIO14) cycles between the meter, a scrolling trend chart of the last ~30
+ *       seconds (drawn one column at a time into a circular sprite), a table of the 1s/10s/60s statistics,
+ *       the waveform of the last trigger capture, the frequency spectrum and a settings screen; holding it
+ *       goes back to the meter. The BOOT button (GPIO0) acts on the view shown: it re-arms the trigger, or
+ *       picks a setting and raises it while held. Both buttons are debounced in a hardware timer interrupt.
+ *       The fixed background of each view is prerendered into a sprite, so switching is one push to the
+ *       panel, and each view sets its own frame rate: only the view on screen is drawn.
+ *   9. Tasks: Sampling runs in an acquisition task on core 0 and drawing in a display task on core 1. The
+ *       readings are passed between them through a lock-free queue, so a slow redraw never delays sampling.
+ *       The sample rate, the filter output rate (LOOP_PERIOD) and the display refresh are set separately;
+ *       the display skips frames while the needle is steady and speeds up when the field changes quickly.
+ *   10. Several Sensors: Up to 8 channels can be scanned in one DMA sweep (SENSOR_CHANNEL_COUNT), each with
+ *       its own filter, and shown as a compact bar per channel instead of the analog meter.
+ *   11. TFT_eWidget Meter: The project utilizes the TFT_eWidget library to render an analog meter with
+ *       zones for visual feedback. By default the meter is composed off-screen in a sprite and only the
+ *       rectangle around the old and new needle (restored from a clean copy of the face, with an anti-aliased
+ *       needle drawn over it) is pushed to the panel with DMA while the next frame is being drawn
+ *       (RENDER_MODE). The face is saved to
+ *       flash at boot before sampling starts when it isn't there yet (a face changed at run time is saved
+ *       at the next boot) and copied straight into the frame buffers on later boots, with sampling already
+ *       running in the background, and the time to the first valid reading and the first frame are printed
+ *       over serial (FACE_CACHE_ENABLED).
+ *   12. Settings: The loop period, filter, deadband, trigger level, display refresh, telemetry cadence, zero-field
+ *       outputs and meter zones are kept in NVS and can be changed over serial without reflashing (':' lists them, ':deadband 40'
+ *       changes one, ':defaults' restores the values compiled in). The tasks read them from a plain struct that
+ *       is swapped atomically on a change (a copy swapped out is reused once the acquisition task has moved on,
+ *       so a change never waits).
+ *   13. Telemetry: Optionally (TELEMETRY_ENABLED) the filtered readings and the statistics windows are batched into
+ *       compact binary frames (delta encoded, varint packed) and sent over Wi-Fi by UDP or MQTT once per
+ *       telemetryPeriodMs. The frames are encoded into a pool of buffers of their own and sent by a separate task,
+ *       so Wi-Fi latency never holds up sampling (a batch is dropped instead when the network falls behind).
+ *   14. Dashboard: Optionally (DASHBOARD_ENABLED) a small web page (gzipped in flash) shows the field live in a
+ *       browser, fed by a WebSocket. The readings queued since the last push go out together 20 times a second,
+ *       and a client that can't keep up misses frames rather than slowing down the others.
+ *   15. Spectrum: For AC fields (motors, transformers) the raw samples also go through a Hann-windowed real FFT
+ *       (ESP-DSP) on overlapping windows, ~39 times a second. The spectrum view shows it as bars with the
+ *       dominant frequency and its amplitude, and 'f' prints them over serial (SPECTRUM_ENABLED).
+ *   16. Data Log: For unattended runs a reading every LOG_PERIOD_MS and the events (boot, trigger captures,
+ *       low-power mode, settings changes) are logged to a ring of CRC-checked pages in flash, or to an SD card
+ *       when one is fitted (LOG_ENABLED). The pages are filled in RAM and written whole by a task of their own,
+ *       the end of the log is found again after a power cut, and 'l' sends the whole log over USB as stored.
+ *   17. Replay: The replay build (pio run -e replay) feeds the acquisition task a recorded sample stream
+ *       from flash instead of the ADC, in the same blocks at the recorded rate, so the whole filter ->
+ *       calibration -> display pipeline runs the same way on every run. After each pass through the
+ *       recording a digest of the filter outputs and the time taken per block are printed, and
+ *       tools/replay_check.py compares them with a saved baseline to catch functional and performance
+ *       regressions (tools/embed_recording.py turns a stream_reader.py recording into the header).
  *
  * Pin Connections:
  *   - Sensor (S)   -> A0 (Analog Input 0)
@@ -47,17 +113,305 @@
 **************************************************************/
 
 #include <TFT_eSPI.h>
-#include <TFT_eWidget.h>
+#include <WiFi.h>
+#include "AdcSampler.h"
+#include "SpscQueue.h"
+#include "Filters.h"
+#include "ValueReadout.h"
+#include "SpriteMeter.h"
+#include "NeedleMeter.h"
+#include "FrameScheduler.h"
+#include "UsbStreamer.h"
+#include "Instrumentation.h"
+#include "BarMeter.h"
+#include "Calibration.h"
+#include "TriggerCapture.h"
+#include "TrendView.h"
+#include "Statistics.h"
+#include "PowerManager.h"
+#include "FaceCache.h"
+#include "NeedleAnimator.h"
+#include "Settings.h"
+#include "Telemetry.h"
+#include "Dashboard.h"
+#include "Spectrum.h"
+#include "SpectrumView.h"
+#include "DataLogger.h"
+#include "Buttons.h"
+#include "ViewLayers.h"
+#include "ViewController.h"
+#include <esp_system.h>
+
+#ifdef BENCHMARK_BUILD
+#include "bench/Benchmark.h"
+#endif
+
+#ifdef REPLAY_BUILD
+#include "SampleReplay.h"
+#include "ReplayRecording.h"
+#endif
 
 // Define the pin for the KY035 sensor
-#define SENSOR_PIN A0 // analog pin 0 (GPIO01)
+#define SENSOR_PIN A0                  // analog pin 0 (GPIO01)
+#define SENSOR_ADC_CHANNEL ADC1_CHANNEL_0 // GPIO01 is channel 0 of ADC1
+
+// Number of KY035 modules (1 to ADC_MAX_CHANNELS). With more than one, all channels are scanned in one sweep and
+// shown on a bar display instead of the analog meter.
+#define SENSOR_CHANNEL_COUNT 1
+
+// ADC1 channels to scan, in order (the first one is SENSOR_PIN). On the T-Display-S3 the free ADC1 pins are
+// GPIO01-03 and GPIO10; GPIO04 is the battery monitor and GPIO05-09 drive the display.
+const adc1_channel_t sensorChannels[] = {SENSOR_ADC_CHANNEL, ADC1_CHANNEL_1, ADC1_CHANNEL_2, ADC1_CHANNEL_9};
+const char *const sensorLabels[] = {"A0", "G2", "G3", "G10"};
+static_assert(SENSOR_CHANNEL_COUNT >= 1 && SENSOR_CHANNEL_COUNT <= ADC_MAX_CHANNELS, "SENSOR_CHANNEL_COUNT out of range");
+static_assert(SENSOR_CHANNEL_COUNT <= sizeof(sensorChannels) / sizeof(sensorChannels[0]), "add the extra channels to sensorChannels");
+
+// Continuous (DMA) ADC sampler for the sensor pin. The replay build (pio run -e replay) plays the recording in
+// include/ReplayRecording.h instead (see SampleReplay.h and tools/embed_recording.py), and reports a digest of what the
+// pipeline made of each pass through it over serial, for tools/replay_check.py.
+#ifdef REPLAY_BUILD
+SampleReplay sampler;
+static_assert(REPLAY_CHANNELS == SENSOR_CHANNEL_COUNT, "the recording must have SENSOR_CHANNEL_COUNT channels");
+#else
+AdcSampler sampler;
+#endif
+
+// Raw sample streaming over USB (see UsbStreamer.h and tools/stream_reader.py)
+#define USB_STREAM_ENABLED false // send every raw ADC block to the host (raise ADC_SAMPLE_RATE_HZ for more detail)
+#define USB_STREAM_CORE 1
+#define USB_STREAM_PRIORITY 1    // lowest of the tasks, the host can never hold up sampling or drawing
+
+UsbStreamer streamer;
+
+// Filter settings (the type, lengths and deadband are the defaults of the settings kept in NVS, see below)
+#define OVERSAMPLE_BITS 2           // extra bits of resolution, 4^n samples are summed per result (0 = off, max 4)
+#define FILTER_TYPE FILTER_BOXCAR   // FILTER_BOXCAR, FILTER_IIR or FILTER_NONE
+#define FILTER_BOXCAR_LENGTH (512 >> (2 * OVERSAMPLE_BITS)) // decimated results in the moving average (~25ms at 20kS/s)
+#define FILTER_IIR_SHIFT (9 - 2 * OVERSAMPLE_BITS)          // IIR weight of each new result is 1/2^shift
+#define FILTER_SPIKE_REJECTION true // run a median-of-5 spike rejector before the smoothing filter
+#define DEADBAND_THRESHOLD 30       // readings at or below this (in 12-bit counts) are shown as 0 (prevents the needle bouncing)
+
+static_assert(OVERSAMPLE_BITS <= 4, "the filtered values must fit in 16 bits");
+
+static_assert(FILTER_BOXCAR_LENGTH <= SETTING_BOXCAR_MAX, "FILTER_BOXCAR_LENGTH is longer than the filters can hold");
+
+// Per-sample filter pipeline for each channel (spike rejector -> decimator -> smoothing -> deadband), with room for the
+// longest moving average the settings allow
+FilterPipeline<SETTING_BOXCAR_MAX> sensorFilter[SENSOR_CHANNEL_COUNT];
+
+// Event trigger on the raw samples of the first channel, e.g. to catch a magnet going past (see TriggerCapture.h)
+#define TRIGGER_ENABLED true
+#define TRIGGER_LEVEL 2400         // raw ADC counts (~1.93V, about 160G above zero field with the default calibration)
+#define TRIGGER_EDGE TRIGGER_RISING // TRIGGER_RISING, TRIGGER_FALLING or TRIGGER_EITHER
+#define TRIGGER_HYSTERESIS 40      // counts the signal must move back past the level before it can trigger again
+#define TRIGGER_PRE_SAMPLES 256    // history kept from before the trigger (~13ms at 20kS/s)
+#define TRIGGER_POST_SAMPLES 768   // samples captured from the trigger on (~38ms at 20kS/s)
+#define TRIGGER_AUTO_REARM false   // re-arm as soon as a capture is reported (false = single shot, send 't' to re-arm)
+
+TriggerCapture trigger;
+
+// Min/max/mean/variance of the raw samples of the first channel over 1s, 10s and 60s (see Statistics.h)
+#define PEAK_HOLD_ENABLED true     // show the lowest and highest sample of PEAK_HOLD_WINDOW as markers on the meter
+#define PEAK_HOLD_WINDOW STATS_10S // STATS_1S, STATS_10S or STATS_60S
+
+SampleStatistics sensorStats;
+StatsSnapshot stats = {}; // newest statistics, kept by the display task
+
+// Spectrum of the raw samples of the first channel, for AC fields near motors and transformers (see Spectrum.h)
+#define SPECTRUM_ENABLED true // adds the spectrum view, and 'f' prints the dominant frequency
+#define SPECTRUM_FRAME_MS 25  // display period while the spectrum view is on screen (a new spectrum every ~26ms)
+
+SpectrumAnalyzer spectrum;
+SpectrumFrame spectrumFrame = {}; // newest spectrum, kept by the display task
 
 // TFT_eSPI & TFT_eWidget related declarations
 TFT_eSPI tft = TFT_eSPI();
-MeterWidget volts = MeterWidget(&tft);
+NeedleMeter volts = NeedleMeter(&tft); // TFT_eWidget meter face with a table driven needle
+ValueReadout aveReadout = ValueReadout(&tft); // ADC value in the bottom left corner of the meter
+SpriteMeter spriteMeter = SpriteMeter(&tft);  // double-buffered version of the meter (RENDER_SPRITE)
+BarMeter barMeter = BarMeter(&tft);           // one bar per channel (SENSOR_CHANNEL_COUNT > 1)
+TrendView trendView = TrendView(&tft);        // strip chart of the recent history of the first channel
+SpectrumView spectrumView = SpectrumView(&tft); // bar spectrum of the first channel
+
+// Display units
+#define UNITS_ADC 0        // needle in volts, raw ADC value in the readout (the original display)
+#define UNITS_GAUSS 1      // signed field strength in gauss (calibrated, 0 = no field)
+#define UNITS_MILLITESLA 2 // signed field strength in millitesla (1mT = 10G)
+#define DISPLAY_UNITS UNITS_GAUSS
+#define FIELD_FULL_SCALE_GAUSS 500 // the meter shows -FIELD_FULL_SCALE_GAUSS to +FIELD_FULL_SCALE_GAUSS
+
+// Value at the right hand end of the meter scale (the needle value of the field is offset so zero is in the middle)
+#define METER_FULL_SCALE (DISPLAY_UNITS == UNITS_ADC ? 3.3f : 2.0f * FIELD_FULL_SCALE_GAUSS)
+extern const float meterFullScale = METER_FULL_SCALE; // for the benchmarks in src/bench
+
+// Views, the KEY button cycles through them in this order (holding it goes back to the meter) and the BOOT button acts
+// on the view on screen (see viewTable)
+#define VIEW_METER 0    // analog meter (or bars with several channels)
+#define VIEW_TREND 1    // scrolling strip chart of the first channel
+#define VIEW_STATS 2    // min/max/mean/standard deviation of the first channel over 1s, 10s and 60s
+#define VIEW_CAPTURE 3  // waveform of the last trigger capture (BOOT re-arms the trigger)
+#define VIEW_SPECTRUM 4 // frequency spectrum of the first channel (SPECTRUM_ENABLED)
+#define VIEW_CONFIG 5   // the settings kept in NVS (BOOT selects one, holding BOOT raises it)
+#define VIEW_COUNT 6
+
+#define VIEW_BUTTON_PIN 14    // the KEY button on the T-Display-S3 (GPIO14, active low)
+#define ACTION_BUTTON_PIN 0   // the BOOT button (GPIO0, active low)
+#define BUTTON_TIMER 0        // hardware timer that samples the buttons (every BUTTON_SAMPLE_MS)
+#define TREND_PERIOD_MS 100   // one trend column per 100ms (~30s across the screen)
+#define TREND_CATCH_UP 10     // most trend columns added in one frame to catch up after a slow frame
+#define STATS_VIEW_PERIOD_MS 200  // frame period of the statistics view
+#define CAPTURE_VIEW_PERIOD_MS 100 // the capture view only redraws on a new capture
+#define CONFIG_VIEW_PERIOD_MS 200  // frame period of the settings view (a button press wakes it straight away)
+
+Buttons buttons;
+ViewLayers viewLayers = ViewLayers(&tft); // prerendered backgrounds of the views
+
+// Rendering modes
+#define RENDER_DIRECT 0 // draw the meter straight to the panel
+#define RENDER_SPRITE 1 // compose the meter in a sprite and push what changed with DMA (falls back to direct if out of memory)
+#define RENDER_MODE RENDER_SPRITE
+
+bool useSpriteMeter = false; // set in setup() once we know the sprites could be allocated
+const bool useBarMeter = SENSOR_CHANNEL_COUNT > 1;
+
+// Fast boot: the sprite meter's face is saved to flash at boot when it isn't there yet, and copied back in on later boots
+#define FACE_CACHE_ENABLED true
+
+FaceCache faceCache;
+bool faceFromFlash = false;   // the face on screen came from flash rather than being drawn
+bool faceSaveAllowed = false; // only in setup() before sampling starts: erasing flash stalls both cores for longer
+                              // than the ADC's DMA ring lasts
+
+// Filter output period in ms (how often the acquisition task publishes a filtered reading, default of a setting)
+#define LOOP_PERIOD 10
+
+// Display refresh (independent of the sample rate and LOOP_PERIOD)
+#define DISPLAY_ADAPTIVE true   // adapt the frame period to how fast the needle is moving
+#define DISPLAY_MIN_PERIOD 16   // fastest frame period in ms (~60fps), also the fixed period when not adaptive
+#define DISPLAY_MAX_PERIOD 100  // slowest frame period in ms while the needle is steady (adaptive mode)
+#define DISPLAY_FAST_STEPS 3    // needle steps per frame that count as a fast change (adaptive mode)
+
+// Decides when the display redraws
+FrameScheduler frameScheduler;
+
+// The view on screen, switched by the buttons (each view hands its own frame period to the scheduler)
+ViewController views = ViewController(&viewLayers, &frameScheduler);
+
+// Needle motion (see NeedleAnimator.h): the needle glides towards each new reading at the frame rate instead of jumping
+#define NEEDLE_ANIMATION true
+#define NEEDLE_TIME_CONSTANT_MS 30 // the needle is back at rest on a new reading ~5 time constants later
+
+NeedleAnimator needleAnimator;
+
+// Wi-Fi network, joined at boot if the telemetry or the dashboard is enabled (and rejoined whenever it drops)
+#define WIFI_SSID "your-network"
+#define WIFI_PASSWORD "your-password"
+
+// Telemetry over Wi-Fi (see Telemetry.h and tools/telemetry_receiver.py): the readings and statistics are batched into
+// compact frames and sent by a task of their own, so a slow network never holds up sampling
+#define TELEMETRY_ENABLED false
+#define TELEMETRY_TRANSPORT TELEMETRY_UDP // TELEMETRY_UDP (one datagram per frame) or TELEMETRY_MQTT (one message per frame)
+#define TELEMETRY_HOST "192.168.1.10"     // UDP receiver or MQTT broker
+#define TELEMETRY_PORT 5005               // e.g. 1883 for MQTT
+#define TELEMETRY_TOPIC "ky035/telemetry" // MQTT only
+#define TELEMETRY_PERIOD 1000             // ms of readings per frame (default of a setting)
+#define TELEMETRY_CORE 1
+#define TELEMETRY_PRIORITY 1              // lowest of the tasks, like the USB stream
+
+Telemetry telemetry;
+
+// Web dashboard (see Dashboard.h): open http://<address shown over serial>/ to watch the readings live in a browser
+#define DASHBOARD_ENABLED false
+#define DASHBOARD_PORT 80
+#define DASHBOARD_DECIMATION 2 // every 2nd reading goes to the browsers (50 per second at the default loop period)
+#define DASHBOARD_CORE 1
+#define DASHBOARD_PRIORITY 1   // lowest of the tasks, like the USB stream
+
+Dashboard dashboard;
+
+const bool wifiEnabled = TELEMETRY_ENABLED || DASHBOARD_ENABLED;
+
+// Data log for unattended runs (see DataLogger.h and tools/log_export.py): the readings and events go to a ring in the
+// SPIFFS partition after the face cache, or to a file on an SD card if one is wired to the SPI pins below
+#define LOG_ENABLED true
+#define LOG_PERIOD_MS 1000     // one reading logged per second (49 per page with one channel)
+#define LOG_FLUSH_MS 60000     // a page is written at least this often, full or not (what a power cut can lose)
+#define LOG_SD_ENABLED true    // use the SD card when it answers at boot, the flash otherwise
+#define LOG_SD_SCK 17
+#define LOG_SD_MISO 21
+#define LOG_SD_MOSI 18
+#define LOG_SD_CS 16
+#define LOG_SD_BYTES (16u * 1024 * 1024) // size of the ring on the card (~18 days at one reading per second)
+#define LOG_CORE 1
+#define LOG_PRIORITY 1         // lowest of the tasks, like the USB stream
+
+DataLogger logger;
+
+// Settings that can be changed over serial (':name value') and are kept in NVS, defaulting to the values above
+#define ZERO_FIELD_DECI_MV (uint16_t)(KY035_ZERO_FIELD_MV * 10)
+static_assert(SENSOR_CHANNEL_COUNT <= SETTING_ZERO_CHANNELS, "the settings keep a zero-field output for 4 sensors");
+
+const Settings defaultSettings = {
+  LOOP_PERIOD,
+  FILTER_TYPE,
+  FILTER_BOXCAR_LENGTH,
+  FILTER_IIR_SHIFT,
+  FILTER_SPIKE_REJECTION,
+  DEADBAND_THRESHOLD,
+  TRIGGER_LEVEL,
+  TRIGGER_HYSTERESIS,
+  DISPLAY_MIN_PERIOD,
+  DISPLAY_MAX_PERIOD,
+  TELEMETRY_PERIOD,
+  {ZERO_FIELD_DECI_MV, ZERO_FIELD_DECI_MV, ZERO_FIELD_DECI_MV, ZERO_FIELD_DECI_MV}, // until captured with 'z'
+  0, 100,  // red zone
+  25, 75,  // orange
+  0, 0,    // yellow
+  40, 60,  // green
+};
+
+SettingsStore settings;
+
+// Task settings (acquisition on core 0, display on core 1 alongside the Arduino core)
+#define ACQUISITION_CORE 0
+#define DISPLAY_CORE 1
+#define ACQUISITION_PRIORITY 3 // above the display so a slow redraw can never hold up sampling
+#define DISPLAY_PRIORITY 2
+#define TASK_STACK_SIZE 8192
+
+// Low-power mode for running from the battery (see PowerManager.h). Once the field has been steady for a while the
+// ADC only samples in short bursts, the CPUs sleep in between and the backlight dims. A change of more than the wake
+// threshold, or the button, brings back full-rate sampling (events between bursts are missed meanwhile).
+#define LOW_POWER_ENABLED false
+#define LOW_POWER_IDLE_MS 30000     // steady for this long before dropping into low-power mode
+#define LOW_POWER_WAKE_THRESHOLD 20 // change in 12-bit counts (~15G) that counts as the field moving
+#define LOW_POWER_SLEEP_MS 250      // asleep between bursts
+#define LOW_POWER_BURST_MS 40       // sampling per burst (longer than the filter window, so the reading settles)
+#define LOW_POWER_LIGHT_SLEEP true  // light-sleep the whole chip between bursts (never while streaming over USB or Wi-Fi)
+#define BACKLIGHT_DIM 24            // backlight level in low-power mode (0-255)
+
+PowerManager power;
+
+// One averaged reading passed from the acquisition task to the display task
+struct Reading {
+  int aveValue;  // averaged ADC value of the first channel (0-4095, with OVERSAMPLE_BITS fraction bits)
+  float voltage; // mapped voltage (0-3.3V) of the first channel
+  uint16_t channelValues[SENSOR_CHANNEL_COUNT]; // averaged ADC value of every channel (0-4095, as shown on the bars)
+  int16_t fieldDeciGauss; // calibrated field strength of the first channel in tenths of a gauss
+};
 
-// Display update time in ms
-#define LOOP_PERIOD 50
+// Lock-free hand-over between the two tasks
+SpscQueue<Reading, 8> readingQueue;
+TaskHandle_t displayTaskHandle = nullptr;
+TaskHandle_t acquisitionTaskHandle = nullptr;
+
+// Hot path instrumentation (stage timings, missed deadlines, sample rate, overruns)
+#define INSTRUMENT_PERIOD_MS 1000 // reporting window
+#define INSTRUMENT_SERIAL true    // print a report line over serial every window (not while USB streaming)
+#define INSTRUMENT_OVERLAY true   // show a summary in the strip under the heading
+#define OVERLAY_Y 24              // top of the overlay strip (between the heading and the meter)
+
+Instrumentation instruments;
 
 // Screen dimensions
 #define SCREEN_WIDTH 340
@@ -71,59 +425,1215 @@ MeterWidget volts = MeterWidget(&tft);
 #define METER_X ((SCREEN_WIDTH - METER_WIDTH) / 2 - 10) // center horizontally (needed 10 extra pixels to the left)
 #define METER_Y ((SCREEN_HEIGHT - METER_HEIGHT) - 10)   // align to the bottom (with extra 10px padding)
 
-// Float for the mapped value used by the needle
-float mapValue(float ip, float ipmin, float ipmax, float tomin, float tomax) {
-  return tomin + (((tomax - tomin) * (ip - ipmin)) / (ipmax - ipmin));
-}
+// Calibration tables: counts -> eFuse-corrected millivolts (all channels), and counts -> field for each sensor
+AdcCalibration adcCal;
+FieldCalibration fieldCal[SENSOR_CHANNEL_COUNT];
+
+// Zero-field capture ('z'): the display task asks, the acquisition task reads its own filters and hands the values back,
+// and the display task saves them as settings (which the acquisition task then applies to the tables)
+struct ZeroCapture {
+  int32_t counts[SENSOR_CHANNEL_COUNT]; // filter outputs, with OVERSAMPLE_BITS fraction bits
+};
+
+std::atomic<bool> zeroRequested{false};
+SpscQueue<ZeroCapture, 2> zeroCaptures;
 
 
 /*************************************************************
 *********************** HELPER FUNCTIONS *********************
 **************************************************************/
 
+// Function to read the next block of samples (straight into a USB frame when streaming)
+size_t readSensorBlock(uint16_t *&block, uint32_t timeoutMs) {
+  static uint16_t localBlock[ADC_BLOCK_SAMPLES];
+
+  block = streamer.enabled() ? streamer.claimBlock() : localBlock;
+  size_t count = sampler.readBlock(block, ADC_BLOCK_SAMPLES, timeoutMs);
+
+  // Queue the frame for sending (the samples stay put until the stream task has written them)
+  if (streamer.enabled()) {
+    streamer.commitBlock(count);
+  }
+  return count;
+}
+
 // Function to read and map the sensor value with smoothing
 float readAndMapSensor(int &aveValue) { // Pass aveValue by reference
-  const int numReadings = 50; // number of readings to average
-  int total = 0;              // initialise a total value
+  uint16_t *block; // one block of samples from the DMA ring buffer
+
+  // Run every sample the DMA has collected since the last call through the filter (never waits, the acquisition
+  // task already runs once per LOOP_PERIOD, which is longer than one block)
+  size_t count = readSensorBlock(block, 0);
+  while (count > 0) {
+#ifdef REPLAY_BUILD
+    uint32_t blockStartUs = micros();
+#endif
+    // Samples are interleaved one channel after another, each channel has its own filter
+    for (size_t i = 0; i < count; i += SENSOR_CHANNEL_COUNT) {
+      for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+        sensorFilter[ch].update(block[i + ch]);
+      }
+    }
+    if (TRIGGER_ENABLED) {
+      trigger.feed(block, count, SENSOR_CHANNEL_COUNT); // the raw samples, so short pulses are not smoothed away
+    }
+    sensorStats.feed(block, count, SENSOR_CHANNEL_COUNT);
+    if (SPECTRUM_ENABLED) {
+      spectrum.feed(block, count, SENSOR_CHANNEL_COUNT); // an FFT every SPECTRUM_HOP decimated samples
+    }
+    instruments.addSamples(count);
+
+#ifdef REPLAY_BUILD
+    // What the pipeline made of the block goes into the digest of the pass: every filter, and the calibrated field
+    // (which depends on the chip's eFuse calibration, so a baseline is only good for one board)
+    int32_t results[SENSOR_CHANNEL_COUNT + 1];
+    for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+      results[ch] = sensorFilter[ch].value();
+    }
+    results[SENSOR_CHANNEL_COUNT] = fieldCal[0].deciGauss(sensorFilter[0].value(), OVERSAMPLE_BITS);
+    sampler.record(results, sizeof(results), micros() - blockStartUs);
+#endif
 
-  // Take multiple readings and sum them
-  for (int i = 0; i < numReadings; i++) {
-    total += analogRead(SENSOR_PIN);
-    delay(1); // small delay between readings
+    count = readSensorBlock(block, 0);
   }
 
-  // Calculate the average ave value
-  aveValue = total / numReadings;
+  // The filter always holds the latest smoothed value (unchanged if no samples arrived)
+  aveValue = sensorFilter[0].value();
 
-  // Normalize aveValue for when no voltage is on A0 (prevents the needle bouncing)
-  if (aveValue <= 30) {
-    aveValue = 0;
+  // Calibrated voltage (0V to 3.3V) from the lookup table, only the final scaling to volts is a float
+  return adcCal.millivolts(aveValue, OVERSAMPLE_BITS) * 0.001f;
+}
+
+// Value the needle shows: volts, or the field in gauss shifted so zero field is the middle of the meter
+float meterValue(const Reading &reading) {
+  if (DISPLAY_UNITS == UNITS_ADC) {
+    return reading.voltage;
+  }
+  return reading.fieldDeciGauss * 0.1f + FIELD_FULL_SCALE_GAUSS;
+}
+
+// Number shown in the readout: the ADC value (in tenths of a count when oversampling), or the field in tenths of a
+// gauss, which is the same number as hundredths of a millitesla (the decimal point is placed by the readout)
+int32_t readoutValue(const Reading &reading) {
+  if (DISPLAY_UNITS != UNITS_ADC) {
+    return reading.fieldDeciGauss;
   }
+  return OVERSAMPLE_BITS ? (reading.aveValue * 10) >> OVERSAMPLE_BITS : reading.aveValue;
+}
+
+// Raw samples per channel before a reading counts as valid: the spike rejector, then a whole moving average window
+// (or 4 IIR time constants, within 2% of the input)
+uint32_t filterSettleSamples(const Settings &config) {
+  uint32_t results = config.filterType == FILTER_IIR ? (4u << config.iirShift) : config.boxcarLength;
+  return (results << (2 * OVERSAMPLE_BITS)) + 5;
+}
+
+// Function to set up every channel's filter pipeline from the settings (only from the task that runs the filters)
+void configureFilters(const Settings &config) {
+  for (auto &filter : sensorFilter) {
+    filter.setType((FilterType)config.filterType);
+    filter.setBoxcarLength(config.boxcarLength);
+    filter.setIirShift(config.iirShift);
+    filter.setSpikeRejection(config.spikeRejection);
+    filter.setOversampling(OVERSAMPLE_BITS);
+    filter.setDeadband(config.deadband << OVERSAMPLE_BITS);
+  }
+}
 
-  // Map to voltage range (0V to 3.3V)
-  return mapValue(aveValue, 0, 4095, 0.0, 3.3);
+// Function to (re)arm the event trigger with the level and hysteresis from the settings
+void configureTrigger(const Settings &config) {
+  trigger.begin(config.triggerLevel, TRIGGER_EDGE, config.triggerHysteresis, TRIGGER_PRE_SAMPLES, TRIGGER_POST_SAMPLES);
+}
+
+// Needle value of a raw ADC reading (used for the peak-hold markers, which come from the raw samples)
+float countsToMeterValue(uint16_t counts) {
+  if (DISPLAY_UNITS == UNITS_ADC) {
+    return adcCal.millivolts(counts) * 0.001f;
+  }
+  return fieldCal[0].deciGauss(counts) * 0.1f + FIELD_FULL_SCALE_GAUSS;
 }
 
 // Function to update the meter's needle
 void updateMeter(float voltage) {
-  volts.updateNeedle(voltage, 0); // update the needle position
+  volts.updateNeedle(voltage); // update the needle position (nothing is drawn if it hasn't moved a step)
 }
 
 // Function to display the ave sensor value
 void displayaveValue(int aveValue) {
-  //static int textOffsetX = -3; // horizontal offset for the "ADC value" text
+  // Display the ave sensor value in the bottom left corner (only the digits that changed are redrawn)
+  aveReadout.update(aveValue);
+}
+
+// Time between two samples of one channel, in microseconds
+float samplePeriodUs() {
+  return SENSOR_CHANNEL_COUNT * 1e6f / sampler.sampleRate();
+}
+
+// Function to print the frozen trigger capture over serial as CSV (time relative to the trigger, raw counts)
+void printCapture() {
+  if (!trigger.captured()) {
+    Serial.println("No capture (trigger armed)");
+    return;
+  }
+
+  const uint16_t *samples = trigger.samples();
+  int triggerIndex = trigger.triggerIndex();
+  float period = samplePeriodUs();
+
+  Serial.println("us,counts");
+  for (size_t i = 0; i < trigger.length(); i++) {
+    Serial.printf("%.0f,%u\n", ((int)i - triggerIndex) * period, samples[i]);
+  }
+}
+
+// Function to draw the last trigger capture as a waveform (the lowest and highest sample in each column)
+void drawCapture() {
+  int32_t x = 5;
+  int32_t w = tft.width() - 10;
+  int32_t h = SCREEN_HEIGHT - METER_Y - 5;
+  tft.fillRect(x, METER_Y, w, h, TFT_BLACK);
+
+  uint8_t datum = tft.getTextDatum();
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+  tft.setTextDatum(TL_DATUM);
+  if (!trigger.captured()) {
+    tft.drawString("Waiting for trigger", x, METER_Y, 2);
+    tft.setTextDatum(datum);
+    return;
+  }
+
+  char text[48];
+  snprintf(text, sizeof(text), "Capture %lu  %.1f ms", (unsigned long)trigger.captureCount(),
+           trigger.length() * samplePeriodUs() / 1000);
+  tft.drawString(text, x, METER_Y, 1);
+  tft.setTextDatum(datum);
+
+  // Trigger level and the moment of the trigger
+  auto rowOf = [&](int32_t counts) { return METER_Y + h - 1 - counts * (h - 1) / 4095; };
+  const uint16_t *samples = trigger.samples();
+  size_t length = trigger.length();
+  tft.drawFastHLine(x, rowOf(settings.current().triggerLevel), w, TFT_DARKGREY);
+  tft.drawFastVLine(x + trigger.triggerIndex() * w / length, METER_Y, h, TFT_RED);
+
+  for (int32_t column = 0; column < w; column++) {
+    size_t first = column * length / w;
+    size_t last = (column + 1) * length / w;
+    uint16_t low = samples[first];
+    uint16_t high = samples[first];
+    for (size_t i = first + 1; i < last; i++) {
+      if (samples[i] < low) low = samples[i];
+      if (samples[i] > high) high = samples[i];
+    }
+    tft.drawFastVLine(x + column, rowOf(high), rowOf(low) - rowOf(high) + 1, TFT_YELLOW);
+  }
+}
+
+// Function to report a new trigger capture over serial and on the capture view (once per capture)
+void reportCapture() {
+  static uint32_t reported = 0;
+  if (!trigger.captured() || trigger.captureCount() == reported) {
+    return;
+  }
+  reported = trigger.captureCount();
+
+  if (!USB_STREAM_ENABLED && !logger.exporting()) {
+    const uint16_t *samples = trigger.samples();
+    uint16_t low = samples[0];
+    uint16_t high = samples[0];
+    for (size_t i = 1; i < trigger.length(); i++) {
+      if (samples[i] < low) low = samples[i];
+      if (samples[i] > high) high = samples[i];
+    }
+    Serial.printf("Trigger %lu: %u to %u counts over %.1f ms%s\n", (unsigned long)reported, low, high,
+                  trigger.length() * samplePeriodUs() / 1000, TRIGGER_AUTO_REARM ? "" : " (c = dump, t = re-arm)");
+  }
+
+  if (views.current() == VIEW_CAPTURE) {
+    if (useSpriteMeter) {
+      spriteMeter.finishTransfer();
+    }
+    drawCapture();
+  }
+
+  if (TRIGGER_AUTO_REARM) {
+    trigger.arm();
+  }
+}
+
+// Function to print the sliding-window statistics of the first channel over serial
+void printStatistics() {
+  static const char *names[STATS_WINDOW_COUNT] = {"1s", "10s", "60s"};
+
+  for (int w = 0; w < STATS_WINDOW_COUNT; w++) {
+    const StatsSummary &summary = stats.window[w];
+    if (summary.count == 0) {
+      continue;
+    }
+    // The mean is interpolated in the calibration table with 4 fraction bits
+    Serial.printf("%s: %lu samples | counts min %u max %u mean %.1f sd %.1f | gauss min %.1f max %.1f mean %.1f\n",
+                  names[w], (unsigned long)summary.count, summary.min, summary.max, summary.mean, sqrtf(summary.variance),
+                  fieldCal[0].deciGauss(summary.min) * 0.1f, fieldCal[0].deciGauss(summary.max) * 0.1f,
+                  fieldCal[0].deciGauss((uint32_t)(summary.mean * 16), 4) * 0.1f);
+  }
+}
+
+// Raw counts of the first channel (fractional, e.g. a mean) in the display units: volts, or the signed field
+float countsInUnits(float counts) {
+  uint32_t table = (uint32_t)(counts < 0 ? 0 : counts > 4095 ? 4095 * 16 : counts * 16); // 4 fraction bits
+  if (DISPLAY_UNITS == UNITS_ADC) {
+    return adcCal.millivolts(table, 4) * 0.001f;
+  }
+  float gauss = fieldCal[0].deciGauss(table, 4) * 0.1f;
+  return DISPLAY_UNITS == UNITS_MILLITESLA ? gauss / 10 : gauss;
+}
+
+// Amplitude of an AC signal of 'amplitude' raw counts around 'mean', in the display units (through the calibration
+// tables, so each sensor's sensitivity is taken into account)
+float amplitudeInUnits(float mean, float amplitude) {
+  return (countsInUnits(mean + amplitude) - countsInUnits(mean - amplitude)) / 2;
+}
 
-  // Convert the ave sensor value to a string
-  char aveValueStr[8];                  // buffer to hold the string version of the ave value
-  dtostrf(aveValue, 5, 0, aveValueStr); // convert aveValue to a string with 0 decimal places
+// Symbol of the display units
+const char *unitsSymbol() {
+  return DISPLAY_UNITS == UNITS_ADC ? "V" : DISPLAY_UNITS == UNITS_MILLITESLA ? "mT" : "G";
+}
 
-  // Display the ave sensor value in the bottom left corner
-  tft.setTextColor(TFT_BLACK, TFT_WHITE);                                // set text color (black on white background)
-  tft.drawRightString(aveValueStr, METER_X + 50, METER_Y + 119 - 20, 2); // adjust position as needed
+// Function to print the dominant frequency of the first channel and its amplitude over serial
+void printSpectrum() {
+  if (spectrumFrame.binHz == 0) {
+    Serial.println("No spectrum yet");
+    return;
+  }
+  Serial.printf("Spectrum: peak %.1f Hz, %.2f %s (%.1f counts) | DC %.1f counts | %.2f Hz per bin\n", spectrumFrame.peakHz,
+                amplitudeInUnits(spectrumFrame.mean, spectrumFrame.peakAmplitude), unitsSymbol(),
+                spectrumFrame.peakAmplitude, spectrumFrame.mean, spectrumFrame.binHz);
+}
 
-  // Overwrite the bottom right text with "ADC value" (originally displayed the unit 'V')
-  tft.setTextColor(TFT_BLACK, TFT_WHITE);                                                   // set text color (black on white background)
-  tft.drawString("ADC value", METER_X + 5 + 230 - 40, METER_Y + 119 - 20, 2); // adjust position with textOffsetX
+// Function to show the newest spectrum, with the dominant frequency and its amplitude above the bars
+void drawSpectrum() {
+  char caption[48];
+  if (spectrumFrame.peakHz > 0) {
+    snprintf(caption, sizeof(caption), "Peak %.1f Hz  %.2f %s", spectrumFrame.peakHz,
+             amplitudeInUnits(spectrumFrame.mean, spectrumFrame.peakAmplitude), unitsSymbol());
+  } else {
+    snprintf(caption, sizeof(caption), "No AC field");
+  }
+  spectrumView.update(spectrumFrame, caption);
+}
+
+// Function to handle a settings line sent over serial (the text after the ':')
+void handleSettingsLine(char *line) {
+  char *name = strtok(line, " =");
+  char *value = strtok(nullptr, " ");
+
+  const char *problem = nullptr;
+  if (name == nullptr) {
+    settings.print(Serial);
+    return;
+  } else if (strcmp(name, "defaults") == 0) {
+    problem = settings.restoreDefaults();
+  } else if (value == nullptr) {
+    problem = "no value given";
+  } else {
+    problem = settings.set(name, strtol(value, nullptr, 10));
+  }
+
+  if (problem != nullptr) {
+    Serial.printf("Setting not changed: %s\n", problem);
+  } else {
+    Serial.printf("Settings saved (%s)\n", name);
+  }
+}
+
+// Function to save the zero-field outputs the acquisition task captured for 'z' (saved in NVS, and applied to the
+// calibration tables by the acquisition task like any other change of the settings)
+void saveZeroCapture() {
+  ZeroCapture capture;
+  if (!zeroCaptures.pop(capture)) {
+    return;
+  }
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    char name[16];
+    snprintf(name, sizeof(name), "zeroDeciMv%d", ch);
+    uint16_t millivolts = adcCal.millivolts((uint32_t)capture.counts[ch], OVERSAMPLE_BITS);
+    const char *problem = settings.set(name, millivolts * 10);
+    Serial.printf("Channel %d zero field: %u mV%s%s\n", ch, millivolts, problem ? ", not saved: " : " (saved)",
+                  problem ? problem : "");
+  }
+}
+
+// Function to handle the commands sent over serial, single characters:
+//   z - capture the zero-field output of every sensor (no magnet nearby), saved in NVS
+//   c - print the last trigger capture as CSV
+//   t - re-arm the trigger
+//   s - print the min/max/mean/standard deviation over the last 1s, 10s and 60s
+//   f - print the dominant frequency and its amplitude (SPECTRUM_ENABLED)
+//   l - send the whole data log as stored, for tools/log_export.py (LOG_ENABLED, not while USB streaming)
+// and lines starting with ':' for the settings kept in NVS (see Settings.h):
+//   :                    - list the settings
+//   :<name> <value>      - change one, e.g. ':deadband 40' (saved straight away)
+//   :defaults            - go back to the compiled-in defaults
+void handleSerialCommands() {
+  static char line[48];
+  static size_t lineLength = 0;
+  static bool readingLine = false;
+
+  while (Serial.available() > 0) {
+    int command = Serial.read();
+
+    if (readingLine) {
+      if (command == '\n' || command == '\r') {
+        line[lineLength] = '\0';
+        readingLine = false;
+        handleSettingsLine(line);
+      } else if (lineLength < sizeof(line) - 1) {
+        line[lineLength++] = command;
+      }
+      continue;
+    }
+
+    if (command == ':') {
+      readingLine = true;
+      lineLength = 0;
+    } else if (command == 'z') {
+      zeroRequested.store(true, std::memory_order_release); // read by the acquisition task, see saveZeroCapture()
+    } else if (command == 'c') {
+      printCapture();
+    } else if (command == 't') {
+      trigger.arm();
+      Serial.println("Trigger armed");
+    } else if (command == 's') {
+      printStatistics();
+    } else if (command == 'f' && SPECTRUM_ENABLED) {
+      printSpectrum();
+    } else if (command == 'l' && logger.enabled() && !USB_STREAM_ENABLED) {
+      logger.requestExport(Serial); // sent by the log's own task, the serial reports pause meanwhile
+    }
+  }
+}
+
+// Function to print the instrumentation report over serial
+void printInstrumentation(const InstrumentReport &report) {
+  static const char *names[STAGE_COUNT] = {"acquire", "needle", "readout", "frame"};
+
+  for (int i = 0; i < STAGE_COUNT; i++) {
+    Serial.printf("%s %lu x %.1fus (max %.1fus) | ", names[i], (unsigned long)report.calls[i], report.meanUs[i], report.maxUs[i]);
+  }
+  Serial.printf("%.1f fps | ADC %.0f S/s | duty %.1f%% | missed %lu | overruns queue %lu adc %lu usb %lu\n",
+                report.framesPerSecond, report.sampleRate, report.dutyCycle * 100, (unsigned long)report.missedDeadlines, (unsigned long)report.queueOverruns,
+                (unsigned long)sampler.overrunCount(), (unsigned long)streamer.framesDropped());
+  if (dashboard.enabled()) {
+    Serial.printf("Dashboard http://%s/ | clients %lu | frames sent %lu skipped %lu missed %lu\n",
+                  WiFi.localIP().toString().c_str(), (unsigned long)dashboard.clients(),
+                  (unsigned long)dashboard.framesSent(), (unsigned long)dashboard.framesSkipped(),
+                  (unsigned long)dashboard.framesMissed());
+  }
+  if (telemetry.enabled()) {
+    Serial.printf("Telemetry %s | frames sent %lu dropped %lu | %lu bytes\n", telemetry.connected() ? "online" : "offline",
+                  (unsigned long)telemetry.framesSent(), (unsigned long)telemetry.framesDropped(),
+                  (unsigned long)telemetry.bytesSent());
+  }
+  if (logger.enabled()) {
+    Serial.printf("Log %s | %lu of %lu pages | wear %lu | dropped %lu errors %lu\n", logger.mediumName(),
+                  (unsigned long)logger.pagesUsed(), (unsigned long)logger.capacityPages(), (unsigned long)logger.maxWear(),
+                  (unsigned long)logger.recordsDropped(), (unsigned long)logger.writeErrors());
+  }
+}
+
+// Function to draw the instrumentation summary in the strip under the heading
+void drawInstrumentOverlay(const InstrumentReport &report) {
+  char text[64];
+  snprintf(text, sizeof(text), "%3.0f fps  %5.1f kS/s  acq %5.0f us  miss %-5lu ovr %-5lu", report.framesPerSecond,
+           report.sampleRate / 1000, report.meanUs[STAGE_ACQUIRE], (unsigned long)report.missedDeadlines,
+           (unsigned long)(report.queueOverruns + sampler.overrunCount()));
+
+  if (useSpriteMeter) {
+    spriteMeter.finishTransfer(); // the panel is ours until the next frame
+  }
+
+  // Fixed width text in the small font, so each update exactly covers the last one
+  uint8_t datum = tft.getTextDatum();
+  tft.setTextDatum(TC_DATUM);
+  tft.setTextColor(TFT_DARKGREY, TFT_BLACK);
+  tft.drawString(text, SCREEN_WIDTH / 2 - 10, OVERLAY_Y, 1);
+  tft.setTextDatum(datum);
+}
+
+#ifdef REPLAY_BUILD
+// Function to print each finished pass through the replayed recording (read by tools/replay_check.py)
+void reportReplay() {
+  ReplayPass pass;
+  while (sampler.nextPass(pass)) {
+    Serial.printf("Replay pass %lu: %lu samples | digest %08lx | block mean %.2f us max %lu us | overruns %lu\n",
+                  (unsigned long)pass.number, (unsigned long)pass.samples, (unsigned long)pass.digest, pass.meanBlockUs,
+                  (unsigned long)pass.maxBlockUs, (unsigned long)pass.overruns);
+  }
+}
+#endif
+
+// Function to print how long the boot took, once both the first valid reading and the first frame are in
+void reportBootTime() {
+  static bool reported = false;
+  if (reported || instruments.firstReadingUs() == 0 || instruments.firstFrameUs() == 0) {
+    return;
+  }
+  reported = true;
+
+  if (!USB_STREAM_ENABLED) {
+    Serial.printf("Boot: first valid reading %.1f ms, first frame %.1f ms (meter face %s)\n",
+                  instruments.firstReadingUs() / 1000.0f, instruments.firstFrameUs() / 1000.0f,
+                  faceFromFlash ? "from flash" : "drawn");
+  }
+}
+
+// Meter scale, units and readout format for DISPLAY_UNITS
+struct MeterScale {
+  const char *units;
+  const char *readoutLabel; // overwrites the bottom right text (originally displayed the unit 'V')
+  uint8_t decimals;
+  char labels[5][8];
+};
+
+MeterScale meterScale() {
+  MeterScale scale = {"Volts", "ADC value", OVERSAMPLE_BITS ? 1 : 0, {"0V", "0.82", "1.65", "2.47", "3.3"}};
+  if (DISPLAY_UNITS != UNITS_ADC) {
+    bool tesla = DISPLAY_UNITS == UNITS_MILLITESLA;
+    scale.units = tesla ? "mT" : "Gauss";
+    scale.readoutLabel = scale.units;
+    scale.decimals = tesla ? 2 : 1;
+    for (int i = 0; i < 5; i++) {
+      float gauss = -FIELD_FULL_SCALE_GAUSS + i * FIELD_FULL_SCALE_GAUSS / 2.0f;
+      snprintf(scale.labels[i], sizeof(scale.labels[i]), "%g", tesla ? gauss / 10 : gauss);
+    }
+  }
+  return scale;
+}
+
+// Key of the sprite meter's face drawn from 'scale' and the zones (a saved face is only used if it was drawn from
+// exactly the same scale, labels and zones)
+uint32_t meterFaceKey(const MeterScale &scale, const Settings &config) {
+  char description[128];
+  snprintf(description, sizeof(description), "%g|%s|%s|%s|%s|%s|%s|%s|%u,%u,%u,%u,%u,%u,%u,%u", METER_FULL_SCALE,
+           scale.units, scale.labels[0], scale.labels[1], scale.labels[2], scale.labels[3], scale.labels[4],
+           scale.readoutLabel, config.redStart, config.redEnd, config.orangeStart, config.orangeEnd, config.yellowStart,
+           config.yellowEnd, config.greenStart, config.greenEnd);
+  return FaceCache::hash(description);
+}
+
+// Function to draw the meter face (or the empty bars) for the meter view, with the scale for DISPLAY_UNITS
+void drawMeterFace() {
+  if (useBarMeter) {
+    // Several channels don't fit as analog meters, show a bar for each instead
+    const Settings &config = settings.current();
+    barMeter.setZones(config.redStart, config.redEnd, config.orangeStart, config.orangeEnd, config.yellowStart,
+                      config.yellowEnd, config.greenStart, config.greenEnd);
+    barMeter.begin(5, METER_Y, tft.width() - 10, SCREEN_HEIGHT - METER_Y, SENSOR_CHANNEL_COUNT, sensorLabels, 4095);
+    return;
+  }
+
+  static MeterScale scale; // static, the meter keeps pointers to the labels
+  scale = meterScale();
+  const char *units = scale.units;
+  const char *readoutLabel = scale.readoutLabel;
+  char(*scaleLabels)[8] = scale.labels;
+  uint8_t decimals = scale.decimals;
+
+  const Settings &config = settings.current();
+  if (useSpriteMeter) {
+    uint32_t key = meterFaceKey(scale, config);
+
+    faceFromFlash = FACE_CACHE_ENABLED && spriteMeter.restoreFace(faceCache, key, METER_FULL_SCALE, units);
+    if (!faceFromFlash) {
+      spriteMeter.setZones(config.redStart, config.redEnd, config.orangeStart, config.orangeEnd, config.yellowStart,
+                           config.yellowEnd, config.greenStart, config.greenEnd);
+      spriteMeter.analogMeter(METER_FULL_SCALE, units, scaleLabels[0], scaleLabels[1], scaleLabels[2], scaleLabels[3], scaleLabels[4]);
+      spriteMeter.setUnitsLabel(readoutLabel);
+      if (FACE_CACHE_ENABLED && faceSaveAllowed) {
+        spriteMeter.saveFace(faceCache, key); // for the next boot
+      } // drawn in RAM only while sampling (a changed face is saved at the next boot, which finds it missing)
+    }
+    spriteMeter.setReadoutDecimals(decimals);
+    return;
+  }
+
+  // Set up meter zones
+  volts.setZones(config.redStart, config.redEnd, config.orangeStart, config.orangeEnd, config.yellowStart, config.yellowEnd,
+                 config.greenStart, config.greenEnd); // Red, Orange, Yellow, Green
+
+  // Draw the meter
+  volts.analogMeter(METER_X, METER_Y, METER_FULL_SCALE, units, scaleLabels[0], scaleLabels[1], scaleLabels[2], scaleLabels[3], scaleLabels[4]);
+
+  // Overwrite the bottom right text, this never changes so it is drawn once
+  tft.setTextColor(TFT_BLACK, TFT_WHITE); // set text color (black on white background)
+  tft.setTextDatum(TC_DATUM);             // set text alignment to top center
+  tft.drawString(readoutLabel, METER_X + METER_UNITS_X, METER_Y + METER_READOUT_Y, 2);
+
+  // The readout in the bottom left corner (right-aligned)
+  aveReadout.begin(METER_X + METER_READOUT_X, METER_Y + METER_READOUT_Y, METER_READOUT_CELLS, 2, TFT_BLACK, TFT_WHITE);
+  aveReadout.setDecimals(decimals);
+}
+
+// Function to clear the area under the heading that the views share
+void clearViewArea() {
+  tft.fillRect(0, METER_Y, tft.width(), SCREEN_HEIGHT - METER_Y, TFT_BLACK);
+}
+
+
+/*************************************************************
+*************************** TASKS ****************************
+**************************************************************/
+
+static_assert(1 + SENSOR_CHANNEL_COUNT <= TELEMETRY_MAX_COLUMNS, "a telemetry record holds the field and every channel");
+
+// Function to add a reading to the telemetry batch, and send the batch with the statistics once it is due
+void addTelemetry(const Reading &reading) {
+  int32_t values[1 + SENSOR_CHANNEL_COUNT];
+  values[0] = reading.fieldDeciGauss;
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    values[1 + ch] = reading.channelValues[ch];
+  }
+
+  uint32_t now = millis();
+  telemetry.add(now, values, 1 + SENSOR_CHANNEL_COUNT);
+  if (telemetry.due(now, settings.current().telemetryPeriodMs)) {
+    StatsSnapshot snapshot;
+    sensorStats.summarize(snapshot);
+    telemetry.send(snapshot);
+  }
+}
+
+static_assert(SENSOR_CHANNEL_COUNT <= LOG_MAX_CHANNELS, "a log record holds the field and every channel");
+
+// Function to log a reading every LOG_PERIOD_MS, and each new trigger capture as an event
+void addLogRecords(const Reading &reading) {
+  static uint32_t lastLogMs = 0;
+  static uint32_t loggedCaptures = 0;
+
+  uint32_t now = millis();
+  if (TRIGGER_ENABLED && trigger.captureCount() != loggedCaptures) {
+    loggedCaptures = trigger.captureCount();
+    logger.logEvent(now, LOG_EVENT_TRIGGER, loggedCaptures);
+  }
+  if (now - lastLogMs >= LOG_PERIOD_MS) {
+    lastLogMs = now;
+    logger.logReading(now, reading.fieldDeciGauss, reading.channelValues, SENSOR_CHANNEL_COUNT);
+  }
+}
+
+// Read, filter and convert everything the DMA has collected, and hand the reading over to the display task
+Reading publishReading() {
+  Reading reading;
+  {
+    StageTimer timer(instruments, STAGE_ACQUIRE);
+    reading.voltage = readAndMapSensor(reading.aveValue);
+  }
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    reading.channelValues[ch] = sensorFilter[ch].value() >> OVERSAMPLE_BITS;
+  }
+  reading.fieldDeciGauss = fieldCal[0].deciGauss(reading.aveValue, OVERSAMPLE_BITS);
+
+  // The first reading made from a full filter window is the first one worth showing
+  if (instruments.totalSamples() / SENSOR_CHANNEL_COUNT >= filterSettleSamples(settings.current())) {
+    instruments.markFirstReading();
+  }
+
+  // Hand the reading over (if the display has fallen behind, drop it rather than wait). Readings published while
+  // setup() is still drawing, before the display task exists, are not counted as dropped.
+  if (!readingQueue.push(reading) && displayTaskHandle != nullptr) {
+    instruments.queueOverrun();
+  }
+
+  // Telemetry, the dashboard and the log only ever copy into their own buffers here, their own tasks do the sending
+  if (logger.enabled()) {
+    addLogRecords(reading);
+  }
+  if (telemetry.enabled()) {
+    addTelemetry(reading);
+  }
+  if (dashboard.enabled()) {
+    dashboard.add(millis(), reading.fieldDeciGauss, reading.channelValues);
+  }
+  return reading;
+}
+
+// Low-power mode: short bursts of sampling with the ADC stopped and the CPUs asleep in between. Returns, with the ADC
+// running continuously again, once the field moves away from 'reference' or the button is pressed, with the newest
+// averaged value.
+int runLowPower(int reference) {
+  bool lightSleep = LOW_POWER_LIGHT_SLEEP && !USB_STREAM_ENABLED && !wifiEnabled; // a light sleep drops Wi-Fi
+  bool displayIdle = false; // a light sleep must not start while the display task is using the panel bus
+
+  power.enterLowPower(BACKLIGHT_DIM);
+  buttons.pause(); // a press wakes the chip instead
+  ulTaskNotifyTake(pdTRUE, 0); // forget any old notification from the display task
+  if (logger.enabled()) {
+    logger.logEvent(millis(), LOG_EVENT_LOW_POWER, 1);
+  }
+
+  for (;;) {
+    sampler.end();
+    instruments.slept(power.sleep(LOW_POWER_SLEEP_MS, lightSleep && displayIdle));
+
+    // Sample long enough for the filters to settle, then publish one reading
+    sampler.begin(sensorChannels, SENSOR_CHANNEL_COUNT, ADC_SAMPLE_RATE_HZ);
+    vTaskDelay(pdMS_TO_TICKS(LOW_POWER_BURST_MS));
+    settings.acknowledge();
+    Reading reading = publishReading();
+
+    if (abs(reading.aveValue - reference) > (LOW_POWER_WAKE_THRESHOLD << OVERSAMPLE_BITS) || power.wokeOnPin() ||
+        digitalRead(VIEW_BUTTON_PIN) == LOW) {
+      power.exitLowPower();
+      buttons.resume(); // the press that woke the chip is not also a click
+      xTaskNotifyGive(displayTaskHandle); // back to drawing on its own schedule
+      if (logger.enabled()) {
+        logger.logEvent(millis(), LOG_EVENT_LOW_POWER, 0);
+      }
+      return reading.aveValue;
+    }
+
+    // In low-power mode the display task draws one frame per burst and then reports back
+    xTaskNotifyGive(displayTaskHandle);
+    displayIdle = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100)) > 0;
+  }
+}
+
+// Acquisition task: filters the sampled data and queues a reading for the display every LOOP_PERIOD
+void acquisitionTask(void *parameter) {
+  TickType_t lastWake = xTaskGetTickCount();
+  uint32_t lastStart = micros();
+  uint32_t steadySince = millis();
+  int reference = 0; // the value the field has been steady at since 'steadySince'
+  uint32_t appliedGeneration = settings.generation();
+  Settings applied = settings.current();
+
+  for (;;) {
+    // Nothing is held from the settings of the last pass: the copies swapped out before now may be reused
+    settings.acknowledge();
+
+    // Run on a fixed period that doesn't depend on how long the display takes
+    uint32_t period = settings.current().loopPeriodMs;
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(period));
+
+    // A period noticeably longer than the loop period (more than one tick) is a missed deadline
+    uint32_t start = micros();
+    if (start - lastStart > (period + portTICK_PERIOD_MS) * 1000) {
+      instruments.missedDeadline();
+    }
+    lastStart = start;
+
+    // Settings changed over serial are applied here, by the task that owns the filters and the trigger
+    if (settings.generation() != appliedGeneration) {
+      appliedGeneration = settings.generation();
+      const Settings &config = settings.current();
+      configureFilters(config); // a filter only starts again if its type or length changed
+      if (config.triggerLevel != applied.triggerLevel || config.triggerHysteresis != applied.triggerHysteresis) {
+        configureTrigger(config);
+      }
+      for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+        if (config.zeroDeciMv[ch] != applied.zeroDeciMv[ch]) {
+          fieldCal[ch].setZeroField(config.zeroDeciMv[ch] * 0.1f); // built aside and swapped in
+        }
+      }
+      applied = config;
+      if (logger.enabled()) {
+        logger.logEvent(millis(), LOG_EVENT_SETTINGS, appliedGeneration);
+      }
+    }
+
+    // Read and map the sensor value, and pass it on to the display
+    Reading reading = publishReading();
+
+    // A zero-field capture is taken from the filters here, by the task that owns them
+    if (zeroRequested.exchange(false, std::memory_order_acq_rel)) {
+      ZeroCapture capture;
+      for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+        capture.counts[ch] = sensorFilter[ch].value();
+      }
+      zeroCaptures.push(capture);
+    }
+
+    // Drop into low-power mode once the field has been steady for a while (and nobody is pressing the button)
+    if (abs(reading.aveValue - reference) > (LOW_POWER_WAKE_THRESHOLD << OVERSAMPLE_BITS) ||
+        digitalRead(VIEW_BUTTON_PIN) == LOW) {
+      reference = reading.aveValue;
+      steadySince = millis();
+    }
+    if (LOW_POWER_ENABLED && millis() - steadySince >= LOW_POWER_IDLE_MS) {
+      reference = runLowPower(reference);
+      steadySince = millis();
+      lastWake = xTaskGetTickCount(); // the tick count doesn't advance in a light sleep, so start the period again
+      lastStart = micros();
+    }
+  }
+}
+
+// Needle position (in meter steps) of a voltage for whichever meter is in use
+int needlePosition(float voltage) {
+  return useSpriteMeter ? spriteMeter.position(voltage) : volts.position(voltage);
+}
+
+// Function to move the peak-hold markers to the lowest and highest sample of a window, returns true if they moved
+bool setPeakMarkers(const StatsSummary &summary) {
+  static int shownLow = MARKER_NONE;
+  static int shownHigh = MARKER_NONE;
+  if (useBarMeter || summary.count == 0) {
+    return false;
+  }
+
+  float low = countsToMeterValue(summary.min);
+  float high = countsToMeterValue(summary.max);
+  if (needlePosition(low) == shownLow && needlePosition(high) == shownHigh) {
+    return false;
+  }
+  shownLow = needlePosition(low);
+  shownHigh = needlePosition(high);
+
+  if (useSpriteMeter) {
+    spriteMeter.setMarkers(low, high);
+  } else {
+    volts.setMarkers(low, high);
+  }
+  return true;
+}
+
+// How far the display still has to move (needle steps, or bar pixels) to show 'reading' instead of 'drawn', and
+// whether any of the values shown changed. 'drawnNeedle' is the needle value on screen (part way there while the
+// needle is gliding).
+int displayDelta(const Reading &reading, const Reading &drawn, float drawnNeedle, bool &valueChanged) {
+  valueChanged = readoutValue(reading) != readoutValue(drawn);
+  if (!useBarMeter) {
+    return needlePosition(meterValue(reading)) - needlePosition(drawnNeedle);
+  }
+
+  int delta = 0;
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    int d = barMeter.pixelDelta(ch, reading.channelValues[ch]);
+    if (d > delta) delta = d;
+    valueChanged |= reading.channelValues[ch] != drawn.channelValues[ch];
+  }
+  return delta;
+}
+
+static_assert(offsetof(Settings, greenEnd) - offsetof(Settings, redStart) == 7, "the zones must be the last 8 bytes of Settings");
+
+// Function to apply changed settings to the display, returns true if the meter face was redrawn
+bool applyDisplaySettings(const Settings &config, const Settings &previous) {
+  frameScheduler.begin(config.displayMinPeriodMs, config.displayMaxPeriodMs, DISPLAY_ADAPTIVE, DISPLAY_FAST_STEPS);
+
+  // New zones need a new face, or bars drawn again in the new colours (the zones are the last 8 bytes of the settings)
+  if (memcmp(&config.redStart, &previous.redStart, 8) == 0 || views.current() != VIEW_METER) {
+    return false;
+  }
+  if (useSpriteMeter) {
+    spriteMeter.finishTransfer();
+  }
+  clearViewArea();
+  drawMeterFace();
+  return true;
+}
+
+/*************************************************************
+*************************** VIEWS ****************************
+**************************************************************/
+
+Reading newestReading = {0, 0.0f, {}, 0}; // newest reading, kept by the display task
+float needleValue = 0;                    // where the gliding needle is now
+bool redrawMeter = false;                 // draw the next meter frame even if nothing moved
+uint32_t trendColumns = 0;                // trend columns added so far
+bool spectrumFresh = false;               // a spectrum not shown yet
+
+// Function to wait for the meter's DMA transfer before another view uses the panel
+void finishMeterTransfer() {
+  if (useSpriteMeter) {
+    spriteMeter.finishTransfer();
+  }
+}
+
+// Meter view: the face is SpriteMeter's own cached copy (or drawn by the widget), the needle is drawn every frame it moves
+void enterMeter() {
+  clearViewArea();
+  drawMeterFace();
+  redrawMeter = true; // the face was just drawn without its needle
+}
+
+void meterFrame() {
+  static Reading drawn = {-1, 0.0f, {}, 0}; // what the panel shows (-1 forces the first frame)
+  static float drawnNeedle = 0;             // needle value on the panel
+  const Reading &reading = newestReading;
+
+  // Skip the frame if the needle (or bars) wouldn't move and the readouts wouldn't change. While the needle is
+  // still on its way the scheduler sees the distance left, so it keeps the frame rate up until it arrives.
+  bool valueChanged;
+  int delta = displayDelta(reading, drawn, drawnNeedle, valueChanged);
+  if (!frameScheduler.shouldDraw(delta, valueChanged) && !redrawMeter) {
+    return;
+  }
+  redrawMeter = false;
+  drawn = reading;
+  drawnNeedle = needleValue;
+
+  StageTimer frameTimer(instruments, STAGE_FRAME);
+  instruments.markFirstFrame();
+
+  if (useBarMeter) {
+    // One bar per channel, each only redraws the part that changed
+    StageTimer timer(instruments, STAGE_NEEDLE);
+    for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+      barMeter.update(ch, reading.channelValues[ch]);
+    }
+    return;
+  }
+
+  if (useSpriteMeter) {
+    // Compose the needle and readout off-screen and push the whole frame
+    spriteMeter.update(needleValue, readoutValue(reading));
+    return;
+  }
+
+  // Update the analog meter's needle
+  {
+    StageTimer timer(instruments, STAGE_NEEDLE);
+    updateMeter(needleValue);
+  }
+
+  // Display the ave sensor value
+  {
+    StageTimer timer(instruments, STAGE_READOUT);
+    displayaveValue(readoutValue(reading)); // raw ADC value or field strength, depending on DISPLAY_UNITS
+  }
+}
+
+// Trend view: the chart is its own circular sprite, sent again whenever a column was added
+void enterTrend() {
+  clearViewArea();
+  trendView.draw();
+}
+
+void trendFrame() {
+  static uint32_t drawnColumns = 0;
+  if (trendColumns == drawnColumns) {
+    return;
+  }
+  drawnColumns = trendColumns;
+  StageTimer frameTimer(instruments, STAGE_FRAME);
+  trendView.draw();
+}
+
+// Statistics view: a table of the three windows over a cached background, only the cells that changed are redrawn
+#define STATS_ROW_Y 46      // first row, from the top of the view area
+#define STATS_ROW_HEIGHT 26
+#define STATS_COLUMNS 5     // samples, min, max, mean, standard deviation
+
+const int16_t statsColumnRight[STATS_COLUMNS] = {100, 160, 215, 270, 325}; // right edge of each column
+char statsShown[STATS_WINDOW_COUNT][STATS_COLUMNS][12];
+
+void drawStatsLayer(TFT_eSPI &canvas, int16_t w, int16_t) {
+  static const char *titles[STATS_COLUMNS] = {"samples", "min", "max", "mean", "sd"};
+  static const char *names[STATS_WINDOW_COUNT] = {"1s", "10s", "60s"};
+
+  char title[32];
+  snprintf(title, sizeof(title), "Statistics (%s)", unitsSymbol());
+  canvas.setTextColor(TFT_WHITE, TFT_BLACK);
+  canvas.setTextDatum(TL_DATUM);
+  canvas.drawString(title, 5, 0, 2);
+
+  canvas.setTextColor(TFT_DARKGREY, TFT_BLACK);
+  canvas.setTextDatum(TR_DATUM);
+  for (int column = 0; column < STATS_COLUMNS; column++) {
+    canvas.drawString(titles[column], statsColumnRight[column], STATS_ROW_Y - 18, 1);
+  }
+  canvas.drawFastHLine(5, STATS_ROW_Y - 6, w - 10, TFT_DARKGREY);
+
+  canvas.setTextColor(TFT_WHITE, TFT_BLACK);
+  canvas.setTextDatum(TL_DATUM);
+  for (int row = 0; row < STATS_WINDOW_COUNT; row++) {
+    canvas.drawString(names[row], 5, STATS_ROW_Y + row * STATS_ROW_HEIGHT, 2);
+  }
+}
+
+void enterStats() {
+  memset(statsShown, 0, sizeof(statsShown)); // every cell is drawn on the next frame
+}
+
+void statsFrame() {
+  int decimals = DISPLAY_UNITS == UNITS_ADC ? 3 : DISPLAY_UNITS == UNITS_MILLITESLA ? 2 : 1;
+  uint8_t datum = tft.getTextDatum();
+  tft.setTextDatum(TR_DATUM);
+  tft.setTextColor(TFT_WHITE, TFT_BLACK);
+
+  for (int row = 0; row < STATS_WINDOW_COUNT; row++) {
+    const StatsSummary &summary = stats.window[row];
+    char cells[STATS_COLUMNS][12];
+    if (summary.count == 0) {
+      for (auto &cell : cells) {
+        snprintf(cell, sizeof(cell), "-");
+      }
+    } else {
+      snprintf(cells[0], sizeof(cells[0]), "%lu", (unsigned long)summary.count);
+      snprintf(cells[1], sizeof(cells[1]), "%.*f", decimals, countsInUnits(summary.min));
+      snprintf(cells[2], sizeof(cells[2]), "%.*f", decimals, countsInUnits(summary.max));
+      snprintf(cells[3], sizeof(cells[3]), "%.*f", decimals, countsInUnits(summary.mean));
+      snprintf(cells[4], sizeof(cells[4]), "%.*f", decimals, amplitudeInUnits(summary.mean, sqrtf(summary.variance)));
+    }
+
+    for (int column = 0; column < STATS_COLUMNS; column++) {
+      if (strcmp(cells[column], statsShown[row][column]) == 0) {
+        continue;
+      }
+      tft.setTextPadding(column == 0 ? 60 : 52); // covers the longest value the cell has shown
+      tft.drawString(cells[column], statsColumnRight[column], METER_Y + STATS_ROW_Y + row * STATS_ROW_HEIGHT, 2);
+      memcpy(statsShown[row][column], cells[column], sizeof(cells[column]));
+    }
+  }
+  tft.setTextPadding(0);
+  tft.setTextDatum(datum);
+}
+
+// Capture view: redrawn by reportCapture() on each new capture, BOOT re-arms the trigger
+void enterCapture() {
+  clearViewArea();
+  drawCapture();
+}
+
+void captureAction(const ButtonEvent &event) {
+  if (event.action == BUTTON_CLICK) {
+    trigger.arm();
+    drawCapture(); // "Waiting for trigger"
+  }
+}
+
+// Spectrum view: the frequency axis is a cached background, the bars only redraw what changed
+void drawSpectrumLayer(TFT_eSPI &canvas, int16_t, int16_t) {
+  spectrumView.drawBackground(canvas, 0, METER_Y);
+}
+
+void enterSpectrum() {
+  spectrumView.reset();
+  spectrumFresh = true; // show the newest spectrum straight away
+}
+
+void spectrumViewFrame() {
+  if (!spectrumFresh) {
+    return;
+  }
+  spectrumFresh = false;
+  StageTimer frameTimer(instruments, STAGE_FRAME);
+  drawSpectrum();
+}
+
+// Settings view: BOOT clicks select the next setting, holding BOOT raises its value (faster the longer it is held,
+// wrapping from the top of its range to the bottom) and letting go saves it
+#define CONFIG_ROW_Y 22      // first row, from the top of the view area
+#define CONFIG_ROW_HEIGHT 11
+#define CONFIG_ROWS 9        // rows on screen, the list scrolls with the selection
+
+uint8_t configSelected = 0;
+bool configEditing = false;
+uint32_t configValue = 0; // value being edited
+bool configChanged = true;
+char configStatus[48] = "";
+
+void drawConfigLayer(TFT_eSPI &canvas, int16_t w, int16_t) {
+  canvas.setTextColor(TFT_WHITE, TFT_BLACK);
+  canvas.setTextDatum(TL_DATUM);
+  canvas.drawString("Settings", 5, 0, 2);
+  canvas.setTextColor(TFT_DARKGREY, TFT_BLACK);
+  canvas.setTextDatum(TR_DATUM);
+  canvas.drawString("BOOT: next / hold to raise", w - 5, 4, 1);
+}
+
+void enterConfig() {
+  configEditing = false;
+  configChanged = true;
+}
+
+void configFrame() {
+  static uint32_t shownGeneration = 0;
+  if (settings.generation() != shownGeneration) {
+    shownGeneration = settings.generation(); // changed over serial too
+    configChanged = true;
+  }
+  if (!configChanged) {
+    return;
+  }
+  configChanged = false;
+
+  int count = settings.fieldCount();
+  int top = configSelected - CONFIG_ROWS / 2;
+  if (top > count - CONFIG_ROWS) top = count - CONFIG_ROWS;
+  if (top < 0) top = 0;
+
+  uint8_t datum = tft.getTextDatum();
+  for (int row = 0; row < CONFIG_ROWS && top + row < count; row++) {
+    uint8_t field = top + row;
+    bool selected = field == configSelected;
+    uint16_t low, high;
+    settings.fieldLimits(field, low, high);
+    uint32_t value = selected && configEditing ? configValue : settings.fieldValue(field);
+    int32_t y = METER_Y + CONFIG_ROW_Y + row * CONFIG_ROW_HEIGHT;
+
+    char text[24];
+    uint16_t background = selected ? (configEditing ? TFT_ORANGE : TFT_DARKGREY) : TFT_BLACK;
+    tft.setTextColor(TFT_WHITE, background);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextPadding(170);
+    tft.drawString(settings.fieldName(field), 5, y, 1);
+    snprintf(text, sizeof(text), "%lu", (unsigned long)value);
+    tft.setTextDatum(TR_DATUM);
+    tft.setTextPadding(60);
+    tft.drawString(text, 235, y, 1);
+    snprintf(text, sizeof(text), "%u-%u", low, high);
+    tft.setTextColor(TFT_DARKGREY, TFT_BLACK);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextPadding(90);
+    tft.drawString(text, 245, y, 1);
+  }
+
+  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+  tft.setTextPadding(tft.width() - 10);
+  tft.drawString(configStatus, 5, METER_Y + CONFIG_ROW_Y + CONFIG_ROWS * CONFIG_ROW_HEIGHT + 4, 1);
+  tft.setTextPadding(0);
+  tft.setTextDatum(datum);
+}
+
+void configAction(const ButtonEvent &event) {
+  uint16_t low, high;
+  settings.fieldLimits(configSelected, low, high);
+
+  if (event.action == BUTTON_CLICK) {
+    configSelected = (configSelected + 1) % settings.fieldCount();
+    configStatus[0] = '\0';
+  } else if (event.action == BUTTON_HOLD || event.action == BUTTON_REPEAT) {
+    if (event.action == BUTTON_HOLD) {
+      configEditing = true;
+      configValue = settings.fieldValue(configSelected);
+    }
+    uint32_t step = event.repeats >= 30 ? 100 : event.repeats >= 10 ? 10 : 1;
+    configValue = configValue >= high ? low : configValue + step > high ? high : configValue + step;
+  } else if (event.action == BUTTON_RELEASE && configEditing) {
+    configEditing = false;
+    const char *name = settings.fieldName(configSelected);
+    const char *problem = settings.set(name, configValue); // saved to NVS, and applied by the tasks
+    if (problem != nullptr) {
+      snprintf(configStatus, sizeof(configStatus), "Not changed: %s", problem);
+    } else {
+      snprintf(configStatus, sizeof(configStatus), "Saved %s = %lu", name, (unsigned long)configValue);
+    }
+  }
+  configChanged = true;
+}
+
+// The views in the order the KEY button goes through them (indexed by the VIEW_ numbers)
+const ViewSpec viewTable[VIEW_COUNT] = {
+  {"meter", 0, true, nullptr, enterMeter, meterFrame, nullptr},
+  {"trend", TREND_PERIOD_MS, true, nullptr, enterTrend, trendFrame, nullptr},
+  {"stats", STATS_VIEW_PERIOD_MS, true, drawStatsLayer, enterStats, statsFrame, nullptr},
+  {"capture", CAPTURE_VIEW_PERIOD_MS, TRIGGER_ENABLED, nullptr, enterCapture, nullptr, captureAction},
+  {"spectrum", SPECTRUM_FRAME_MS, SPECTRUM_ENABLED, drawSpectrumLayer, enterSpectrum, spectrumViewFrame, nullptr},
+  {"config", CONFIG_VIEW_PERIOD_MS, true, drawConfigLayer, enterConfig, configFrame, configAction},
+};
+
+// One pass of the display task: poll the instrumentation, serial and buttons, keep the readings, trend and spectrum
+// up to date, then draw a frame of the view on screen
+void displayFrame() {
+  static InstrumentReport report;
+  static uint32_t lastTrendMs = millis();
+  static uint32_t lastPassUs = micros();
+  static uint32_t appliedGeneration = 0;
+  static Settings applied = settings.current();
+
+  // Once per reporting window, publish the instrumentation
+  if (instruments.poll(millis(), INSTRUMENT_PERIOD_MS, report)) {
+    if (INSTRUMENT_SERIAL && !USB_STREAM_ENABLED && !logger.exporting()) {
+      printInstrumentation(report);
+    }
+    if (INSTRUMENT_OVERLAY) {
+      drawInstrumentOverlay(report);
+    }
+  }
+
+  handleSerialCommands();
+  saveZeroCapture();
+  settings.applyPending(); // a change made while the acquisition task still had both spare copies
+  reportBootTime();
+#ifdef REPLAY_BUILD
+  reportReplay();
+#endif
+  if (TRIGGER_ENABLED) {
+    reportCapture();
+  }
+
+  // Only the newest reading matters for the display (keep the last one if nothing new arrived)
+  readingQueue.popLatest(newestReading);
+
+  if (settings.generation() != appliedGeneration) {
+    appliedGeneration = settings.generation();
+    redrawMeter |= applyDisplaySettings(settings.current(), applied);
+    applied = settings.current();
+  }
+
+  // Button events, debounced by the timer interrupt (switching view redraws the area under the heading)
+  ButtonEvent event;
+  while (buttons.next(event)) {
+    views.handle(event);
+  }
+
+  // Peak-hold markers follow the statistics of the raw samples
+  if (sensorStats.latest(stats) && PEAK_HOLD_ENABLED) {
+    redrawMeter |= setPeakMarkers(stats.window[PEAK_HOLD_WINDOW]);
+  }
+
+  // The trend keeps recording whichever view is on screen, one column per TREND_PERIOD_MS (catching up after slower
+  // frames, or starting again after a long gap such as low-power mode)
+  uint32_t now = millis();
+  for (int i = 0; i < TREND_CATCH_UP && now - lastTrendMs >= TREND_PERIOD_MS; i++) {
+    lastTrendMs += TREND_PERIOD_MS;
+    trendView.add(meterValue(newestReading));
+    trendColumns++;
+  }
+  if (now - lastTrendMs >= TREND_PERIOD_MS) {
+    lastTrendMs = now;
+  }
+
+  // The needle keeps gliding towards the newest reading whether or not it is on screen
+  uint32_t passUs = micros();
+  float target = meterValue(newestReading);
+  needleValue = NEEDLE_ANIMATION ? needleAnimator.update(target, passUs - lastPassUs) : target;
+  lastPassUs = passUs;
+
+  if (SPECTRUM_ENABLED && spectrum.latest(spectrumFrame)) {
+    spectrumFresh = true;
+  }
+
+  // Only the view on screen draws anything
+  views.frame();
+}
+
+// Display task: draws a frame at the rate the view on screen asks for (for the meter, the rate chosen by the frame
+// scheduler) or straight away on a button press, or once per burst in low-power mode
+void displayTask(void *parameter) {
+  TickType_t lastWake = xTaskGetTickCount();
+
+  for (;;) {
+    if (power.lowPower()) {
+      // Wait for the acquisition task's burst, and tell it when the panel is free again (so it can sleep)
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      displayFrame();
+      finishMeterTransfer();
+      xTaskNotifyGive(acquisitionTaskHandle);
+      lastWake = xTaskGetTickCount();
+      continue;
+    }
+
+    // Sleep until the next frame is due, unless a button event comes first (the frames stay on their period)
+    TickType_t period = pdMS_TO_TICKS(frameScheduler.periodMs());
+    TickType_t elapsed = xTaskGetTickCount() - lastWake;
+    bool pressed = elapsed < period && buttons.wait(period - elapsed);
+    if (!pressed) {
+      lastWake += period;
+    }
+    displayFrame();
+  }
 }
 
 
@@ -132,16 +1642,100 @@ void displayaveValue(int aveValue) {
 **************************************************************/
 
 // SETUP
+// Function to start the ADC, the statistics and spectrum at its rate, and the acquisition task
+void startSampling() {
+  // All channels in one sweep
+  sampler.begin(sensorChannels, SENSOR_CHANNEL_COUNT, ADC_SAMPLE_RATE_HZ);
+  sensorStats.begin(sampler.sampleRate() / SENSOR_CHANNEL_COUNT);
+  if (SPECTRUM_ENABLED) {
+    spectrum.begin(sampler.sampleRate() / SENSOR_CHANNEL_COUNT);
+  }
+
+#ifndef BENCHMARK_BUILD
+  // Filtering starts on core 0 now, so the filters have settled by the time the face is on screen
+  xTaskCreatePinnedToCore(acquisitionTask, "acquisition", TASK_STACK_SIZE, NULL, ACQUISITION_PRIORITY, &acquisitionTaskHandle,
+                          ACQUISITION_CORE);
+#endif
+}
+
 void setup(void) {
+  // Native USB serial port (used for raw sample streaming and the instrumentation report)
+  Serial.begin(115200);
+  if (USB_STREAM_ENABLED) {
+    streamer.begin(Serial, SENSOR_CHANNEL_COUNT, USB_STREAM_CORE, USB_STREAM_PRIORITY);
+  }
+
+  // Load the settings saved over serial (or the defaults), then configure the filter pipelines from them
+  bool stored = settings.begin(defaultSettings);
+  Serial.printf("Settings: %s (send ':' to list)\n", stored ? "loaded from NVS" : "defaults");
+  configureFilters(settings.current());
+
+  // Build the calibration tables from the chip's eFuse calibration and each sensor's saved zero-field output
+  adcCal.begin();
+  for (int ch = 0; ch < SENSOR_CHANNEL_COUNT; ch++) {
+    fieldCal[ch].begin(adcCal, settings.current().zeroDeciMv[ch] * 0.1f);
+  }
+  Serial.printf("ADC calibration: %s\n", adcCal.source());
+
+  // Arm the event trigger before the first samples arrive
+  configureTrigger(settings.current());
+
+  // The data log, on the SD card if there is one (its task finds the end of the log in the background)
+  if (LOG_ENABLED) {
+    const LogConfig logConfig = {LOG_SD_ENABLED, LOG_SD_SCK, LOG_SD_MISO, LOG_SD_MOSI, LOG_SD_CS, LOG_SD_BYTES,
+                                 FACE_CACHE_SIZE, LOG_FLUSH_MS};
+    if (logger.begin(logConfig, LOG_CORE, LOG_PRIORITY)) {
+      uint32_t perPage = (LOG_PAGE_BYTES - 16) / (8 + 2 * SENSOR_CHANNEL_COUNT); // after the page header, per record
+      Serial.printf("Data log: %s, %lu pages (~%.0f hours of readings, 'l' to export)\n", logger.mediumName(),
+                    (unsigned long)logger.capacityPages(), logger.capacityPages() * perPage * (LOG_PERIOD_MS / 3.6e6f));
+      logger.logEvent(millis(), LOG_EVENT_BOOT, esp_reset_reason());
+    } else {
+      Serial.println("Data log: no storage");
+    }
+  }
+
+  // Wi-Fi connects in the background while the rest starts up
+  if (wifiEnabled) {
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(true);
+    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+  }
+  if (TELEMETRY_ENABLED) {
+    const TelemetryConfig telemetryConfig = {TELEMETRY_TRANSPORT, TELEMETRY_HOST, TELEMETRY_PORT, TELEMETRY_TOPIC};
+    telemetry.begin(telemetryConfig, TELEMETRY_CORE, TELEMETRY_PRIORITY);
+  }
+  if (DASHBOARD_ENABLED) {
+    dashboard.begin(DASHBOARD_PORT, SENSOR_CHANNEL_COUNT, sensorLabels, FIELD_FULL_SCALE_GAUSS, DASHBOARD_DECIMATION,
+                    DASHBOARD_CORE, DASHBOARD_PRIORITY);
+  }
+
+#ifdef REPLAY_BUILD
+  // The recording takes the place of the ADC
+  sampler.load(REPLAY_SAMPLES, sizeof(REPLAY_SAMPLES) / sizeof(REPLAY_SAMPLES[0]), REPLAY_CHANNELS, REPLAY_SAMPLE_RATE_HZ);
+  Serial.printf("Replay: %s, %lu samples per pass at %lu S/s\n", REPLAY_SOURCE, (unsigned long)sampler.sampleCount(),
+                (unsigned long)sampler.sampleRate());
+#endif
+
+  // Start sampling in the background straight away, unless the meter face has to be drawn and saved to flash first
+  faceCache.begin();
+  faceSaveAllowed = FACE_CACHE_ENABLED && !useBarMeter && RENDER_MODE == RENDER_SPRITE &&
+                    !faceCache.holds(meterFaceKey(meterScale(), settings.current()), SPRITE_METER_WIDTH, SPRITE_METER_HEIGHT);
+  if (!faceSaveAllowed) {
+    startSampling();
+  }
+
+  // Buttons sampled and debounced by a timer interrupt from now on (the events wait for the display task)
+  const uint8_t buttonPins[] = {VIEW_BUTTON_PIN, ACTION_BUTTON_PIN};
+  buttons.begin(buttonPins, 2, BUTTON_TIMER);
+
+  // Display supply on before the panel is initialised (it is off when running from the battery)
+  power.begin(VIEW_BUTTON_PIN);
   tft.init();
+  power.attachBacklight();
   tft.setRotation(1); // adjust rotation (0 & 2 portrait | 1 & 3 landscape)
 
-  // Set up meter zones
-  volts.setZones(0, 100, 25, 75, 0, 0, 40, 60); // Red, Orange, Yellow, Green
-
-  // Draw the meter
-  tft.fillScreen(TFT_BLACK); // clear the screen
-  volts.analogMeter(METER_X, METER_Y, 3.3, "Volts", "0V", "0.82", "1.65", "2.47", "3.3");
+  // Clear the screen
+  tft.fillScreen(TFT_BLACK);
 
   // Add the heading at the top center of the screen
   tft.setTextColor(TFT_WHITE, TFT_BLACK); // set text color (white on black background)
@@ -150,25 +1744,44 @@ void setup(void) {
 
   // Draw the heading
   tft.drawString("KY035 Analog Hall Magnetic Sensor Module", SCREEN_WIDTH / 2 - 10, 5, 2); // needed 10 extra pixels to the left
-}
 
-// MAIN LOOP
-void loop() {
-  static uint32_t updateTime = 0;
+  // Draw the meter off-screen if there is room for the frame buffers (the face comes from flash if it was saved)
+  useSpriteMeter = !useBarMeter && (RENDER_MODE == RENDER_SPRITE) && spriteMeter.begin(METER_X, METER_Y);
+  drawMeterFace();
+  if (faceSaveAllowed) {
+    faceSaveAllowed = false; // saved, from now on a face is only drawn in RAM
+    startSampling();
+  }
 
-  if (millis() - updateTime >= LOOP_PERIOD) {
-    updateTime = millis();
+  // Trend chart under the heading, recording from the start (shown when the button selects it)
+  trendView.begin(5, METER_Y, tft.width() - 10, SCREEN_HEIGHT - METER_Y - 5, 0, METER_FULL_SCALE);
+  if (SPECTRUM_ENABLED) {
+    spectrumView.begin(5, METER_Y, tft.width() - 10, SCREEN_HEIGHT - METER_Y - 5, spectrum.barHz());
+  }
 
-    // Initialise the averaged sensor value
-    int aveValue;
+  // The other views share the area under the heading, the meter view is on screen already
+  viewLayers.begin(0, METER_Y, tft.width(), SCREEN_HEIGHT - METER_Y);
+  views.begin(viewTable, VIEW_COUNT, VIEW_METER, 0, 1, finishMeterTransfer);
 
-    // Read and map the sensor value, and get the aveValue
-    float voltage = readAndMapSensor(aveValue);
+  // Display refresh rate, and the needle starting from rest at the bottom of the scale
+  frameScheduler.begin(settings.current().displayMinPeriodMs, settings.current().displayMaxPeriodMs, DISPLAY_ADAPTIVE,
+                       DISPLAY_FAST_STEPS);
+  needleAnimator.begin(NEEDLE_TIME_CONSTANT_MS, 0);
 
-    // Update the analog meter's needle
-    updateMeter(voltage);
+#ifdef BENCHMARK_BUILD
+  // Time each stage of the hot path and print the results before the normal tasks start (the acquisition task starts
+  // afterwards here, as the benchmarks drive the filters themselves)
+  runBenchmarks();
+  xTaskCreatePinnedToCore(acquisitionTask, "acquisition", TASK_STACK_SIZE, NULL, ACQUISITION_PRIORITY, &acquisitionTaskHandle,
+                          ACQUISITION_CORE);
+#endif
 
-    // Display the ave sensor value
-    displayaveValue(aveValue); // pass aveValue to the displayaveValue function
-  }
-}
\ No newline at end of file
+  // Start drawing the readings, the first frame sends the face and needle to the panel in one DMA transfer
+  xTaskCreatePinnedToCore(displayTask, "display", TASK_STACK_SIZE, NULL, DISPLAY_PRIORITY, &displayTaskHandle, DISPLAY_CORE);
+}
+
+// MAIN LOOP
+void loop() {
+  // All the work is done by the acquisition and display tasks, so the Arduino loop task isn't needed
+  vTaskDelete(NULL);
+}
@@ -0,0 +1,12 @@
+// Just enough of Arduino.h for the modules built by the native test environment (see platformio.ini)
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IRAM_ATTR
@@ -0,0 +1,165 @@
+// Step responses of the filter stages in Filters.h (pio test -e native)
+
+#include <unity.h>
+#include <math.h>
+#include "Filters.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Until the window is full the average is over the samples seen so far, then it ramps to the step in N samples
+void test_boxcar_step() {
+  BoxcarFilter<8> boxcar;
+  boxcar.setLength(4);
+  for (int i = 0; i < 4; i++) {
+    TEST_ASSERT_EQUAL_INT32(0, boxcar.update(0));
+  }
+
+  const int32_t expected[] = {25, 50, 75, 100, 100, 100};
+  for (int32_t value : expected) {
+    TEST_ASSERT_EQUAL_INT32(value, boxcar.update(100));
+  }
+}
+
+void test_boxcar_partial_window() {
+  BoxcarFilter<8> boxcar;
+  TEST_ASSERT_EQUAL_INT32(0, boxcar.value()); // nothing yet
+  TEST_ASSERT_EQUAL_INT32(90, boxcar.update(90));
+  TEST_ASSERT_EQUAL_INT32(60, boxcar.update(30));
+  TEST_ASSERT_EQUAL_INT32(50, boxcar.update(30));
+}
+
+void test_boxcar_length_change_starts_again() {
+  BoxcarFilter<8> boxcar;
+  for (int i = 0; i < 8; i++) {
+    boxcar.update(1000);
+  }
+  boxcar.setLength(2);
+  TEST_ASSERT_EQUAL_INT(2, (int)boxcar.length());
+  TEST_ASSERT_EQUAL_INT32(0, boxcar.value());
+  TEST_ASSERT_EQUAL_INT32(10, boxcar.update(10)); // the old samples are gone
+  TEST_ASSERT_EQUAL_INT32(15, boxcar.update(20));
+  TEST_ASSERT_EQUAL_INT32(25, boxcar.update(30));
+
+  boxcar.setLength(1000); // clamped to the capacity
+  TEST_ASSERT_EQUAL_INT(8, (int)boxcar.length());
+}
+
+// y += (x - y) / 2^shift is 1 - (1 - 1/2^shift)^n of the step after n samples, and settles on the step exactly
+void test_iir_step() {
+  IirFilter iir(2);
+  TEST_ASSERT_EQUAL_INT32(0, iir.update(0)); // primed with the first sample, no ramp from 0
+  for (int n = 1; n <= 20; n++) {
+    int32_t expected = lround(1000 * (1 - pow(0.75, n)));
+    TEST_ASSERT_INT_WITHIN(1, expected, iir.update(1000));
+  }
+  for (int n = 0; n < 100; n++) {
+    iir.update(1000);
+  }
+  TEST_ASSERT_EQUAL_INT32(1000, iir.value());
+}
+
+void test_iir_primes_on_first_sample() {
+  IirFilter iir(6);
+  TEST_ASSERT_EQUAL_INT32(2048, iir.update(2048));
+  TEST_ASSERT_EQUAL_INT32(2048, iir.update(2048));
+
+  iir.reset();
+  TEST_ASSERT_EQUAL_INT32(0, iir.value());
+  TEST_ASSERT_EQUAL_INT32(-300, iir.update(-300));
+}
+
+// A step comes through the median of 5 two samples late, a single spike not at all
+void test_median_step_and_spike() {
+  MedianFilter<5> median;
+  for (int i = 0; i < 5; i++) {
+    TEST_ASSERT_EQUAL_INT32(0, median.update(0));
+  }
+  TEST_ASSERT_EQUAL_INT32(0, median.update(100));
+  TEST_ASSERT_EQUAL_INT32(0, median.update(100));
+  TEST_ASSERT_EQUAL_INT32(100, median.update(100));
+  TEST_ASSERT_EQUAL_INT32(100, median.update(100));
+
+  median.reset();
+  const int32_t input[] = {10, 10, 10, 4000, 10, 10, -4000, 10, 10};
+  for (int32_t sample : input) {
+    TEST_ASSERT_EQUAL_INT32(10, median.update(sample));
+  }
+}
+
+// 4^bits samples make one result with 'bits' more bits of resolution
+void test_decimator_step() {
+  Decimator decimator(1);
+  for (int i = 0; i < 3; i++) {
+    TEST_ASSERT_FALSE(decimator.update(100));
+  }
+  TEST_ASSERT_TRUE(decimator.update(100));
+  TEST_ASSERT_EQUAL_INT32(200, decimator.value()); // 100 in half steps
+
+  // A step half way through a group shows as the average of the group
+  decimator.setBits(2);
+  for (int i = 0; i < 16; i++) {
+    bool done = decimator.update(i < 8 ? 1000 : 2000);
+    TEST_ASSERT_EQUAL_INT(i == 15, done);
+  }
+  TEST_ASSERT_EQUAL_INT32(1500 * 4, decimator.value());
+
+  // The extra bit comes from the noise: 1, 2, 1, 2 is 1.5
+  decimator.setBits(1);
+  const int32_t noisy[] = {1, 2, 1, 2};
+  for (int32_t sample : noisy) {
+    decimator.update(sample);
+  }
+  TEST_ASSERT_EQUAL_INT32(3, decimator.value());
+}
+
+void test_deadband() {
+  Deadband deadband(40);
+  TEST_ASSERT_EQUAL_INT32(0, deadband.apply(0));
+  TEST_ASSERT_EQUAL_INT32(0, deadband.apply(40));
+  TEST_ASSERT_EQUAL_INT32(41, deadband.apply(41));
+  TEST_ASSERT_EQUAL_INT32(0, deadband.apply(-500));
+  TEST_ASSERT_EQUAL_INT32(4095, deadband.apply(4095));
+
+  deadband.setThreshold(0);
+  TEST_ASSERT_EQUAL_INT32(1, deadband.apply(1));
+}
+
+// Spike rejector -> decimator -> boxcar -> deadband, in the order the acquisition task uses them
+void test_pipeline_step() {
+  FilterPipeline<16> pipeline;
+  pipeline.setType(FILTER_BOXCAR);
+  pipeline.setBoxcarLength(2);
+  pipeline.setSpikeRejection(true);
+  pipeline.setOversampling(1);
+  pipeline.setDeadband(50);
+
+  // Below the deadband, with a spike the median takes out
+  const int32_t quiet[] = {10, 10, 10, 3000, 10, 10, 10, 10};
+  for (int32_t sample : quiet) {
+    TEST_ASSERT_EQUAL_INT32(0, pipeline.update(sample));
+  }
+
+  // A step to 1000 (2000 in half steps): two samples late through the median, then averaged over two results
+  for (int i = 0; i < 16; i++) {
+    pipeline.update(1000);
+  }
+  TEST_ASSERT_EQUAL_INT32(2000, pipeline.value());
+
+  pipeline.setType(FILTER_NONE);
+  TEST_ASSERT_EQUAL_INT32(0, pipeline.value()); // a new type starts again
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_boxcar_step);
+  RUN_TEST(test_boxcar_partial_window);
+  RUN_TEST(test_boxcar_length_change_starts_again);
+  RUN_TEST(test_iir_step);
+  RUN_TEST(test_iir_primes_on_first_sample);
+  RUN_TEST(test_median_step_and_spike);
+  RUN_TEST(test_decimator_step);
+  RUN_TEST(test_deadband);
+  RUN_TEST(test_pipeline_step);
+  return UNITY_END();
+}
@@ -0,0 +1,150 @@
+// BlockKernels vector versions against the scalar ones, and the scalar ones against a plain loop (or the table). On
+// the host only the scalar versions exist (pio test -e native); on the board the PIE versions are checked
+// (pio test -e board-test).
+
+#include <unity.h>
+#include <Arduino.h>
+#include "BlockKernels.h"
+
+#define TEST_SAMPLES 1024
+#define TEST_LENGTHS 40 // every length up to this is checked at every alignment
+
+alignas(16) static int16_t samples[TEST_SAMPLES + 8];
+alignas(16) static uint16_t counts[TEST_SAMPLES + 8];
+static int16_t table[4096];
+static uint32_t noise = 1;
+
+void setUp() {}
+void tearDown() {}
+
+static int16_t nextNoise() {
+  noise = noise * 1664525 + 1013904223;
+  return (int16_t)(noise >> 16);
+}
+
+// What every kernel should give for samples[offset .. offset + length)
+static void checkBlock(size_t offset, size_t length) {
+  const int16_t *block = samples + offset;
+  int64_t sum = 0, sumSquares = 0;
+  int16_t low = INT16_MAX, high = INT16_MIN;
+  for (size_t i = 0; i < length; i++) {
+    sum += block[i];
+    sumSquares += (int32_t)block[i] * block[i];
+    low = block[i] < low ? block[i] : low;
+    high = block[i] > high ? block[i] : high;
+  }
+
+  BlockStats vector, scalar;
+  blockStats(block, length, vector);
+  blockStatsScalar(block, length, scalar);
+  TEST_ASSERT_EQUAL_INT64(sum, scalar.sum);
+  TEST_ASSERT_EQUAL_INT64(sumSquares, scalar.sumSquares);
+  TEST_ASSERT_EQUAL_INT16(low, scalar.min);
+  TEST_ASSERT_EQUAL_INT16(high, scalar.max);
+  TEST_ASSERT_EQUAL_INT64(sum, vector.sum);
+  TEST_ASSERT_EQUAL_INT64(sumSquares, vector.sumSquares);
+  TEST_ASSERT_EQUAL_INT16(low, vector.min);
+  TEST_ASSERT_EQUAL_INT16(high, vector.max);
+
+  TEST_ASSERT_EQUAL_INT64(sum, blockSum(block, length));
+  TEST_ASSERT_EQUAL_INT64(sum, blockSumScalar(block, length));
+  TEST_ASSERT_EQUAL_INT64(sumSquares, blockSumSquares(block, length));
+  TEST_ASSERT_EQUAL_INT64(sumSquares, blockSumSquaresScalar(block, length));
+
+  int16_t vectorLow, vectorHigh, scalarLow, scalarHigh;
+  blockMinMax(block, length, vectorLow, vectorHigh);
+  blockMinMaxScalar(block, length, scalarLow, scalarHigh);
+  TEST_ASSERT_EQUAL_INT16(low, vectorLow);
+  TEST_ASSERT_EQUAL_INT16(high, vectorHigh);
+  TEST_ASSERT_EQUAL_INT16(low, scalarLow);
+  TEST_ASSERT_EQUAL_INT16(high, scalarHigh);
+}
+
+// 12-bit samples like the ADC's, so the scalar head and tail around the vectors are covered at every alignment
+void test_adc_samples_every_alignment() {
+  for (size_t i = 0; i < TEST_SAMPLES + 8; i++) {
+    samples[i] = nextNoise() & 0xFFF;
+  }
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 0; length <= TEST_LENGTHS; length++) {
+      checkBlock(offset, length);
+    }
+  }
+  checkBlock(0, TEST_SAMPLES);
+  checkBlock(1, TEST_SAMPLES);
+}
+
+// The full signed range, for the lane compares and the 40-bit accumulators
+void test_extreme_values() {
+  for (size_t i = 0; i < TEST_SAMPLES + 8; i++) {
+    samples[i] = (i % 3 == 0) ? INT16_MIN : (i % 3 == 1) ? INT16_MAX : nextNoise();
+  }
+  checkBlock(0, 256);
+  checkBlock(3, 200);
+
+  for (size_t i = 0; i < TEST_SAMPLES + 8; i++) {
+    samples[i] = -1; // every lane negative, the sum must come out signed
+  }
+  checkBlock(0, TEST_SAMPLES);
+  checkBlock(5, 77);
+}
+
+// The table lookup of counts[offset .. offset + length), against the scalar version and the table itself
+static void checkLookup(size_t offset, size_t length) {
+  static int16_t vector[TEST_SAMPLES], scalar[TEST_SAMPLES];
+  blockLookup(counts + offset, vector, length, table, 4095);
+  blockLookupScalar(counts + offset, scalar, length, table, 4095);
+  for (size_t i = 0; i < length; i++) {
+    TEST_ASSERT_EQUAL_INT16(table[counts[offset + i] & 4095], scalar[i]);
+    TEST_ASSERT_EQUAL_INT16(scalar[i], vector[i]);
+  }
+}
+
+// Counts with bits above the mask into a signed table (the loads must sign-extend), at every alignment
+void test_lookup_every_alignment() {
+  for (int i = 0; i < 4096; i++) {
+    table[i] = 2047 - i;
+  }
+  for (size_t i = 0; i < TEST_SAMPLES + 8; i++) {
+    counts[i] = (uint16_t)nextNoise();
+  }
+  for (size_t offset = 0; offset < 8; offset++) {
+    for (size_t length = 0; length <= TEST_LENGTHS; length++) {
+      checkLookup(offset, length);
+    }
+  }
+  checkLookup(0, TEST_SAMPLES);
+  checkLookup(3, TEST_SAMPLES);
+}
+
+// A block with nothing in it
+void test_empty_block() {
+  BlockStats stats;
+  blockStats(samples, 0, stats);
+  TEST_ASSERT_EQUAL_INT32(0, stats.sum);
+  TEST_ASSERT_EQUAL_INT64(0, stats.sumSquares);
+  TEST_ASSERT_EQUAL_INT16(INT16_MAX, stats.min);
+  TEST_ASSERT_EQUAL_INT16(INT16_MIN, stats.max);
+}
+
+static int runTests() {
+  UNITY_BEGIN();
+  RUN_TEST(test_adc_samples_every_alignment);
+  RUN_TEST(test_extreme_values);
+  RUN_TEST(test_lookup_every_alignment);
+  RUN_TEST(test_empty_block);
+  return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+  delay(2000); // time for the test runner to open the port
+  runTests();
+}
+
+void loop() {}
+#else
+int main() {
+  return runTests();
+}
+#endif
@@ -0,0 +1,54 @@
+// FixedMapper against mapValue(), the float reference in FixedMap.h (pio test -e native)
+
+#include <unity.h>
+#include <math.h>
+#include "FixedMap.h"
+
+void setUp() {}
+void tearDown() {}
+
+typedef FixedMapper<0, 4095, 0, 3300> AdcToMillivolts;
+typedef FixedMapper<0, 4095, -1000, 1000> AdcToSigned;
+typedef FixedMapper<0, 10, 0, 1> Tenths;
+
+void test_end_points() {
+  TEST_ASSERT_EQUAL_INT32(0, AdcToMillivolts::map(0));
+  TEST_ASSERT_EQUAL_INT32(3300, AdcToMillivolts::map(4095));
+  TEST_ASSERT_EQUAL_INT32(1650, AdcToMillivolts::map(2048)); // the example in FixedMap.h
+
+  TEST_ASSERT_EQUAL_INT32(-1000, AdcToSigned::map(0));
+  TEST_ASSERT_EQUAL_INT32(1000, AdcToSigned::map(4095));
+}
+
+// Rounded to the nearest output step, halves up
+void test_rounding() {
+  TEST_ASSERT_EQUAL_INT32(0, Tenths::map(4));  // 0.4
+  TEST_ASSERT_EQUAL_INT32(1, Tenths::map(5));  // 0.5
+  TEST_ASSERT_EQUAL_INT32(1, Tenths::map(14)); // 1.4, past the end (not clamped)
+  TEST_ASSERT_EQUAL_INT32(2, Tenths::map(15)); // 1.5
+}
+
+// Every 12-bit input is within one step of the rounded float mapping, and the output never goes backwards
+void test_whole_range_against_float() {
+  int32_t previous = AdcToMillivolts::map(0);
+  for (int32_t raw = 0; raw <= 4095; raw++) {
+    int32_t fixed = AdcToMillivolts::map(raw);
+    long reference = lroundf(mapValue(raw, 0, 4095, 0, 3300));
+    TEST_ASSERT_INT_WITHIN(1, reference, fixed);
+    TEST_ASSERT_TRUE(fixed >= previous);
+    previous = fixed;
+
+    TEST_ASSERT_INT_WITHIN(1, lroundf(mapValue(raw, 0, 4095, -1000, 1000)), AdcToSigned::map(raw));
+  }
+}
+
+// The conversion is constexpr, so a mapped constant costs nothing at run time
+static_assert(AdcToMillivolts::map(4095) == 3300, "FixedMapper must map the end of the range exactly");
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_end_points);
+  RUN_TEST(test_rounding);
+  RUN_TEST(test_whole_range_against_float);
+  return UNITY_END();
+}
@@ -0,0 +1,159 @@
+// SampleStatistics windows against a brute-force pass over the same samples (pio test -e native)
+
+#include <unity.h>
+#include <math.h>
+#include <vector>
+#include "Statistics.h"
+
+#define RATE 1000 // samples per second: 10 per 10ms bucket, windows of 1000, 10000 and 60000 samples
+
+void setUp() {}
+void tearDown() {}
+
+static uint32_t noise = 12345;
+
+// A drifting level with noise and the odd spike, in 12-bit counts
+static uint16_t nextSample(uint32_t n) {
+  noise = noise * 1664525 + 1013904223;
+  int32_t value = 2048 + (int32_t)(1500 * sin(n / 3000.0)) + (int32_t)(noise >> 24) - 128;
+  if ((noise & 0x3FF) == 7) {
+    value = (noise >> 16) & 1 ? 4095 : 0;
+  }
+  return value < 0 ? 0 : (value > 4095 ? 4095 : value);
+}
+
+// What a window should show once 'total' samples were fed: the last whole buckets of 'bucketSamples', at most
+// STATS_BUCKETS of them
+static void checkWindow(const std::vector<uint16_t> &samples, const StatsSummary &summary, uint32_t bucketSamples) {
+  size_t end = samples.size() / bucketSamples * bucketSamples;
+  size_t buckets = end / bucketSamples < STATS_BUCKETS ? end / bucketSamples : STATS_BUCKETS;
+  size_t start = end - buckets * bucketSamples;
+
+  TEST_ASSERT_EQUAL_UINT32(end - start, summary.count);
+  if (end == start) {
+    return;
+  }
+
+  uint16_t low = UINT16_MAX, high = 0;
+  double sum = 0, sumSquares = 0;
+  for (size_t i = start; i < end; i++) {
+    low = samples[i] < low ? samples[i] : low;
+    high = samples[i] > high ? samples[i] : high;
+    sum += samples[i];
+    sumSquares += (double)samples[i] * samples[i];
+  }
+  double mean = sum / (end - start);
+  double rms = sqrt(sumSquares / (end - start));
+  double deviation = sqrt(sumSquares / (end - start) - mean * mean);
+
+  TEST_ASSERT_EQUAL_UINT16(low, summary.min);
+  TEST_ASSERT_EQUAL_UINT16(high, summary.max);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-3, mean, summary.mean);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-3, rms, sqrt(summary.variance + (double)summary.mean * summary.mean));
+  TEST_ASSERT_DOUBLE_WITHIN(1e-2, deviation, sqrt(summary.variance));
+}
+
+static void checkAll(const std::vector<uint16_t> &samples, const SampleStatistics &stats) {
+  StatsSnapshot snapshot;
+  stats.summarize(snapshot);
+  const uint32_t bucket = RATE * STATS_BUCKET_MS / 1000;
+  checkWindow(samples, snapshot.window[STATS_1S], bucket);       // 10ms buckets
+  checkWindow(samples, snapshot.window[STATS_10S], bucket * 10); // 100ms
+  checkWindow(samples, snapshot.window[STATS_60S], bucket * 60); // 600ms
+}
+
+void test_empty_until_first_bucket() {
+  SampleStatistics stats;
+  stats.begin(RATE);
+  uint16_t block[9] = {100, 200, 300, 400, 500, 600, 700, 800, 900};
+  stats.feed(block, 9);
+
+  StatsSnapshot snapshot;
+  TEST_ASSERT_FALSE(stats.latest(snapshot));
+  stats.summarize(snapshot);
+  TEST_ASSERT_EQUAL_UINT32(0, snapshot.window[STATS_1S].count);
+
+  uint16_t last = 1000;
+  stats.feed(&last, 1);
+  TEST_ASSERT_TRUE(stats.latest(snapshot));
+  TEST_ASSERT_EQUAL_UINT32(10, snapshot.window[STATS_1S].count);
+  TEST_ASSERT_EQUAL_UINT16(100, snapshot.window[STATS_1S].min);
+  TEST_ASSERT_EQUAL_UINT16(1000, snapshot.window[STATS_1S].max);
+  TEST_ASSERT_DOUBLE_WITHIN(1e-3, 550, snapshot.window[STATS_1S].mean);
+  TEST_ASSERT_EQUAL_UINT32(0, snapshot.window[STATS_10S].count); // no whole 100ms bucket yet
+}
+
+// Contiguous blocks of uneven lengths (the vector kernels' path), past the point where every window slides
+void test_sliding_windows_against_brute_force() {
+  SampleStatistics stats;
+  stats.begin(RATE);
+  std::vector<uint16_t> samples;
+  noise = 12345;
+
+  uint16_t block[300];
+  uint32_t nextCheck = 0;
+  while (samples.size() < 75000) {
+    size_t length = 1 + (noise >> 8) % 300;
+    for (size_t i = 0; i < length; i++) {
+      block[i] = nextSample(samples.size());
+      samples.push_back(block[i]);
+    }
+    stats.feed(block, length);
+
+    if (samples.size() >= nextCheck) {
+      checkAll(samples, stats);
+      nextCheck += 4999; // lands at different places in the buckets
+    }
+  }
+  checkAll(samples, stats);
+}
+
+// One channel of an interleaved block (the scalar path), the other channel must not leak in
+void test_interleaved_channel() {
+  SampleStatistics stats;
+  stats.begin(RATE);
+  std::vector<uint16_t> samples;
+  noise = 999;
+
+  uint16_t block[2 * 128];
+  while (samples.size() < 25000) {
+    for (size_t i = 0; i < 128; i++) {
+      block[2 * i] = 4095; // the other channel
+      block[2 * i + 1] = nextSample(samples.size()) / 2;
+      samples.push_back(block[2 * i + 1]);
+    }
+    stats.feed(block + 1, 2 * 128 - 1, 2);
+  }
+  checkAll(samples, stats);
+}
+
+// A window that has seen its min or max leave forgets it
+void test_extremes_expire() {
+  SampleStatistics stats;
+  stats.begin(RATE);
+  std::vector<uint16_t> samples;
+
+  uint16_t sample = 4000;
+  stats.feed(&sample, 1);
+  samples.push_back(sample);
+  sample = 2000;
+  for (int i = 0; i < 1500; i++) {
+    stats.feed(&sample, 1);
+    samples.push_back(sample);
+  }
+
+  StatsSnapshot snapshot;
+  stats.summarize(snapshot);
+  TEST_ASSERT_EQUAL_UINT16(2000, snapshot.window[STATS_1S].max);  // the peak was more than 1s ago
+  TEST_ASSERT_EQUAL_UINT16(4000, snapshot.window[STATS_10S].max); // but still inside 10s
+  checkAll(samples, stats);
+}
+
+int main() {
+  UNITY_BEGIN();
+  RUN_TEST(test_empty_until_first_bucket);
+  RUN_TEST(test_sliding_windows_against_brute_force);
+  RUN_TEST(test_interleaved_channel);
+  RUN_TEST(test_extremes_expire);
+  return UNITY_END();
+}
@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""
+Gzips a web page and writes it out as a C array in flash, for the Dashboard to serve as it is.
+
+The page is compressed once here rather than on every request, so the device only copies bytes out of
+flash and the browser does the unzipping (the response is sent with Content-Encoding: gzip).
+
+Usage:
+    python3 tools/embed_page.py web/dashboard.html include/DashboardPage.h
+"""
+
+import argparse
+import gzip
+import os
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Embed a gzipped web page in a C header")
+    parser.add_argument("page", help="HTML file to embed")
+    parser.add_argument("header", help="header file to write")
+    parser.add_argument("--name", default="DASHBOARD_PAGE", help="name of the array")
+    args = parser.parse_args()
+
+    with open(args.page, "rb") as f:
+        page = f.read()
+    data = gzip.compress(page, compresslevel=9, mtime=0)  # mtime 0 keeps the output the same for the same page
+
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+
+    with open(args.header, "w") as f:
+        f.write("// Generated by tools/embed_page.py from %s (%d bytes, %d gzipped), do not edit\n\n"
+                % (os.path.basename(args.page), len(page), len(data)))
+        f.write("#pragma once\n\n#include <Arduino.h>\n\n")
+        f.write("const uint8_t %s[] PROGMEM = {\n%s\n};\n" % (args.name, "\n".join(lines)))
+
+    print("%s: %d bytes, %d gzipped" % (args.header, len(page), len(data)))
+
+
+if __name__ == "__main__":
+    main()
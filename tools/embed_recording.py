@@ -0,0 +1,95 @@
+#!/usr/bin/env python3
+"""
+Writes a recorded sample stream out as a C array in flash, for the replay build (REPLAY_BUILD, see
+include/SampleReplay.h) to play back in place of the ADC.
+
+The input is a file saved by tools/stream_reader.py --out (one sweep of raw 12-bit values per line,
+comma separated when several channels are scanned). Without one, --synthetic writes a made-up test
+signal instead: the zero-field output with noise, a 50Hz hum, a few single-sample spikes and a magnet
+passing the sensor, so the filters, the trigger, the statistics and the spectrum all have something to do.
+The synthetic signal is the same on every run.
+
+Usage:
+    python3 tools/stream_reader.py /dev/ttyACM0 --out samples.txt    (with USB_STREAM_ENABLED)
+    python3 tools/embed_recording.py samples.txt include/ReplayRecording.h --rate 20000
+    python3 tools/embed_recording.py --synthetic 0.4 include/ReplayRecording.h
+"""
+
+import argparse
+import math
+import os
+
+MAX_SAMPLES = 1 << 20  # 2MB of flash
+
+
+def read_recording(path):
+    """Return (channels, samples interleaved channel by channel) from a stream_reader.py file."""
+    sweeps = []
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if line:
+                sweeps.append([int(value) for value in line.split(",")])
+    if not sweeps:
+        raise SystemExit("%s: no samples" % path)
+    channels = len(sweeps[0])
+    if any(len(sweep) != channels for sweep in sweeps):
+        raise SystemExit("%s: every line must have the same number of channels" % path)
+    return channels, [value for sweep in sweeps for value in sweep]
+
+
+def synthetic(seconds, rate):
+    """One channel of made-up sensor output (raw counts), the same every time."""
+    count = int(seconds * rate)
+    seed = 12345
+    samples = []
+    for i in range(count):
+        t = i / rate
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF  # fixed LCG, so the noise is the same on every run
+        noise = (seed >> 16) % 9 - 4
+        hum = 25 * math.sin(2 * math.pi * 50 * t)
+        magnet = 700 * math.exp(-(((t - seconds / 2) / 0.01) ** 2))  # a 20ms wide pass halfway through
+        value = 2048 + hum + magnet + noise
+        if i % 2000 == 1000:
+            value += 900  # a single-sample spike for the median rejector
+        samples.append(max(0, min(4095, int(round(value)))))
+    return samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Embed a recorded sample stream in a C header")
+    parser.add_argument("recording", nargs="?", help="file saved by stream_reader.py --out")
+    parser.add_argument("header", help="header file to write")
+    parser.add_argument("--rate", type=int, default=20000, help="conversions per second, all channels together")
+    parser.add_argument("--synthetic", type=float, metavar="SECONDS", help="write a test signal instead")
+    args = parser.parse_args()
+
+    if args.synthetic:
+        channels, samples = 1, synthetic(args.synthetic, args.rate)
+        source = "synthetic %.2fs" % args.synthetic
+    elif args.recording:
+        channels, samples = read_recording(args.recording)
+        source = os.path.basename(args.recording)
+    else:
+        raise SystemExit("give a recording or --synthetic")
+    samples = samples[:MAX_SAMPLES - MAX_SAMPLES % channels]
+
+    lines = []
+    for i in range(0, len(samples), 16):
+        lines.append("    " + ",".join("%d" % value for value in samples[i:i + 16]) + ",")
+
+    with open(args.header, "w") as f:
+        f.write("// Generated by tools/embed_recording.py from %s (%d samples of %d channels at %d S/s), do not edit\n\n"
+                % (source, len(samples), channels, args.rate))
+        f.write("#pragma once\n\n#include <Arduino.h>\n\n")
+        f.write("#define REPLAY_CHANNELS %d\n" % channels)
+        f.write("#define REPLAY_SAMPLE_RATE_HZ %d\n" % args.rate)
+        f.write("#define REPLAY_SOURCE \"%s\"\n\n" % source)
+        f.write("const uint16_t REPLAY_SAMPLES[] PROGMEM = {\n%s\n};\n" % "\n".join(lines))
+
+    print("%s: %d samples of %d channels (%.2fs)" % (args.header, len(samples), channels,
+                                                     len(samples) / args.rate))
+
+
+if __name__ == "__main__":
+    main()
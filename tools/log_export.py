@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+Export of the data log (LOG_ENABLED in src/main.cpp, format in include/DataLogger.h).
+
+Sends 'l' to the T-Display-S3, receives every page of the log in one go, and then decodes it on the host:
+pages that fail their CRC check (erased ones, or one cut short by a power loss) are skipped, the rest are
+put in sequence order. The readings are written to a CSV file (time in ms since boot, field in gauss, then
+the raw value of each channel) and the events are printed. A boot event marks where the time starts again.
+
+Usage:
+    pip install pyserial
+    python3 tools/log_export.py /dev/ttyACM0 [--out log.csv] [--raw log.bin]
+    python3 tools/log_export.py --from-raw log.bin [--out log.csv]
+"""
+
+import argparse
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = 0x31474C4B  # "KLG1"
+PAGE = struct.Struct("<IIII")  # magic, sequence, wear, crc
+RECORD = struct.Struct("<BBI")  # type, size, timeMs
+READING = 1
+EVENT = 2
+EVENTS = {1: "boot", 2: "trigger", 3: "low power", 4: "settings"}
+HEADER_LINE = re.compile(rb"Log export: (\d+) pages of (\d+) bytes")
+
+
+def receive(port_name):
+    """Ask for an export and return the raw pages as one bytes object."""
+    import serial
+
+    port = serial.Serial(port_name, 115200, timeout=5)
+    port.reset_input_buffer()
+    port.write(b"l")
+    while True:
+        line = port.readline()
+        if not line:
+            raise SystemExit("no reply (is LOG_ENABLED set, and USB streaming off?)")
+        match = HEADER_LINE.search(line)
+        if match:
+            break
+
+    pages, page_bytes = int(match.group(1)), int(match.group(2))
+    data = port.read(pages * page_bytes)
+    if len(data) != pages * page_bytes:
+        raise SystemExit("export cut short: %d of %d bytes" % (len(data), pages * page_bytes))
+    return data, page_bytes
+
+
+def pages(data, page_bytes):
+    """Yield (sequence, wear, page) for every page that passes its check."""
+    for start in range(0, len(data) - page_bytes + 1, page_bytes):
+        page = data[start:start + page_bytes]
+        magic, sequence, wear, crc = PAGE.unpack_from(page, 0)
+        if magic != MAGIC or zlib.crc32(page[PAGE.size:], zlib.crc32(page[:12])) != crc:
+            continue
+        yield sequence, wear, page
+
+
+def records(page):
+    """Yield (type, timeMs, payload) for the records of one page."""
+    pos = PAGE.size
+    while pos + RECORD.size <= len(page) and page[pos] != 0xFF:
+        kind, size, time_ms = RECORD.unpack_from(page, pos)
+        if size < RECORD.size or pos + size > len(page):
+            break  # can't happen in a page that passed its check, unless the layout changed
+        yield kind, time_ms, page[pos + RECORD.size:pos + size]
+        pos += size
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Export and decode the KY035 data log")
+    parser.add_argument("port", nargs="?", help="serial port of the T-Display-S3, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--from-raw", help="decode a file saved with --raw instead of reading the device")
+    parser.add_argument("--raw", help="also save the pages as received")
+    parser.add_argument("--out", default="log.csv", help="CSV file for the readings (default log.csv)")
+    args = parser.parse_args()
+
+    if args.from_raw:
+        data, page_bytes = open(args.from_raw, "rb").read(), 512
+    elif args.port:
+        data, page_bytes = receive(args.port)
+    else:
+        parser.error("give a serial port or --from-raw")
+    if args.raw:
+        with open(args.raw, "wb") as raw:
+            raw.write(data)
+
+    good = sorted(pages(data, page_bytes))
+    readings = 0
+    with open(args.out, "w") as out:
+        out.write("ms,gauss,raw...\n")
+        for _, _, page in good:
+            for kind, time_ms, payload in records(page):
+                if kind == READING:
+                    field = struct.unpack_from("<h", payload, 0)[0]
+                    raw = struct.unpack_from("<%dH" % ((len(payload) - 2) // 2), payload, 2)
+                    out.write("%d,%.1f,%s\n" % (time_ms, field / 10, ",".join(map(str, raw))))
+                    readings += 1
+                elif kind == EVENT:
+                    code, value = struct.unpack_from("<Hi", payload, 0)
+                    print("%10d ms  %s %d" % (time_ms, EVENTS.get(code, "event %d" % code), value))
+
+    total = len(data) // page_bytes
+    wear = max((w for _, w, _ in good), default=0)
+    print("%d pages received, %d valid, %d readings written to %s, most worn block %d cycles"
+          % (total, len(good), readings, args.out, wear))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Regression check for the replay build (pio run -e replay, see include/SampleReplay.h).
+
+Reads the "Replay pass" lines the board prints after each pass through the embedded recording and
+compares the first few passes with a baseline saved earlier:
+  - functional: the digest of every pass must be the same as in the baseline (any change to what the
+    filters or the calibration make of the same samples changes it)
+  - performance: the mean time to process a block must not be more than --tolerance slower
+  - the playback must never have fallen behind (overruns)
+Exits with 1 if anything doesn't match, so it can gate a change. The baseline is per board, as the
+calibrated field in the digest depends on the chip's eFuse calibration, and the settings in NVS should
+be the defaults (send ':defaults' first).
+
+Usage:
+    pip install pyserial
+    pio run -e replay -t upload
+    python3 tools/replay_check.py /dev/ttyACM0 --save baseline.json     (once, on a known good build)
+    python3 tools/replay_check.py /dev/ttyACM0 --baseline baseline.json
+"""
+
+import argparse
+import json
+import re
+import sys
+
+PASS_LINE = re.compile(r"Replay pass (\d+): (\d+) samples \| digest ([0-9a-f]+) \| block mean ([\d.]+) us "
+                       r"max (\d+) us \| overruns (\d+)")
+
+
+def read_passes(port_name, count, timeout):
+    """Reset the board and return the first 'count' passes as dicts."""
+    import serial
+
+    port = serial.Serial(port_name, 115200, timeout=timeout)
+    port.dtr = False  # reset, so the first pass starts from the filters as they are at boot
+    port.rts = True
+    port.rts = False
+    passes = []
+    while len(passes) < count:
+        line = port.readline()
+        if not line:
+            raise SystemExit("no replay report within %ds (is the replay build running?)" % timeout)
+        match = PASS_LINE.search(line.decode(errors="replace"))
+        if match:
+            number, samples, digest, mean_us, max_us, overruns = match.groups()
+            passes.append({"pass": int(number), "samples": int(samples), "digest": digest,
+                           "mean_us": float(mean_us), "max_us": int(max_us), "overruns": int(overruns)})
+            print(line.decode(errors="replace").strip())
+    return passes
+
+
+def compare(passes, baseline, tolerance):
+    """Return a list of the differences from the baseline."""
+    problems = []
+    for run, base in zip(passes, baseline["passes"]):
+        name = "pass %d" % run["pass"]
+        if run["samples"] != base["samples"]:
+            problems.append("%s: %d samples, the baseline had %d (a different recording)"
+                            % (name, run["samples"], base["samples"]))
+        elif run["digest"] != base["digest"]:
+            problems.append("%s: digest %s, expected %s" % (name, run["digest"], base["digest"]))
+        if run["mean_us"] > base["mean_us"] * (1 + tolerance):
+            problems.append("%s: %.2f us per block, %.0f%% slower than %.2f us"
+                            % (name, run["mean_us"], 100 * (run["mean_us"] / base["mean_us"] - 1), base["mean_us"]))
+        if run["overruns"]:
+            problems.append("%s: the pipeline fell %d blocks behind" % (name, run["overruns"]))
+    return problems
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare a replay run with a saved baseline")
+    parser.add_argument("port", help="serial port of the T-Display-S3, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--passes", type=int, default=3, help="passes to check (default 3)")
+    parser.add_argument("--baseline", help="baseline to compare with")
+    parser.add_argument("--save", help="save this run as the baseline instead")
+    parser.add_argument("--tolerance", type=float, default=0.1, help="slowdown allowed (default 0.1 = 10%%)")
+    parser.add_argument("--timeout", type=int, default=30, help="seconds to wait for each report")
+    args = parser.parse_args()
+    if not args.baseline and not args.save:
+        parser.error("give --baseline or --save")
+
+    passes = read_passes(args.port, args.passes, args.timeout)
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump({"passes": passes}, f, indent=2)
+        print("Saved %d passes to %s" % (len(passes), args.save))
+        return
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    problems = compare(passes, baseline, args.tolerance)
+    for problem in problems:
+        print("FAIL " + problem)
+    print("%d passes checked, %s" % (len(passes), "%d problems" % len(problems) if problems else "all as the baseline"))
+    sys.exit(1 if problems else 0)
+
+
+if __name__ == "__main__":
+    main()
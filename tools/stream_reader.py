@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""
+Host side reader for the raw sample stream (USB_STREAM_ENABLED in src/main.cpp).
+
+Reads the binary frames sent by UsbStreamer, checks the sequence numbers and prints the sample rate
+received and the number of frames lost once a second. Optionally saves the samples to a file, one sweep
+of raw 12-bit values per line (comma separated when several channels are scanned).
+
+Usage:
+    pip install pyserial
+    python3 tools/stream_reader.py /dev/ttyACM0 [--out samples.txt]
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+import serial
+
+SYNC = b"\xa5\x5a"      # 0x5AA5 little-endian
+HEADER = struct.Struct("<HHIIBB")  # sync, count, sequence, timestamp (us), channels, reserved
+MAX_SAMPLES = 4096      # anything larger is treated as a corrupt header
+
+
+def frames(port):
+    """Yield (sequence, timestamp_us, channels, samples) for every complete frame, resyncing after garbage."""
+    buffer = bytearray()
+    while True:
+        buffer += port.read(max(1, port.in_waiting))
+
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                del buffer[:-1]  # keep a possible first half of the sync word
+                break
+            if len(buffer) - start < HEADER.size:
+                del buffer[:start]
+                break
+
+            _, count, sequence, timestamp, channels, _ = HEADER.unpack_from(buffer, start)
+            if count > MAX_SAMPLES or channels == 0 or count % channels:
+                del buffer[:start + 1]  # false sync, look for the next one
+                continue
+
+            end = start + HEADER.size + count * 2
+            if len(buffer) < end:
+                del buffer[:start]
+                break
+
+            samples = struct.unpack_from("<%dH" % count, buffer, start + HEADER.size)
+            del buffer[:end]
+            yield sequence, timestamp, channels, samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Read the KY035 raw sample stream")
+    parser.add_argument("port", help="serial port of the T-Display-S3, e.g. /dev/ttyACM0 or COM5")
+    parser.add_argument("--out", help="file to write the samples to")
+    args = parser.parse_args()
+
+    out = open(args.out, "w") if args.out else None
+    port = serial.Serial(args.port, 115200, timeout=0.1)
+
+    expected = None
+    received = lost = 0
+    samples_this_second = 0
+    last_report = time.monotonic()
+
+    try:
+        for sequence, timestamp, channels, samples in frames(port):
+            if expected is not None and sequence != expected:
+                lost += (sequence - expected) & 0xFFFFFFFF  # gap in the sequence numbers
+            expected = (sequence + 1) & 0xFFFFFFFF
+            received += 1
+            samples_this_second += len(samples)
+
+            if out:
+                # One line per sweep, one column per channel
+                for i in range(0, len(samples), channels):
+                    out.write(",".join(map(str, samples[i:i + channels])))
+                    out.write("\n")
+
+            now = time.monotonic()
+            if now - last_report >= 1.0:
+                rate = samples_this_second / (now - last_report)
+                print("frames %d  lost %d  rate %.1f kS/s  last value %d" % (received, lost, rate / 1000, samples[-channels]))
+                samples_this_second = 0
+                last_report = now
+    except KeyboardInterrupt:
+        pass
+    finally:
+        print("total frames %d, lost %d" % (received, lost))
+        if out:
+            out.close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
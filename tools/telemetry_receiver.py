@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Receiver for the telemetry frames (TELEMETRY_ENABLED in src/main.cpp, format in include/Telemetry.h).
+
+Listens for the UDP datagrams, or subscribes to the MQTT topic, decodes each frame and prints one line per
+frame with the number of readings, the newest field strength and the statistics windows. Gaps in the
+sequence numbers (batches dropped on the device or lost on the way) are counted. Optionally saves every
+reading to a CSV file (time in ms since boot, field in gauss, then the raw value of each channel).
+
+Usage:
+    python3 tools/telemetry_receiver.py udp [--port 5005] [--out readings.csv]
+    pip install paho-mqtt
+    python3 tools/telemetry_receiver.py mqtt --host broker.local [--port 1883] [--topic ky035/telemetry]
+"""
+
+import argparse
+import socket
+import struct
+import sys
+
+MAGIC = 0x4B
+VERSION = 1
+FIXED = struct.Struct("<BBHHB")  # magic, version, count, span (ms), columns
+WINDOWS = ("1s", "10s", "60s")
+
+
+def varint(data, pos):
+    """Return (value, next position) of the LEB128 varint at 'pos'."""
+    value = 0
+    shift = 0
+    while True:
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, pos
+        shift += 7
+
+
+def svarint(data, pos):
+    """Return (value, next position) of the zigzag encoded varint at 'pos'."""
+    value, pos = varint(data, pos)
+    return (value >> 1) ^ -(value & 1), pos
+
+
+def decode(data):
+    """Return a dict with the header fields, the readings [(ms, [values...]), ...] and the statistics windows."""
+    magic, version, count, span, columns = FIXED.unpack_from(data, 0)
+    if magic != MAGIC or version != VERSION:
+        raise ValueError("not a telemetry frame (magic %#x version %d)" % (magic, version))
+
+    pos = FIXED.size
+    device, pos = varint(data, pos)
+    sequence, pos = varint(data, pos)
+    start, pos = varint(data, pos)
+
+    readings = []
+    previous = [0] * columns
+    for i in range(count):
+        for c in range(columns):
+            delta, pos = svarint(data, pos)
+            previous[c] += delta
+        ms = start + (span * i // (count - 1) if count > 1 else 0)
+        readings.append((ms, list(previous)))
+
+    stats = []
+    windows = data[pos]
+    pos += 1
+    for _ in range(windows):
+        samples, pos = varint(data, pos)
+        low, pos = varint(data, pos)
+        high, pos = varint(data, pos)
+        mean, pos = varint(data, pos)
+        sd, pos = varint(data, pos)
+        stats.append((samples, low, high, mean / 16, sd / 16))
+
+    return {"device": device, "sequence": sequence, "readings": readings, "stats": stats}
+
+
+class Printer:
+    """Prints a line per frame and keeps track of the sequence numbers of each device."""
+
+    def __init__(self, out):
+        self.out = out
+        self.expected = {}
+        self.lost = 0
+
+    def frame(self, data):
+        try:
+            frame = decode(data)
+        except (ValueError, IndexError, struct.error) as error:
+            print("bad frame (%d bytes): %s" % (len(data), error), file=sys.stderr)
+            return
+
+        device = frame["device"]
+        sequence = frame["sequence"]
+        if device in self.expected and sequence != self.expected[device]:
+            self.lost += (sequence - self.expected[device]) & 0xFFFFFFFF
+        self.expected[device] = (sequence + 1) & 0xFFFFFFFF
+
+        readings = frame["readings"]
+        line = "%08x #%d: %d readings in %d bytes" % (device, sequence, len(readings), len(data))
+        if readings:
+            line += ", field %.1f G" % (readings[-1][1][0] / 10)
+        for name, (samples, low, high, mean, sd) in zip(WINDOWS, frame["stats"]):
+            if samples:
+                line += " | %s min %d max %d mean %.1f sd %.1f" % (name, low, high, mean, sd)
+        print(line + (" | lost %d" % self.lost if self.lost else ""))
+
+        if self.out:
+            for ms, values in readings:
+                self.out.write("%d,%.1f,%s\n" % (ms, values[0] / 10, ",".join(str(v) for v in values[1:])))
+            self.out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Receive and decode the KY035 telemetry frames")
+    parser.add_argument("transport", choices=("udp", "mqtt"))
+    parser.add_argument("--host", default="localhost", help="MQTT broker")
+    parser.add_argument("--port", type=int, help="UDP port to listen on (default 5005) or MQTT port (default 1883)")
+    parser.add_argument("--topic", default="ky035/telemetry", help="MQTT topic")
+    parser.add_argument("--out", help="CSV file to write the readings to")
+    args = parser.parse_args()
+
+    out = open(args.out, "w") if args.out else None
+    printer = Printer(out)
+
+    try:
+        if args.transport == "udp":
+            sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+            sock.bind(("", args.port or 5005))
+            while True:
+                data, _ = sock.recvfrom(2048)
+                printer.frame(data)
+        else:
+            import paho.mqtt.client as mqtt
+
+            client = mqtt.Client()
+            client.on_connect = lambda c, userdata, flags, rc: c.subscribe(args.topic)
+            client.on_message = lambda c, userdata, message: printer.frame(message.payload)
+            client.connect(args.host, args.port or 1883)
+            client.loop_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out:
+            out.close()
+
+
+if __name__ == "__main__":
+    main()